@@ -0,0 +1,43 @@
+# Builds and runs the chunk dimension benchmarks for every supported chunk size, so their trade-offs can be compared.
+#
+#   cmake -P bench/ChunkMatrix.cmake
+#
+# Pass -DSIZE_SHIFTS="4;5" or -DHEIGHT_SHIFTS="7" (before -P) to limit the matrix. Build trees go in build-chunk-matrix/.
+
+if (NOT DEFINED SIZE_SHIFTS)
+    set(SIZE_SHIFTS 4 5 6)
+endif ()
+if (NOT DEFINED HEIGHT_SHIFTS)
+    set(HEIGHT_SHIFTS 5 7 8)
+endif ()
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+set(MATRIX_DIR "${SOURCE_DIR}/build-chunk-matrix")
+
+foreach (SIZE_SHIFT IN LISTS SIZE_SHIFTS)
+    foreach (HEIGHT_SHIFT IN LISTS HEIGHT_SHIFTS)
+        set(BUILD_DIR "${MATRIX_DIR}/${SIZE_SHIFT}-${HEIGHT_SHIFT}")
+        message(STATUS "Chunk size shift ${SIZE_SHIFT}, height shift ${HEIGHT_SHIFT}")
+
+        execute_process(
+            COMMAND ${CMAKE_COMMAND} -S "${SOURCE_DIR}" -B "${BUILD_DIR}"
+                -DCMAKE_BUILD_TYPE=Release
+                -DVOXELS_BUILD_BENCHMARKS=ON
+                -DVOXELS_CHUNK_SIZE_SHIFT=${SIZE_SHIFT}
+                -DVOXELS_CHUNK_HEIGHT_SHIFT=${HEIGHT_SHIFT}
+            COMMAND_ERROR_IS_FATAL ANY
+        )
+        execute_process(
+            COMMAND ${CMAKE_COMMAND} --build "${BUILD_DIR}" --config Release --target benchmarks --parallel
+            COMMAND_ERROR_IS_FATAL ANY
+        )
+
+        find_program(BENCHMARKS benchmarks PATHS "${BUILD_DIR}" "${BUILD_DIR}/bench/Voxels"
+                     PATH_SUFFIXES Release NO_DEFAULT_PATH NO_CACHE REQUIRED)
+        execute_process(
+            COMMAND "${BENCHMARKS}" --benchmark_filter=BM_Chunk
+                --benchmark_out=${MATRIX_DIR}/${SIZE_SHIFT}-${HEIGHT_SHIFT}.json --benchmark_out_format=json
+            COMMAND_ERROR_IS_FATAL ANY
+        )
+    endforeach ()
+endforeach ()
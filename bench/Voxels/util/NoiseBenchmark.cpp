@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Voxels/util/PerlinNoise.hpp"
+#include "Voxels/util/SimplexNoise.hpp"
+
+namespace {
+
+using siv::perlin_detail::SimdLevel;
+
+const siv::PerlinNoise perlin{123456u};
+const SimplexNoise simplex{123456u};
+
+// A 64 x 64 slice of 3D noise at the frequency generateVoxels3D samples it
+struct Points {
+    std::vector<double> x, y, z, out;
+
+    Points() {
+        for (int i = 0; i < 64 * 64; ++i) {
+            x.push_back((i % 64 + 1) * 0.01);
+            y.push_back(0.37);
+            z.push_back((i / 64 + 1) * 0.01);
+        }
+        out.resize(x.size());
+    }
+};
+
+// One octave3D_01 call per point, as generation did before batching
+void BM_NoiseScalar(benchmark::State& state) {
+    Points points;
+    for (auto _ : state) {
+        for (size_t i = 0; i < points.out.size(); ++i) {
+            points.out[i] = perlin.octave3D_01(points.x[i], points.y[i], points.z[i], 4);
+        }
+        benchmark::DoNotOptimize(points.out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * points.out.size()));
+}
+
+// The batched path with its vector width capped at the given level
+void BM_NoiseBatch(benchmark::State& state) {
+    const auto level = static_cast<SimdLevel>(state.range(0));
+    if (level > siv::perlin_detail::SupportedSimdLevel()) {
+        state.SkipWithError("Not supported by this CPU");
+        return;
+    }
+
+    Points points;
+    const std::uint8_t* permutation = perlin.serialize().data();
+    for (auto _ : state) {
+        const size_t done = siv::perlin_detail::OctaveBatch01<true>(level, permutation, points.x.data(), points.y.data(),
+                                                                     points.z.data(), points.out.data(),
+                                                                     points.out.size(), 4, 0.5);
+        for (size_t i = done; i < points.out.size(); ++i) {
+            points.out[i] = perlin.octave3D_01(points.x[i], points.y[i], points.z[i], 4);
+        }
+        benchmark::DoNotOptimize(points.out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * points.out.size()));
+}
+
+// Batched octave noise from each backend, 0 for Perlin and 1 for simplex, with as many octaves as the heightmap (1) and
+// density (4) terrain sample. Simplex noise takes float coordinates, converted once up front.
+void BM_NoiseBackend(benchmark::State& state) {
+    const bool is3D = state.range(0) == 3;
+    const bool isSimplex = state.range(1) == 1;
+    const int octaves = is3D ? 4 : 1;
+
+    Points points;
+    const std::vector<float> x(points.x.begin(), points.x.end());
+    const std::vector<float> y(points.y.begin(), points.y.end());
+    const std::vector<float> z(points.z.begin(), points.z.end());
+    std::vector<float> out(points.out.size());
+    for (auto _ : state) {
+        if (isSimplex && is3D) {
+            simplex.octave3D_01(x, y, z, out, octaves);
+        } else if (isSimplex) {
+            simplex.octave2D_01(x, z, out, octaves);
+        } else if (is3D) {
+            perlin.octave3D_01(points.x, points.y, points.z, points.out, octaves);
+        } else {
+            perlin.octave2D_01(points.x, points.z, points.out, octaves);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::DoNotOptimize(points.out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * points.out.size()));
+}
+
+}
+
+BENCHMARK(BM_NoiseScalar);
+BENCHMARK(BM_NoiseBatch)->Arg(static_cast<int>(SimdLevel::SSE2))->Arg(static_cast<int>(SimdLevel::AVX2));
+BENCHMARK(BM_NoiseBackend)->ArgNames({"dims", "simplex"})->ArgsProduct({{2, 3}, {0, 1}});
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ChunkFixtures.hpp"
+#include "Voxels/world/Chunk.hpp"
+#include "Voxels/world/Mesher.hpp"
+
+// Trade-offs of the chunk dimensions chosen with VOXELS_CHUNK_SIZE_SHIFT and VOXELS_CHUNK_HEIGHT_SHIFT. Every build only
+// covers its own dimensions; bench/ChunkMatrix.cmake builds and runs each configuration in turn. Rates are per voxel
+// column of the terrain, i.e. per stack of TerrainChunkRows chunks, so that configurations can be compared directly.
+
+namespace {
+
+constexpr double ColumnsPerChunk = ChunkSize * ChunkSize;
+
+void BM_ChunkGenerate(benchmark::State& state) {
+    const auto type = static_cast<GenerationType>(state.range(0));
+    int cx = 0;
+    for (auto _ : state) {
+        for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+            benchmark::DoNotOptimize(Chunk::generate(type, cx, cy, 0));
+        }
+        ++cx;
+    }
+    state.counters["columns"] = benchmark::Counter(ColumnsPerChunk, benchmark::Counter::kIsIterationInvariantRate);
+    state.SetLabel(chunkLabel());
+}
+
+// Meshing a stack of chunks; the time per chunk, which bounds the latency of a remesh, is the time over "chunks"
+void BM_ChunkMesh(benchmark::State& state) {
+    std::vector<ChunkNeighbourhood> stack;
+    std::vector<std::pair<int, int>> ranges;
+    for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+        int minY;
+        int maxY;
+        stack.push_back(neighbourhood(static_cast<GenerationType>(state.range(0)), 0, cy, 0, minY, maxY));
+        ranges.emplace_back(minY, maxY);
+    }
+    const auto chunk = std::make_shared<Chunk>(0, 0, 0);
+
+    size_t vertices = 0;
+    for (auto _ : state) {
+        vertices = 0;
+        for (size_t i = 0; i < stack.size(); ++i) {
+            vertices += Mesher::meshChunk(chunk, stack[i], ranges[i].first, ranges[i].second).vertices.size();
+        }
+    }
+    state.counters["columns"] = benchmark::Counter(ColumnsPerChunk, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["chunks"] = TerrainChunkRows;
+    state.counters["vertices/column"] = static_cast<double>(vertices) / ColumnsPerChunk;
+    state.SetLabel(chunkLabel());
+}
+
+// What a view distance of state.range(1) metres costs: how many indirect draws are issued (one per non-empty chunk
+// section), and the voxel memory and vertex count of the chunks, extrapolated from a 3x3 sample of chunk stacks. The
+// timed loop is the range test WorldManager runs over the view area.
+void BM_ChunkViewDistance(benchmark::State& state) {
+    const auto type = static_cast<GenerationType>(state.range(0));
+    const auto metres = static_cast<double>(state.range(1));
+
+    double bytes = 0;
+    double vertices = 0;
+    double sections = 0;
+    for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+        for (int cz = -1; cz <= 1; ++cz) {
+            for (int cx = -1; cx <= 1; ++cx) {
+                int minY;
+                int maxY;
+                const ChunkNeighbourhood voxels = neighbourhood(type, cx, cy, cz, minY, maxY);
+                bytes += static_cast<double>(voxels.centre().memoryUsage());
+                const Mesher::MeshResult mesh = Mesher::meshChunk(std::make_shared<Chunk>(cx, cy, cz), voxels, minY, maxY);
+                vertices += static_cast<double>(mesh.vertices.size());
+                sections += static_cast<double>(std::ranges::count_if(
+                    mesh.sections, [](const ChunkSection& section) { return section.numVertices > 0; }));
+            }
+        }
+    }
+    bytes /= 9 * ColumnsPerChunk;
+    vertices /= 9 * ColumnsPerChunk;
+    sections /= 9;
+
+    // Same test as WorldManager::chunkInRenderDistance, from the middle of chunk (0, 0)
+    const int radius = static_cast<int>(metres) / ChunkSize + 1;
+    int stacks = 0;
+    for (auto _ : state) {
+        stacks = 0;
+        for (int cz = -radius; cz <= radius; ++cz) {
+            for (int cx = -radius; cx <= radius; ++cx) {
+                const double dx = cx * ChunkSize;
+                const double dz = cz * ChunkSize;
+                stacks += dx * dx + dz * dz < metres * metres;
+            }
+        }
+        benchmark::DoNotOptimize(stacks);
+    }
+
+    const double columns = stacks * ColumnsPerChunk;
+    state.counters["draws"] = stacks * sections;
+    state.counters["voxelMB"] = bytes * columns / (1024.0 * 1024.0);
+    state.counters["Mvertices"] = vertices * columns / 1e6;
+    state.SetLabel(chunkLabel() + " " + voxelLabel());
+}
+
+constexpr auto Perlin2D = static_cast<int64_t>(GenerationType::Perlin2D);
+constexpr auto Perlin3D = static_cast<int64_t>(GenerationType::Perlin3D);
+
+}
+
+BENCHMARK(BM_ChunkGenerate)->Arg(Perlin2D)->Arg(Perlin3D);
+BENCHMARK(BM_ChunkMesh)->Arg(Perlin2D)->Arg(Perlin3D);
+BENCHMARK(BM_ChunkViewDistance)->ArgsProduct({{Perlin2D, Perlin3D}, {128, 256, 512}})->Iterations(1);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "Voxels/world/Chunk.hpp"
+#include "Voxels/world/ChunkNeighbourhood.hpp"
+
+inline std::string voxelLabel() {
+    return "Voxel=" + std::to_string(8 * sizeof(Voxel)) + "-bit";
+}
+
+inline std::string chunkLabel() {
+    return "Chunk=" + std::to_string(ChunkSize) + "x" + std::to_string(ChunkHeight);
+}
+
+// Chunk (cx, cy, cz) surrounded by its 26 generated neighbours, as queued by WorldManager::queueMeshChunk
+inline ChunkNeighbourhood neighbourhood(const GenerationType type, const int cx, const int cy, const int cz, int& minY,
+                                        int& maxY) {
+    Chunk::GenerationResult centre = Chunk::generate(type, cx, cy, cz);
+    minY = centre.minY;
+    maxY = centre.maxY;
+
+    ChunkNeighbourhood voxels(std::make_shared<const VoxelStorage>(std::move(centre.voxelField)), cy == 0);
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if ((dx == 0 && dy == 0 && dz == 0) || cy + dy < 0 || cy + dy >= TerrainChunkRows) {
+                    continue;
+                }
+
+                Chunk::GenerationResult result = Chunk::generate(type, cx + dx, cy + dy, cz + dz);
+                voxels.setNeighbour(dx, dy, dz, std::make_shared<const VoxelStorage>(std::move(result.voxelField)));
+                if (dy == 0 && (dx == 0 || dz == 0)) {
+                    minY = std::min(minY, result.minY);
+                }
+            }
+        }
+    }
+    return voxels;
+}
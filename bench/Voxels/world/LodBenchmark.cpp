@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <utility>
+
+#include "ChunkFixtures.hpp"
+#include "Voxels/world/Chunk.hpp"
+#include "Voxels/world/Mesher.hpp"
+
+// What a stack of TerrainChunkRows chunks costs to generate and mesh at each level of detail, for the 2D and 3D
+// generators. Chunks are meshed without neighbours, as WorldManager meshes coarser chunks; "vertices" is the mesh size
+// of the stack, which is what the draws of distant chunks cost.
+
+namespace {
+
+constexpr int Columns = 8;
+
+GenerationType generationType(const benchmark::State& state) {
+    return state.range(0) == 3 ? GenerationType::Perlin3D : GenerationType::Perlin2D;
+}
+
+void BM_LodChunk(benchmark::State& state) {
+    const GenerationType type = generationType(state);
+    const auto lod = static_cast<int>(state.range(1));
+
+    int cx = 0;
+    size_t vertices = 0;
+    for (auto _ : state) {
+        vertices = 0;
+        for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+            Chunk::GenerationResult result = Chunk::generateLod(type, cx, cy, 0, lod);
+            const ChunkNeighbourhood voxels(std::make_shared<const VoxelStorage>(std::move(result.voxelField)), cy == 0);
+            const auto chunk = std::make_shared<Chunk>(cx, cy, 0);
+            vertices += Mesher::meshChunk(chunk, voxels, result.minY, result.maxY).vertices.size();
+        }
+        cx = (cx + 1) % Columns;
+    }
+    state.counters["vertices"] = static_cast<double>(vertices);
+    state.SetLabel(chunkLabel());
+}
+
+}
+
+BENCHMARK(BM_LodChunk)->ArgNames({"dims", "lod"})->ArgsProduct({{2, 3}, {0, 1, 2, 3}});
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+
+#include "ChunkFixtures.hpp"
+#include "Voxels/world/Chunk.hpp"
+
+// What sampling generateVoxels3D's noise on a coarser lattice saves, and what it costs in fidelity. Step 1 x 1 is the
+// exact path. "mismatch" is the fraction of voxels below TerrainHeight whose solidity differs from the exact path,
+// over a 3 x 3 block of chunks.
+
+namespace {
+
+constexpr int SampleRadius = 1;
+
+NoiseLattice lattice(const benchmark::State& state) {
+    return {static_cast<int>(state.range(0)), static_cast<int>(state.range(1))};
+}
+
+void BM_GenerateLattice(benchmark::State& state) {
+    const NoiseLattice steps = lattice(state);
+    if (!steps.isValid()) {
+        state.SkipWithError("Steps must be powers of two within the chunk and section sizes");
+        return;
+    }
+
+    int cx = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Chunk::generateVoxels3D(cx++, 0, 0, steps));
+    }
+
+    size_t mismatched = 0;
+    size_t total = 0;
+    const int height = std::min(ChunkHeight, TerrainHeight);
+    for (int sz = -SampleRadius; sz <= SampleRadius; ++sz) {
+        for (int sx = -SampleRadius; sx <= SampleRadius; ++sx) {
+            const Chunk::GenerationResult exact = Chunk::generateVoxels3D(sx, 0, sz, NoiseLattice::exact());
+            const Chunk::GenerationResult coarse = Chunk::generateVoxels3D(sx, 0, sz, steps);
+            for (int y = 0; y < height; ++y) {
+                for (int z = 0; z < ChunkSize; ++z) {
+                    for (int x = 0; x < ChunkSize; ++x) {
+                        mismatched += exact.voxelField.isSolid(x, y, z) != coarse.voxelField.isSolid(x, y, z);
+                        ++total;
+                    }
+                }
+            }
+        }
+    }
+    state.counters["mismatch"] = static_cast<double>(mismatched) / static_cast<double>(total);
+    state.SetLabel(chunkLabel());
+}
+
+}
+
+BENCHMARK(BM_GenerateLattice)
+    ->ArgNames({"h", "v"})
+    ->Args({1, 1})
+    ->Args({2, 2})
+    ->Args({4, 4})
+    ->Args({4, 8})
+    ->Args({8, 8})
+    ->Args({8, 16});
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "ChunkFixtures.hpp"
+#include "Voxels/world/RegionCache.hpp"
+
+// Reading terrain chunks back from the region cache against generating them, for the 2D and 3D generators. The cache
+// is written once up front, so the reads come from the page cache rather than the disk.
+
+namespace {
+
+constexpr int Columns = 8;
+
+GenerationType generationType(const benchmark::State& state) {
+    return state.range(0) == 3 ? GenerationType::Perlin3D : GenerationType::Perlin2D;
+}
+
+void BM_RegionGenerate(benchmark::State& state) {
+    const GeneratorPipeline generator = GeneratorPipeline::fromType(generationType(state));
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(generator.generate(i % Columns, 0, i / Columns % Columns));
+        ++i;
+    }
+    state.SetLabel(chunkLabel());
+}
+
+void BM_RegionLoad(benchmark::State& state) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "RegionCacheBenchmark";
+    std::filesystem::remove_all(directory);
+
+    const GeneratorPipeline generator = GeneratorPipeline::fromType(generationType(state));
+    const uint64_t fingerprint = RegionCache::fingerprint(generator);
+    {
+        RegionCache cache(directory);
+        for (int z = 0; z < Columns; ++z) {
+            for (int x = 0; x < Columns; ++x) {
+                cache.store({x, 0, z}, generator.generate(x, 0, z), fingerprint);
+            }
+        }
+    }
+
+    RegionCache cache(directory);
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.load({i % Columns, 0, i / Columns % Columns}, fingerprint));
+        ++i;
+    }
+    state.counters["bytes"] = static_cast<double>(cache.getStats().bytes) / static_cast<double>(i);
+    state.SetLabel(chunkLabel());
+    std::filesystem::remove_all(directory);
+}
+
+}
+
+BENCHMARK(BM_RegionGenerate)->ArgName("dims")->Arg(2)->Arg(3);
+BENCHMARK(BM_RegionLoad)->ArgName("dims")->Arg(2)->Arg(3);
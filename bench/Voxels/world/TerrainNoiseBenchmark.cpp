@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include "ChunkFixtures.hpp"
+#include "Voxels/world/Chunk.hpp"
+#include "Voxels/world/HeightmapCache.hpp"
+
+// What generating terrain costs with each noise backend, 0 for Perlin and 1 for simplex. 2D generates every chunk of
+// the columns of a heightmap tile not generated before, so every height is sampled, and with biomes, a new climate
+// region every few tiles; 3D generates one chunk on the default lattice.
+
+namespace {
+
+constexpr int TileChunks = HeightmapCache::TileSize / ChunkSize;
+
+NoiseBackend noiseBackend(const benchmark::State& state) {
+    return state.range(1) == 1 ? NoiseBackend::Simplex : NoiseBackend::Perlin;
+}
+
+void BM_NoiseBackendChunk(benchmark::State& state) {
+    const NoiseBackend backend = noiseBackend(state);
+    const bool biomes = state.range(2) == 1;
+
+    if (state.range(0) == 3) {
+        int cx = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Chunk::generateVoxels3D(cx++, 0, 0, {}, backend));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.SetLabel(chunkLabel());
+        return;
+    }
+
+    // Tiles far from any generated before, in a row running away from the origin
+    int tile = 1 << 12;
+    for (auto _ : state) {
+        for (int cz = 0; cz < TileChunks; ++cz) {
+            for (int cx = 0; cx < TileChunks; ++cx) {
+                for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+                    benchmark::DoNotOptimize(Chunk::generateVoxels2D(tile * TileChunks + cx, cy, cz, backend, biomes));
+                }
+            }
+        }
+        ++tile;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * TileChunks * TileChunks * TerrainChunkRows));
+    state.SetLabel(chunkLabel());
+}
+
+}
+
+// Only heightmap terrain has biomes
+BENCHMARK(BM_NoiseBackendChunk)
+    ->ArgNames({"dims", "simplex", "biomes"})
+    ->ArgsProduct({{2}, {0, 1}, {0, 1}})
+    ->ArgsProduct({{3}, {0, 1}, {0}});
@@ -0,0 +1,177 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ChunkFixtures.hpp"
+#include "Voxels/world/Chunk.hpp"
+#include "Voxels/world/Mesher.hpp"
+
+namespace {
+
+Chunk::GenerationResult generate(const GenerationType type) {
+    return Chunk::generate(type, 0, 0, 0);
+}
+
+// Chunk generation with the configured Voxel type
+void BM_Generate(benchmark::State& state) {
+    const auto type = static_cast<GenerationType>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(generate(type));
+    }
+    state.SetLabel(voxelLabel());
+}
+
+// What a full copy of the voxels costs, i.e. what WorldManager::queueMeshChunk used to pay on every remesh
+void BM_CopyVoxels(benchmark::State& state) {
+    const auto result = generate(static_cast<GenerationType>(state.range(0)));
+    for (auto _ : state) {
+        VoxelStorage voxels = result.voxelField;
+        benchmark::DoNotOptimize(voxels);
+    }
+    state.SetLabel(voxelLabel() + " bytes=" + std::to_string(result.voxelField.memoryUsage()));
+}
+
+void BM_MeshChunk(benchmark::State& state) {
+    int minY;
+    int maxY;
+    const ChunkNeighbourhood voxels = neighbourhood(static_cast<GenerationType>(state.range(0)), 0, 0, 0, minY, maxY);
+    const auto chunk = std::make_shared<Chunk>(0, 0, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Mesher::meshChunk(chunk, voxels, minY, maxY));
+    }
+    state.SetLabel(voxelLabel());
+}
+
+// Steady-state streaming: chunks are generated, copied for meshing and destroyed again. Once the pools have warmed up
+// every voxel buffer should come from them.
+void BM_StreamChunks(benchmark::State& state) {
+    const auto type = static_cast<GenerationType>(state.range(0));
+    const BufferPoolStats before = VoxelStorage::poolStats();
+    int cx = 0;
+    for (auto _ : state) {
+        const auto chunk = std::make_shared<Chunk>(cx, 0, 0);
+        Chunk::GenerationResult result = Chunk::generate(type, cx++, 0, 0);
+        chunk->voxels = std::move(result.voxelField);
+        benchmark::DoNotOptimize(chunk->voxels.snapshot());
+    }
+    const BufferPoolStats after = VoxelStorage::poolStats();
+    const auto acquired = static_cast<double>(after.acquired - before.acquired);
+    state.counters["reused"] = acquired == 0 ? 0.0 : static_cast<double>(after.reused - before.reused) / acquired;
+    state.SetLabel(voxelLabel());
+}
+
+// A burst of edits to a chunk whose previous snapshot is still being meshed, followed by the snapshot for the next
+// remesh. Only the first edit of each burst should copy.
+void BM_EditBurst(benchmark::State& state) {
+    const auto edits = static_cast<int>(state.range(1));
+    Chunk chunk(0, 0, 0);
+    chunk.voxels = generate(static_cast<GenerationType>(state.range(0))).voxelField;
+
+    SharedVoxels::Snapshot inFlight = chunk.voxels.snapshot();
+    const uint64_t before = SharedVoxels::copyCount();
+    for (auto _ : state) {
+        for (int i = 0; i < edits; ++i) {
+            chunk.store(i % ChunkSize, ChunkHeight / 4 + i / ChunkSize % (ChunkHeight / 4), 3, 1);
+        }
+        inFlight = chunk.voxels.snapshot();
+        benchmark::DoNotOptimize(inFlight);
+    }
+    state.counters["copies"] = benchmark::Counter(static_cast<double>(SharedVoxels::copyCount() - before),
+                                                  benchmark::Counter::kAvgIterations);
+    state.SetLabel(voxelLabel());
+}
+
+// Filling every column of a sectioned chunk with stone up to a varying height, one voxel at a time (0) or as a single
+// span per column (1), e.g. a primitive or a generator writing solid terrain
+void BM_FillColumns(benchmark::State& state) {
+    const bool spans = state.range(0) != 0;
+    for (auto _ : state) {
+        VoxelStorage voxels;
+        int minY = ChunkHeight;
+        int maxY = 0;
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                const int height = ChunkHeight / 4 + (x * 5 + z * 3) % (ChunkHeight / 2);
+                if (spans) {
+                    Chunk::fillInto(voxels, minY, maxY, x, z, 0, height, 2);
+                } else {
+                    for (int y = 0; y < height; ++y) {
+                        Chunk::storeInto(voxels, minY, maxY, x, y, z, 2);
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(voxels);
+    }
+    state.SetLabel(voxelLabel());
+}
+
+// Reference: a flat ChunkSize^2 * ChunkHeight array per element type, i.e. the layout every voxel used to have.
+// Copying it and sampling the 27-neighbourhood of every voxel shows what the element width alone costs.
+template<typename T>
+std::vector<T> denseChunk() {
+    const auto result = Chunk::generateVoxels3D(0, 0, 0);
+    std::vector<T> voxels(VoxelsSize);
+    for (int y = 0; y < ChunkHeight; ++y) {
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                voxels[Chunk::getVoxelIndex(x, y, z)] = static_cast<T>(result.voxelField.load(x, y, z));
+            }
+        }
+    }
+    return voxels;
+}
+
+template<typename T>
+void BM_DenseCopy(benchmark::State& state) {
+    const std::vector<T> voxels = denseChunk<T>();
+    for (auto _ : state) {
+        std::vector<T> copy = voxels;
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * VoxelsSize * sizeof(T));
+}
+
+template<typename T>
+void BM_DenseNeighbourhood(benchmark::State& state) {
+    const std::vector<T> voxels = denseChunk<T>();
+    for (auto _ : state) {
+        int solid = 0;
+        for (int y = 1; y < ChunkHeight - 1; ++y) {
+            for (int z = 1; z < ChunkSize - 1; ++z) {
+                for (int x = 1; x < ChunkSize - 1; ++x) {
+                    for (int i = -1; i <= 1; ++i) {
+                        for (int j = -1; j <= 1; ++j) {
+                            for (int k = -1; k <= 1; ++k) {
+                                solid += voxels[Chunk::getVoxelIndex(x + i, y + j, z + k)] != 0;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(solid);
+    }
+}
+
+constexpr auto Perlin2D = static_cast<int64_t>(GenerationType::Perlin2D);
+constexpr auto Perlin3D = static_cast<int64_t>(GenerationType::Perlin3D);
+
+}
+
+BENCHMARK(BM_Generate)->Arg(Perlin2D)->Arg(Perlin3D);
+BENCHMARK(BM_CopyVoxels)->Arg(Perlin2D)->Arg(Perlin3D);
+BENCHMARK(BM_MeshChunk)->Arg(Perlin2D)->Arg(Perlin3D);
+BENCHMARK(BM_StreamChunks)->Arg(Perlin2D)->Arg(Perlin3D);
+BENCHMARK(BM_FillColumns)->Arg(0)->Arg(1);
+BENCHMARK(BM_EditBurst)->Args({Perlin2D, 1})->Args({Perlin2D, 64})->Args({Perlin3D, 1})->Args({Perlin3D, 64});
+
+BENCHMARK(BM_DenseCopy<int>);
+BENCHMARK(BM_DenseCopy<uint16_t>);
+BENCHMARK(BM_DenseCopy<uint8_t>);
+BENCHMARK(BM_DenseNeighbourhood<int>);
+BENCHMARK(BM_DenseNeighbourhood<uint16_t>);
+BENCHMARK(BM_DenseNeighbourhood<uint8_t>);
@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "ChunkFixtures.hpp"
+#include "Voxels/world/Chunk.hpp"
+#include "Voxels/world/PaletteStorage.hpp"
+#include "Voxels/world/VoxelLayout.hpp"
+
+// The access patterns of generation and meshing over a whole chunk stored in each VoxelLayout, to pick
+// VOXELS_VOXEL_LAYOUT for a workload. The chunk is the 3D terrain, which has the most surface.
+
+namespace {
+
+template<template<size_t, size_t> class Layout>
+using ChunkLayout = Layout<ChunkSize, ChunkHeight>;
+
+template<template<size_t, size_t> class Layout>
+std::vector<Voxel> layoutChunk() {
+    using L = ChunkLayout<Layout>;
+    const auto result = Chunk::generateVoxels3D(0, 0, 0);
+    std::vector<Voxel> voxels(L::Volume);
+    L::forEach([&](const size_t x, const size_t y, const size_t z) {
+        voxels[L::index(x, y, z)] = result.voxelField.load(x, y, z);
+    });
+    return voxels;
+}
+
+// Stores in the y, z, x order the generators loop in
+template<template<size_t, size_t> class Layout>
+void BM_LayoutFill(benchmark::State& state) {
+    using L = ChunkLayout<Layout>;
+    const std::vector<Voxel> source = layoutChunk<Layout>();
+    std::vector<Voxel> voxels(L::Volume);
+    for (auto _ : state) {
+        for (size_t y = 0; y < ChunkHeight; ++y) {
+            for (size_t z = 0; z < ChunkSize; ++z) {
+                for (size_t x = 0; x < ChunkSize; ++x) {
+                    voxels[L::index(x, y, z)] = static_cast<Voxel>(source[L::index(x, y, z)] + 1);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(voxels.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VoxelsSize);
+    state.SetLabel(chunkLabel());
+}
+
+// The 27-voxel gather of ambient occlusion around every voxel
+template<template<size_t, size_t> class Layout>
+void BM_LayoutNeighbourhood(benchmark::State& state) {
+    using L = ChunkLayout<Layout>;
+    const std::vector<Voxel> voxels = layoutChunk<Layout>();
+    for (auto _ : state) {
+        int solid = 0;
+        for (size_t y = 1; y < ChunkHeight - 1; ++y) {
+            for (size_t z = 1; z < ChunkSize - 1; ++z) {
+                for (size_t x = 1; x < ChunkSize - 1; ++x) {
+                    for (size_t j = y - 1; j <= y + 1; ++j) {
+                        for (size_t k = z - 1; k <= z + 1; ++k) {
+                            for (size_t i = x - 1; i <= x + 1; ++i) {
+                                solid += voxels[L::index(i, j, k)] != EmptyVoxel;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(solid);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VoxelsSize);
+    state.SetLabel(chunkLabel());
+}
+
+// Runs of equal voxels up each column, as RunMesher extends faces vertically
+template<template<size_t, size_t> class Layout>
+void BM_LayoutColumnRuns(benchmark::State& state) {
+    using L = ChunkLayout<Layout>;
+    const std::vector<Voxel> voxels = layoutChunk<Layout>();
+    for (auto _ : state) {
+        int runs = 0;
+        for (size_t z = 0; z < ChunkSize; ++z) {
+            for (size_t x = 0; x < ChunkSize; ++x) {
+                for (size_t y = 1; y < ChunkHeight; ++y) {
+                    runs += voxels[L::index(x, y, z)] != voxels[L::index(x, y - 1, z)];
+                }
+            }
+        }
+        benchmark::DoNotOptimize(runs);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VoxelsSize);
+    state.SetLabel(chunkLabel());
+}
+
+// Runs of equal voxels along x, as faces are extended across a layer
+template<template<size_t, size_t> class Layout>
+void BM_LayoutRowRuns(benchmark::State& state) {
+    using L = ChunkLayout<Layout>;
+    const std::vector<Voxel> voxels = layoutChunk<Layout>();
+    for (auto _ : state) {
+        int runs = 0;
+        for (size_t y = 0; y < ChunkHeight; ++y) {
+            for (size_t z = 0; z < ChunkSize; ++z) {
+                for (size_t x = 1; x < ChunkSize; ++x) {
+                    runs += voxels[L::index(x, y, z)] != voxels[L::index(x - 1, y, z)];
+                }
+            }
+        }
+        benchmark::DoNotOptimize(runs);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VoxelsSize);
+    state.SetLabel(chunkLabel());
+}
+
+// The neighbourhood gather through bit-packed palette indices, which is how sections actually hold dense voxels
+template<template<size_t, size_t> class Layout>
+void BM_LayoutPackedNeighbourhood(benchmark::State& state) {
+    using L = ChunkLayout<Layout>;
+    const std::vector<Voxel> source = layoutChunk<Layout>();
+    PaletteStorage voxels(L::Volume);
+    for (size_t i = 0; i < L::Volume; ++i) {
+        voxels.store(i, source[i]);
+    }
+
+    for (auto _ : state) {
+        int solid = 0;
+        for (size_t y = 1; y < ChunkHeight - 1; ++y) {
+            for (size_t z = 1; z < ChunkSize - 1; ++z) {
+                for (size_t x = 1; x < ChunkSize - 1; ++x) {
+                    for (size_t j = y - 1; j <= y + 1; ++j) {
+                        for (size_t k = z - 1; k <= z + 1; ++k) {
+                            for (size_t i = x - 1; i <= x + 1; ++i) {
+                                solid += voxels.load(L::index(i, j, k)) != EmptyVoxel;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(solid);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VoxelsSize);
+    state.SetLabel(chunkLabel());
+}
+
+}
+
+BENCHMARK(BM_LayoutFill<LinearLayout>);
+BENCHMARK(BM_LayoutFill<ColumnLayout>);
+BENCHMARK(BM_LayoutFill<MortonLayout>);
+BENCHMARK(BM_LayoutNeighbourhood<LinearLayout>);
+BENCHMARK(BM_LayoutNeighbourhood<ColumnLayout>);
+BENCHMARK(BM_LayoutNeighbourhood<MortonLayout>);
+BENCHMARK(BM_LayoutColumnRuns<LinearLayout>);
+BENCHMARK(BM_LayoutColumnRuns<ColumnLayout>);
+BENCHMARK(BM_LayoutColumnRuns<MortonLayout>);
+BENCHMARK(BM_LayoutRowRuns<LinearLayout>);
+BENCHMARK(BM_LayoutRowRuns<ColumnLayout>);
+BENCHMARK(BM_LayoutRowRuns<MortonLayout>);
+BENCHMARK(BM_LayoutPackedNeighbourhood<LinearLayout>);
+BENCHMARK(BM_LayoutPackedNeighbourhood<ColumnLayout>);
+BENCHMARK(BM_LayoutPackedNeighbourhood<MortonLayout>);
@@ -1,18 +1,27 @@
 #version 460 core
 
-layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
 
 uniform int CHUNK_SIZE;
+uniform int CHUNK_HEIGHT;
+uniform int SECTION_COUNT;
 
 struct Chunk {
     int cx;
+    int cy;
     int cz;
     int minY;
     int maxY;
     uint numVertices;
     uint firstIndex;
-    uint _pad0;
-    uint _pad1;
+    int lod;
+};
+
+struct ChunkSection {
+    uint firstVertex;
+    uint numVertices;
+    uint boundsMin;
+    uint boundsMax;
 };
 
 struct ChunkDrawCommand {
@@ -35,25 +44,30 @@ layout (binding = 2) buffer CommandCount {
     uint commandCount;
 };
 
+// SECTION_COUNT sections per chunk
+layout (binding = 4) readonly buffer ChunkSections {
+    ChunkSection sections[];
+};
+
 uniform vec4 frustum[6];
 
-bool isVisible(int cx, int cz, int minY, int maxY) {
-    float minX = cx * CHUNK_SIZE;
-    float maxX = minX + CHUNK_SIZE;
-    float minZ = cz * CHUNK_SIZE;
-    float maxZ = minZ + CHUNK_SIZE;
+// Local voxel coordinates packed by ChunkSection::packBounds
+ivec3 unpackBounds(uint bounds) {
+    return ivec3(bounds & 0xffu, bounds >> 16, (bounds >> 8) & 0xffu);
+}
 
+bool isVisible(vec3 boxMin, vec3 boxMax) {
     // Check AABB outside/inside of frustum
     for (int i = 0; i < 6; ++i) {
         int res = 0;
-        res += ((dot(frustum[i], vec4(minX, minY, minZ, 1.0)) < 0.0) ? 1 : 0);
-        res += ((dot(frustum[i], vec4(maxX, minY, minZ, 1.0)) < 0.0) ? 1 : 0);
-        res += ((dot(frustum[i], vec4(minX, maxY, minZ, 1.0)) < 0.0) ? 1 : 0);
-        res += ((dot(frustum[i], vec4(maxX, maxY, minZ, 1.0)) < 0.0) ? 1 : 0);
-        res += ((dot(frustum[i], vec4(minX, minY, maxZ, 1.0)) < 0.0) ? 1 : 0);
-        res += ((dot(frustum[i], vec4(maxX, minY, maxZ, 1.0)) < 0.0) ? 1 : 0);
-        res += ((dot(frustum[i], vec4(minX, maxY, maxZ, 1.0)) < 0.0) ? 1 : 0);
-        res += ((dot(frustum[i], vec4(maxX, maxY, maxZ, 1.0)) < 0.0) ? 1 : 0);
+        res += ((dot(frustum[i], vec4(boxMin.x, boxMin.y, boxMin.z, 1.0)) < 0.0) ? 1 : 0);
+        res += ((dot(frustum[i], vec4(boxMax.x, boxMin.y, boxMin.z, 1.0)) < 0.0) ? 1 : 0);
+        res += ((dot(frustum[i], vec4(boxMin.x, boxMax.y, boxMin.z, 1.0)) < 0.0) ? 1 : 0);
+        res += ((dot(frustum[i], vec4(boxMax.x, boxMax.y, boxMin.z, 1.0)) < 0.0) ? 1 : 0);
+        res += ((dot(frustum[i], vec4(boxMin.x, boxMin.y, boxMax.z, 1.0)) < 0.0) ? 1 : 0);
+        res += ((dot(frustum[i], vec4(boxMax.x, boxMin.y, boxMax.z, 1.0)) < 0.0) ? 1 : 0);
+        res += ((dot(frustum[i], vec4(boxMin.x, boxMax.y, boxMax.z, 1.0)) < 0.0) ? 1 : 0);
+        res += ((dot(frustum[i], vec4(boxMax.x, boxMax.y, boxMax.z, 1.0)) < 0.0) ? 1 : 0);
         if (res == 8) {
             return false;
         }
@@ -62,21 +76,36 @@ bool isVisible(int cx, int cz, int minY, int maxY) {
     return true;
 }
 
+// One invocation per chunk section, each emitting a draw command for its section's vertices if they may be visible
 void main() {
-    uint index = gl_GlobalInvocationID.x;
+    uint sectionIndex = gl_GlobalInvocationID.x;
+    uint index = sectionIndex / uint(SECTION_COUNT);
     if (index >= chunks.length()) {
         return;
     }
 
     Chunk chunk = chunks[index];
-    bool visible = isVisible(chunk.cx, chunk.cz, chunk.minY, chunk.maxY);
+    if (chunk.numVertices == 0u) {
+        return;
+    }
+
+    ChunkSection section = sections[sectionIndex];
+    if (section.numVertices == 0u) {
+        return;
+    }
+
+    // Bounds of coarser chunks are in units of 2^lod voxels
+    vec3 origin = vec3(chunk.cx * CHUNK_SIZE, chunk.cy * CHUNK_HEIGHT, chunk.cz * CHUNK_SIZE);
+    float scale = float(1 << chunk.lod);
+    bool visible = isVisible(origin + vec3(unpackBounds(section.boundsMin)) * scale,
+                             origin + vec3(unpackBounds(section.boundsMax)) * scale);
 
     if (visible) {
         uint dci = atomicAdd(commandCount, 1);
 
-        drawCommands[dci].count = chunk.numVertices;
+        drawCommands[dci].count = section.numVertices;
         drawCommands[dci].instanceCount = 1;
-        drawCommands[dci].firstIndex = chunk.firstIndex;
+        drawCommands[dci].firstIndex = chunk.firstIndex + section.firstVertex;
         drawCommands[dci].baseInstance = 0;
         drawCommands[dci].chunkIndex = index;
     }
@@ -2,13 +2,13 @@
 
 struct Chunk {
     int cx;
+    int cy;
     int cz;
     int minY;
     int maxY;
     uint numVertices;
     uint firstIndex;
-    uint _pad0;
-    uint _pad1;
+    int lod;
 };
 
 struct ChunkDrawCommand {
@@ -28,6 +28,7 @@ uniform mat4 projection;
 
 // Vertex packing format uniforms
 uniform int chunkSizeShift;
+uniform int chunkHeightShift;
 
 uniform uint xBits;
 uniform uint yBits;
@@ -78,10 +79,12 @@ void main() {
     normal = int((vertex >> normalShift) & normalMask);
     float ao = float((vertex >> aoShift) & aoMask);
 
-    mat4 model = mat4(1.0, 0.0, 0.0, 0.0,
-                      0.0, 1.0, 0.0, 0.0,
-                      0.0, 0.0, 1.0, 0.0,
-                      float(chunk.cx << chunkSizeShift), 0, float(chunk.cz << chunkSizeShift), 1.0);
+    // Coarser chunks are meshed in units of 2^lod voxels
+    float scale = float(1 << chunk.lod);
+    mat4 model = mat4(scale, 0.0, 0.0, 0.0,
+                      0.0, scale, 0.0, 0.0,
+                      0.0, 0.0, scale, 0.0,
+                      float(chunk.cx << chunkSizeShift), float(chunk.cy << chunkHeightShift), float(chunk.cz << chunkSizeShift), 1.0);
 
     gl_Position = projection * view * model * vec4(x, y, z, 1.0);
     // ourColor = get_color(uint(aColor));
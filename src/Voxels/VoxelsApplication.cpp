@@ -16,6 +16,8 @@
 #include "entity/components/Q3PlayerController.hpp"
 #include "entity/components/Transform.hpp"
 #include "io/Input.hpp"
+#include "world/ClimateMap.hpp"
+#include "world/Frustum.hpp"
 #include "world/VertexFormat.hpp"
 
 constexpr float Pi = 3.14159265359f;
@@ -64,13 +66,13 @@ bool VoxelsApplication::load() {
     shader = Shader("vert.glsl", "frag.glsl");
     drawCommandProgram = Shader("drawcmd_comp.glsl");
 
-    worldManager.createChunk(0, 0);
+    worldManager.createChunk(0, 0, 0);
 
     glCreateVertexArrays(1, &dummyVAO);
 
     glCreateBuffers(1, &chunkDrawCmdBuffer);
     glNamedBufferStorage(chunkDrawCmdBuffer,
-                         sizeof(ChunkDrawCommand) * MaxChunks,
+                         sizeof(ChunkDrawCommand) * MaxChunkSections,
                          nullptr,
                          GL_DYNAMIC_STORAGE_BIT);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, chunkDrawCmdBuffer);
@@ -82,6 +84,13 @@ bool VoxelsApplication::load() {
                          GL_DYNAMIC_DRAW);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, chunkDataBuffer);
 
+    glCreateBuffers(1, &chunkSectionBuffer);
+    glNamedBufferStorage(chunkSectionBuffer,
+                         sizeof(ChunkSection) * MaxChunkSections,
+                         nullptr,
+                         GL_DYNAMIC_STORAGE_BIT);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, chunkSectionBuffer);
+
     glCreateBuffers(1, &commandCountBuffer);
     glNamedBufferStorage(commandCountBuffer,
                          sizeof(unsigned int),
@@ -97,10 +106,11 @@ bool VoxelsApplication::load() {
                       GL_DYNAMIC_STORAGE_BIT);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, verticesBuffer);
 
-    worldManager.updateVerticesBuffer(verticesBuffer, chunkDataBuffer);
+    worldManager.updateVerticesBuffer(verticesBuffer, chunkDataBuffer, chunkSectionBuffer);
 
     shader.use();
     shader.setInt("chunkSizeShift", ChunkSizeShift);
+    shader.setInt("chunkHeightShift", ChunkHeightShift);
     shader.setInt("windowWidth", windowWidth);
     shader.setInt("windowHeight", windowHeight);
 
@@ -235,7 +245,63 @@ void VoxelsApplication::setupUI() {
                     player->get<Transform>()->position.x,
                     player->get<Transform>()->position.y,
                     player->get<Transform>()->position.z);
+        const glm::ivec3 column = glm::floor(player->get<Transform>()->position);
+        if (const std::optional<int> surface = worldManager.surfaceHeight(column.x, column.z)) {
+            ImGui::Text("Surface Height: %d", *surface);
+        } else {
+            ImGui::Text("Surface Height: -");
+        }
         ImGui::Text("Chunks Loaded: %llu", worldManager.chunks.size());
+        ImGui::Text("Voxel Memory: %.2f MB", static_cast<double>(worldManager.voxelMemoryUsage()) / (1024.0 * 1024.0));
+        const BufferPoolStats poolStats = VoxelStorage::poolStats();
+        ImGui::Text("Voxel Pool: %zu buffers, %.2f MB, %.1f%% reused", poolStats.pooledBuffers,
+                    static_cast<double>(poolStats.pooledBytes) / (1024.0 * 1024.0),
+                    poolStats.acquired == 0 ? 0.0 : 100.0 * static_cast<double>(poolStats.reused) / static_cast<double>(poolStats.acquired));
+        ImGui::Text("Voxel Copies On Write: %llu", static_cast<unsigned long long>(SharedVoxels::copyCount()));
+        const ChunkCacheStats& cacheStats = worldManager.chunkCache.getStats();
+        const size_t cacheLookups = cacheStats.hits + cacheStats.misses;
+        ImGui::Text("Chunk Cache: %zu chunks, %.2f MB, %zu hits, %zu misses (%.1f%%)", cacheStats.entries,
+                    static_cast<double>(cacheStats.bytes) / (1024.0 * 1024.0), cacheStats.hits, cacheStats.misses,
+                    cacheLookups == 0 ? 0.0 : 100.0 * static_cast<double>(cacheStats.hits) / static_cast<double>(cacheLookups));
+        // Summed over every noise backend, with and without biomes, so whichever the generator's stages use shows up
+        HeightmapCacheStats heightmapStats;
+        ClimateMapStats climateStats;
+        for (const NoiseBackend backend : {NoiseBackend::Perlin, NoiseBackend::Simplex}) {
+            heightmapStats += Chunk::heightmapCache(backend, false).getStats();
+            heightmapStats += Chunk::heightmapCache(backend, true).getStats();
+            climateStats += ClimateMap::climate(backend).getStats();
+        }
+        const size_t heightmapLookups = heightmapStats.hits + heightmapStats.misses;
+        ImGui::Text("Heightmap Cache: %zu tiles, %.1f%% hits", heightmapStats.tiles,
+                    heightmapLookups == 0 ? 0.0 : 100.0 * static_cast<double>(heightmapStats.hits) / static_cast<double>(heightmapLookups));
+        const size_t climateLookups = climateStats.hits + climateStats.misses;
+        ImGui::Text("Climate Map: %zu regions, %.1f%% hits", climateStats.tiles,
+                    climateLookups == 0 ? 0.0 : 100.0 * static_cast<double>(climateStats.hits) / static_cast<double>(climateLookups));
+        const ChunkSwapStats& swapStats = worldManager.chunkSwap.getStats();
+        ImGui::Text("Chunk Swap: %zu chunks, %.2f / %.2f MB, %zu out, %zu in", swapStats.entries,
+                    static_cast<double>(swapStats.bytes) / (1024.0 * 1024.0),
+                    static_cast<double>(swapStats.fileBytes) / (1024.0 * 1024.0), swapStats.stores, swapStats.loads);
+        const RegionCacheStats regionStats = worldManager.regionCache.getStats();
+        ImGui::Text("Region Cache: %zu read, %zu generated, %zu written, %.2f MB", regionStats.hits, regionStats.misses,
+                    regionStats.stores, static_cast<double>(regionStats.bytes) / (1024.0 * 1024.0));
+        std::array<int, MaxLod + 1> chunksByLod{};
+        for (const std::shared_ptr<Chunk>& chunk : worldManager.chunks) {
+            if (!chunk->destroyed && chunk->generated) {
+                ++chunksByLod[chunk->lod];
+            }
+        }
+        std::string lods;
+        for (int lod = 0; lod <= MaxLod; ++lod) {
+            lods += (lod == 0 ? "" : " / ") + std::to_string(chunksByLod[lod]);
+        }
+        ImGui::Text("Chunks by LOD: %s", lods.c_str());
+        const StreamingStats& streamingStats = worldManager.getStreamingStats();
+        const size_t viewEntries = streamingStats.viewEntries;
+        ImGui::Text("Chunks Into View Unmeshed: %zu of %zu (%.1f%%), %zu now", streamingStats.unmeshedEntries,
+                    viewEntries, viewEntries == 0 ? 0.0 : 100.0 * static_cast<double>(streamingStats.unmeshedEntries) /
+                                                         static_cast<double>(viewEntries),
+                    streamingStats.unmeshedInView);
+        ImGui::SliderFloat("Prefetch Horizon (s)", &worldManager.prefetchSeconds, 0.0f, 5.0f);
         ImGui::Text("FPS: %.2f", 1.0f / deltaTime);
 
         ImGui::Text("WantCaptureKeyboard: %s", ImGui::GetIO().WantCaptureKeyboard ? "true" : "false");
@@ -508,7 +574,7 @@ void VoxelsApplication::setupUI() {
                 if (ImGui::Button("RayPos")) {
                     if (const auto result = worldManager.raycast(player->get<Transform>()->position, getFront(player->get<Transform>()->angles), 16)) {
                         const int wx = (result->cx << ChunkSizeShift) + result->x;
-                        const int wy = result->y;
+                        const int wy = (result->cy << ChunkHeightShift) + result->y;
                         const int wz = (result->cz << ChunkSizeShift) + result->z;
                         origin = {wx, wy, wz};
                     }
@@ -541,6 +607,10 @@ void VoxelsApplication::setupUI() {
         // List of primitives with a position slider
         ImGui::Separator();
         ImGui::Text("Primitives:");
+        constexpr ImGuiDataType VoxelDataType =
+            sizeof(Voxel) == 1 ? ImGuiDataType_U8 : sizeof(Voxel) == 2 ? ImGuiDataType_U16 : ImGuiDataType_U32;
+        const Voxel minVoxelType = static_cast<Voxel>(min);
+        const Voxel maxVoxelType = static_cast<Voxel>(max);
         for (size_t i = 0; i < worldManager.primitives.size(); ++i) {
             ImGui::Text("%zu: %s at ", i,
                         dynamic_cast<Cuboid*>(worldManager.primitives[i].get()) ? "Cuboid" :
@@ -555,7 +625,7 @@ void VoxelsApplication::setupUI() {
                 worldManager.movePrimitive(i, worldManager.primitives[i]->origin);
             }
             ImGui::Text("Palette index:");
-            if (ImGui::SliderScalar(("##primitivePaletteIndex" + std::to_string(i)).c_str(), ImGuiDataType_U32, &(worldManager.primitives[i]->voxelType), &min, &max)) {
+            if (ImGui::SliderScalar(("##primitivePaletteIndex" + std::to_string(i)).c_str(), VoxelDataType, &(worldManager.primitives[i]->voxelType), &minVoxelType, &maxVoxelType)) {
                 worldManager.movePrimitive(i, worldManager.primitives[i]->origin);  // TODO: hacky
             }
 
@@ -575,6 +645,9 @@ void VoxelsApplication::update() {
 
     Application::update();
 
+    // Chunks changing level of detail go first, as the ones near the player matter more than new ones at the horizon
+    worldManager.predictMotion(player->get<Kinematics>()->velocity, getFront(player->get<Transform>()->angles));
+    worldManager.updateChunkLods(player->get<Transform>()->position);
     while (worldManager.updateFrontierChunks(player->get<Transform>()->position)) {}
 
     // If any chunks have finished generating, update their voxel field
@@ -582,7 +655,7 @@ void VoxelsApplication::update() {
 
     worldManager.chunkTasksCount = 0;
 
-    worldManager.updateVerticesBuffer(verticesBuffer, chunkDataBuffer);
+    worldManager.updateVerticesBuffer(verticesBuffer, chunkDataBuffer, chunkSectionBuffer);
 
     player->get<PlayerController>()->update(deltaTime);
 
@@ -622,24 +695,20 @@ void VoxelsApplication::render() {
                                             static_cast<float>(windowWidth) / static_cast<float>(windowHeight), 0.1f, 5000.0f);
     const glm::mat4 view = calculateViewMatrix(player->get<Transform>()->position, player->get<Transform>()->angles);
 
-    glm::mat4 projectionT = glm::transpose(projection * view);
-    glm::vec4 frustum[6];
-    frustum[0] = projectionT[3] + projectionT[0];  // x + w < 0
-    frustum[1] = projectionT[3] - projectionT[0];  // x - w > 0
-    frustum[2] = projectionT[3] + projectionT[1];  // y + w < 0
-    frustum[3] = projectionT[3] - projectionT[1];  // y - w > 0
-    frustum[4] = projectionT[3] + projectionT[2];  // z + w < 0
-    frustum[5] = projectionT[3] - projectionT[2];  // z - w > 0
+    const Frustum frustum = Frustum::fromMatrix(projection * view);
+    worldManager.updateVisibility(frustum);
 
     // Clear command count buffer
     glClearNamedBufferData(commandCountBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
 
     // Generate draw commands
     drawCommandProgram.use();
-    drawCommandProgram.setVec4Array("frustum", frustum, 6);
+    drawCommandProgram.setVec4Array("frustum", frustum.planes.data(), 6);
     drawCommandProgram.setInt("CHUNK_SIZE", ChunkSize);
+    drawCommandProgram.setInt("CHUNK_HEIGHT", ChunkHeight);
+    drawCommandProgram.setInt("SECTION_COUNT", SectionCount);
 
-    glDispatchCompute(MaxChunks / 1, 1, 1);
+    glDispatchCompute((MaxChunkSections + 63) / 64, 1, 1);
     glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
 
     // Render
@@ -659,7 +728,7 @@ void VoxelsApplication::render() {
 
     glBindVertexArray(dummyVAO);
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER, chunkDrawCmdBuffer);
-    glMultiDrawArraysIndirectCount(GL_TRIANGLES, nullptr, 0, MaxChunks, sizeof(ChunkDrawCommand));
+    glMultiDrawArraysIndirectCount(GL_TRIANGLES, nullptr, 0, MaxChunkSections, sizeof(ChunkDrawCommand));
 
     uiManager.render();
 }
@@ -671,6 +740,7 @@ void VoxelsApplication::processInput() {
 void VoxelsApplication::cleanup() {
     glDeleteBuffers(1, &chunkDrawCmdBuffer);
     glDeleteBuffers(1, &chunkDataBuffer);
+    glDeleteBuffers(1, &chunkSectionBuffer);
     glDeleteBuffers(1, &commandCountBuffer);
     glDeleteBuffers(1, &verticesBuffer);
 
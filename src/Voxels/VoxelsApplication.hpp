@@ -53,6 +53,7 @@ private:
     GLuint dummyVAO = 0;
     GLuint chunkDrawCmdBuffer = 0;
     GLuint chunkDataBuffer = 0;
+    GLuint chunkSectionBuffer = 0;
     GLuint commandCountBuffer = 0;
     GLuint verticesBuffer = 0;
 
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+struct BufferPoolStats {
+    size_t acquired = 0;      // Total calls to acquire
+    size_t reused = 0;        // Calls to acquire that were served from the pool
+    size_t released = 0;      // Buffers handed back (including those dropped because the pool was full)
+    size_t pooledBuffers = 0; // Buffers currently waiting to be reused
+    size_t pooledBytes = 0;
+
+    BufferPoolStats& operator+=(const BufferPoolStats& other) {
+        acquired += other.acquired;
+        reused += other.reused;
+        released += other.released;
+        pooledBuffers += other.pooledBuffers;
+        pooledBytes += other.pooledBytes;
+        return *this;
+    }
+};
+
+// Thread-safe free list of std::vector buffers, bucketed by capacity rounded up to a power of two. Released buffers
+// keep their allocation, so once the pool has warmed up, acquiring a buffer of a size that has been seen before does
+// not touch the heap. Callers tend to use a handful of fixed sizes, so buffers are allocated at exactly the requested
+// capacity rather than the bucket size.
+template<typename T>
+class BufferPool {
+public:
+    using Buffer = std::vector<T>;
+
+    explicit BufferPool(const size_t maxPooledBytes = size_t{64} << 20)
+        : maxPooledBytes(maxPooledBytes)
+    {}
+
+    // Returns a buffer of exactly size value-initialised elements
+    Buffer acquire(const size_t size) {
+        Buffer buffer = reserve(size);
+        buffer.assign(size, T{});
+        return buffer;
+    }
+
+    // Returns an empty buffer with room for at least capacity elements
+    Buffer reserve(const size_t capacity) {
+        if (capacity == 0) {
+            return {};
+        }
+
+        const size_t bucket = bucketFor(capacity);
+        Buffer buffer;
+        {
+            std::scoped_lock lock(mutex);
+            ++stats.acquired;
+            if (bucket < BucketCount) {
+                // Buffers in a bucket can be anywhere up to twice each other's size, so a smaller one released later
+                // mustn't hide one that fits. The most recently released are tried first, as they're likelier cached.
+                auto& free = buckets[bucket];
+                for (auto it = free.rbegin(); it != free.rend(); ++it) {
+                    if (it->capacity() >= capacity) {
+                        buffer = std::move(*it);
+                        *it = std::move(free.back());
+                        free.pop_back();
+                        ++stats.reused;
+                        --stats.pooledBuffers;
+                        stats.pooledBytes -= buffer.capacity() * sizeof(T);
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (buffer.capacity() == 0) {
+            buffer.reserve(capacity);
+        }
+        return buffer;
+    }
+
+    void release(Buffer buffer) {
+        if (buffer.capacity() == 0) {
+            return;
+        }
+
+        const size_t bucket = bucketFor(buffer.capacity());
+        const size_t bytes = buffer.capacity() * sizeof(T);
+
+        std::scoped_lock lock(mutex);
+        ++stats.released;
+        if (bucket >= BucketCount || stats.pooledBytes + bytes > maxPooledBytes) {
+            return;
+        }
+
+        buffer.clear();
+        buckets[bucket].push_back(std::move(buffer));
+        ++stats.pooledBuffers;
+        stats.pooledBytes += bytes;
+    }
+
+    [[nodiscard]] BufferPoolStats getStats() {
+        std::scoped_lock lock(mutex);
+        return stats;
+    }
+
+private:
+    static constexpr size_t BucketCount = 32;
+
+    static size_t bucketFor(const size_t size) {
+        return std::bit_width(size - 1);
+    }
+
+    const size_t maxPooledBytes;
+
+    std::mutex mutex;
+    std::array<std::vector<Buffer>, BucketCount> buckets;
+    BufferPoolStats stats;
+};
@@ -0,0 +1,128 @@
+#include "MappedFile.hpp"
+
+#include <iostream>
+#include <system_error>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::filesystem::path& path, const size_t size) {
+    close();
+    filePath = path;
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                FILE_ATTRIBUTE_TEMPORARY, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        std::cerr << "Failed to create mapped file: " << path << std::endl;
+        return false;
+    }
+    file = handle;
+#else
+    file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (file < 0) {
+        std::cerr << "Failed to create mapped file: " << path << std::endl;
+        return false;
+    }
+#endif
+
+    if (!map(size)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    unmap();
+
+#ifdef _WIN32
+    if (file != nullptr) {
+        CloseHandle(file);
+        file = nullptr;
+    }
+#else
+    if (file >= 0) {
+        ::close(file);
+        file = -1;
+    }
+#endif
+
+    if (!filePath.empty()) {
+        std::error_code error;
+        std::filesystem::remove(filePath, error);
+        filePath.clear();
+    }
+}
+
+bool MappedFile::resize(const size_t size) {
+    unmap();
+    return map(size);
+}
+
+bool MappedFile::map(const size_t size) {
+#ifdef _WIN32
+    LARGE_INTEGER length;
+    length.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(file, length, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+        std::cerr << "Failed to resize mapped file: " << filePath << std::endl;
+        return false;
+    }
+
+    fileMapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+    if (fileMapping == nullptr) {
+        std::cerr << "Failed to map file: " << filePath << std::endl;
+        return false;
+    }
+    mapping = static_cast<std::byte*>(MapViewOfFile(fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    if (mapping == nullptr) {
+        CloseHandle(fileMapping);
+        fileMapping = nullptr;
+        std::cerr << "Failed to map file: " << filePath << std::endl;
+        return false;
+    }
+#else
+    if (ftruncate(file, static_cast<off_t>(size)) != 0) {
+        std::cerr << "Failed to resize mapped file: " << filePath << std::endl;
+        return false;
+    }
+
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (address == MAP_FAILED) {
+        std::cerr << "Failed to map file: " << filePath << std::endl;
+        return false;
+    }
+    mapping = static_cast<std::byte*>(address);
+#endif
+
+    mappedSize = size;
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (mapping == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+    CloseHandle(fileMapping);
+    fileMapping = nullptr;
+#else
+    munmap(mapping, mappedSize);
+#endif
+
+    mapping = nullptr;
+    mappedSize = 0;
+}
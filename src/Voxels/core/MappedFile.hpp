@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+// A file mapped read-write into memory. The file is created (or truncated) by open and deleted again by close, so it
+// suits scratch data such as swap space rather than anything meant to outlive the process.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Returns false if the file couldn't be created or mapped
+    bool open(const std::filesystem::path& path, size_t size);
+    void close();
+
+    // Grows or shrinks the file and maps it again, which moves data()
+    bool resize(size_t size);
+
+    [[nodiscard]] bool isOpen() const { return mapping != nullptr; }
+    [[nodiscard]] std::byte* data() const { return mapping; }
+    [[nodiscard]] size_t size() const { return mappedSize; }
+
+private:
+    std::filesystem::path filePath;
+    std::byte* mapping = nullptr;
+    size_t mappedSize = 0;
+
+#ifdef _WIN32
+    void* file = nullptr;
+    void* fileMapping = nullptr;
+#else
+    int file = -1;
+#endif
+
+    bool map(size_t size);
+    void unmap();
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+struct TileCacheStats {
+    size_t hits = 0;       // Lookups that found the tile resident (possibly still being filled by another thread)
+    size_t misses = 0;     // Lookups that had to fill the tile
+    size_t evictions = 0;  // Tiles dropped to stay within the budget
+    size_t tiles = 0;      // Tiles currently resident
+
+    TileCacheStats& operator+=(const TileCacheStats& other) {
+        hits += other.hits;
+        misses += other.misses;
+        evictions += other.evictions;
+        tiles += other.tiles;
+        return *this;
+    }
+};
+
+// Packs a pair of tile (or region) coordinates into a single key
+inline uint64_t tileKey(const int tx, const int tz) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(tx)) << 32 | static_cast<uint32_t>(tz);
+}
+
+// Values for a 2D grid of tiles, shared by every thread. A tile is filled by the first thread to ask for it; threads
+// asking for it meanwhile wait for that thread rather than filling it again, so each tile is filled once while it's
+// resident. The least recently used tiles are evicted once there are more than maxTiles, though threads still holding
+// an evicted tile can keep using it.
+template<typename Value, typename Fill = std::function<void(int tx, int tz, Value& value)>>
+class TileCache {
+public:
+    TileCache(Fill fill, const size_t maxTiles)
+        : fill(std::move(fill)), maxTiles(maxTiles)
+    {}
+
+    TileCache(const TileCache&) = delete;
+    TileCache& operator=(const TileCache&) = delete;
+
+    // The tile at tile coordinates (tx, tz)
+    [[nodiscard]] std::shared_ptr<const Value> at(const int tx, const int tz) {
+        std::shared_ptr<Slot> slot;
+        {
+            std::scoped_lock lock(mutex);
+            if (const auto it = slotByKey.find(tileKey(tx, tz)); it != slotByKey.end()) {
+                ++stats.hits;
+                slots.splice(slots.begin(), slots, it->second);
+                slot = *it->second;
+            } else {
+                ++stats.misses;
+                slot = std::make_shared<Slot>();
+                slot->tx = tx;
+                slot->tz = tz;
+                slots.push_front(slot);
+                slotByKey[tileKey(tx, tz)] = slots.begin();
+
+                while (slots.size() > maxTiles) {
+                    slotByKey.erase(tileKey(slots.back()->tx, slots.back()->tz));
+                    slots.pop_back();
+                    ++stats.evictions;
+                }
+                stats.tiles = slots.size();
+            }
+        }
+
+        // Outside the lock, so tiles are filled in parallel, but only once each
+        std::call_once(slot->filled, [&] {
+            fill(tx, tz, slot->value);
+        });
+
+        // Shares ownership with the slot, so the tile outlives its eviction for as long as the caller needs it
+        return {slot, &slot->value};
+    }
+
+    void clear() {
+        std::scoped_lock lock(mutex);
+        slots.clear();
+        slotByKey.clear();
+        stats.tiles = 0;
+    }
+
+    [[nodiscard]] TileCacheStats getStats() const {
+        std::scoped_lock lock(mutex);
+        return stats;
+    }
+
+private:
+    struct Slot {
+        int tx;
+        int tz;
+        std::once_flag filled;
+        Value value;
+    };
+
+    Fill fill;
+    size_t maxTiles;
+
+    mutable std::mutex mutex;
+    std::list<std::shared_ptr<Slot>> slots;  // Most recently used first
+    std::unordered_map<uint64_t, typename std::list<std::shared_ptr<Slot>>::iterator> slotByKey;
+    TileCacheStats stats;
+};
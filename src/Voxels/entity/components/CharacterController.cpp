@@ -32,10 +32,10 @@ void CharacterController::collisionDetection(const glm::vec3& velocity, const fl
     const int maxZ = static_cast<int>(std::floor(transform->position.z + PLAYER_WIDTH + (dz > 0 ? dz : 0)));
 
     // Loop over all voxels that could possibly collide with the player
-    for (int y = std::min(ChunkHeight - 1, maxY); y >= 0 && y >= minY; y--) {
+    for (int y = std::min(WorldHeight - 1, maxY); y >= 0 && y >= minY; y--) {
         for (int z = minZ; z <= maxZ; z++) {
             for (int x = minX; x <= maxX; x++) {
-                if (worldManager.load(x, y, z) == 0) {
+                if (!worldManager.isSolid(x, y, z)) {
                     continue;
                 }
 
@@ -54,13 +54,13 @@ void CharacterController::intersectSweptAabbAabb(const int x, const int y, const
     const float pxmax = px + PLAYER_WIDTH, pxmin = px - PLAYER_WIDTH, pymax = py + PLAYER_HEIGHT - PLAYER_EYE_HEIGHT, pymin = py - PLAYER_EYE_HEIGHT,
                 pzmax = pz + PLAYER_WIDTH, pzmin = pz - PLAYER_WIDTH;
     const float xInvEntry = dx > 0 ? -pxmax : 1 - pxmin, xInvExit = dx > 0 ? 1 - pxmin : -pxmax;
-    const bool xNotValid = dx == 0 || worldManager.load(x + (dx > 0 ? -1 : 1), y, z) != EmptyVoxel;
+    const bool xNotValid = dx == 0 || worldManager.isSolid(x + (dx > 0 ? -1 : 1), y, z);
     const float xEntry = xNotValid ? negativeInfinity : xInvEntry / dx, xExit = xNotValid ? positiveInfinity : xInvExit / dx;
     const float yInvEntry = dy > 0 ? -pymax : 1 - pymin, yInvExit = dy > 0 ? 1 - pymin : -pymax;
-    const bool yNotValid = dy == 0 || worldManager.load(x, y + (dy > 0 ? -1 : 1), z) != EmptyVoxel;
+    const bool yNotValid = dy == 0 || worldManager.isSolid(x, y + (dy > 0 ? -1 : 1), z);
     const float yEntry = yNotValid ? negativeInfinity : yInvEntry / dy, yExit = yNotValid ? positiveInfinity : yInvExit / dy;
     const float zInvEntry = dz > 0 ? -pzmax : 1 - pzmin, zInvExit = dz > 0 ? 1 - pzmin : -pzmax;
-    const bool zNotValid = dz == 0 || worldManager.load(x, y, z + (dz > 0 ? -1 : 1)) != EmptyVoxel;
+    const bool zNotValid = dz == 0 || worldManager.isSolid(x, y, z + (dz > 0 ? -1 : 1));
     const float zEntry = zNotValid ? negativeInfinity : zInvEntry / dz, zExit = zNotValid ? positiveInfinity : zInvExit / dz;
     const float tEntry = std::max(std::max(xEntry, yEntry), zEntry), tExit = std::min(std::min(xExit, yExit), zExit);
     if (tEntry < -.5f || tEntry > tExit) {
@@ -97,7 +97,7 @@ void CharacterController::collisionResponse(glm::vec3& velocity, const float dt,
         if (contact.nx != 0) {
             minX = dx < 0 ? std::max(minX, contact.x) : minX;
             maxX = dx < 0 ? maxX : std::min(maxX, contact.x);
-            if (worldManager.load(contact.x, contact.y + 1, contact.z) == EmptyVoxel) {
+            if (!worldManager.isSolid(contact.x, contact.y + 1, contact.z)) {
                 goUp = true;
             } else {
                 velocity.x = 0.0f;
@@ -112,7 +112,7 @@ void CharacterController::collisionResponse(glm::vec3& velocity, const float dt,
         } else if (contact.nz != 0) {
             minZ = dz < 0 ? std::max(minZ, contact.z) : minZ;
             maxZ = dz < 0 ? maxZ : std::min(maxZ, contact.z);
-            if (worldManager.load(contact.x, contact.y + 1, contact.z) == EmptyVoxel) {
+            if (!worldManager.isSolid(contact.x, contact.y + 1, contact.z)) {
                 goUp = true;
             } else {
                 velocity.z = 0.0f;
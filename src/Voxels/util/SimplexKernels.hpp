@@ -0,0 +1,241 @@
+// The noise kernels of SimplexNoise.cpp, written once for a single float or a vector of SIMPLEX_LANES of them. Included
+// once for each instruction set the batches are compiled for, inside a namespace of its own, so this has no include
+// guard and nothing is included here.
+
+constexpr uint32_t PrimeX = 501125321u;
+constexpr uint32_t PrimeY = 1136930381u;
+constexpr uint32_t PrimeZ = 1720413743u;
+constexpr uint32_t OctaveSeedStep = 0x9E3779B9u;
+
+// The largest sums of the kernels come to just under 1 after scaling
+constexpr float Scale2D = 99.0f;
+constexpr float Scale3D = 32.0f;
+
+SIMPLEX_INLINE float select(const bool mask, const float a, const float b) { return mask ? a : b; }
+SIMPLEX_INLINE uint32_t select(const bool mask, const uint32_t a, const uint32_t b) { return mask ? a : b; }
+
+SIMPLEX_INLINE uint32_t floorToInt(const float x) {
+    const int i = static_cast<int>(x);
+    return static_cast<uint32_t>(x < static_cast<float>(i) ? i - 1 : i);
+}
+
+SIMPLEX_INLINE float toFloat(const uint32_t i) { return static_cast<float>(static_cast<int>(i)); }
+
+SIMPLEX_INLINE float magnitude(const float x) { return x < 0.0f ? -x : x; }
+
+#if defined(SIMPLEX_VECTORS)
+// Comparisons give a mask of all ones or all zeros in each lane
+constexpr size_t Lanes = SIMPLEX_LANES;
+using FloatLanes = float __attribute__((vector_size(Lanes * sizeof(float))));
+using IntLanes = uint32_t __attribute__((vector_size(Lanes * sizeof(uint32_t))));
+using MaskLanes = int32_t __attribute__((vector_size(Lanes * sizeof(int32_t))));
+
+SIMPLEX_INLINE FloatLanes select(const MaskLanes mask, const FloatLanes a, const FloatLanes b) {
+    return (FloatLanes)((mask & (MaskLanes)a) | (~mask & (MaskLanes)b));
+}
+
+SIMPLEX_INLINE IntLanes select(const MaskLanes mask, const IntLanes a, const IntLanes b) {
+    return (a & (IntLanes)mask) | (b & ~(IntLanes)mask);
+}
+
+// Truncated towards zero, then one less where that rounded up
+SIMPLEX_INLINE IntLanes floorToInt(const FloatLanes x) {
+    const MaskLanes i = __builtin_convertvector(x, MaskLanes);
+    return (IntLanes)(i + (x < __builtin_convertvector(i, FloatLanes)));
+}
+
+SIMPLEX_INLINE FloatLanes toFloat(const IntLanes i) { return __builtin_convertvector((MaskLanes)i, FloatLanes); }
+
+SIMPLEX_INLINE FloatLanes magnitude(const FloatLanes x) { return (FloatLanes)((IntLanes)x & 0x7FFFFFFFu); }
+#endif
+
+// A float or vector of them with every lane set to value
+template<typename T, typename S>
+SIMPLEX_INLINE T broadcast(const S value) {
+    return T{} + value;
+}
+
+template<typename F>
+SIMPLEX_INLINE F kernel(const F a) {
+    const F positive = select(a > 0.0f, a, broadcast<F>(0.0f));
+    const F squared = positive * positive;
+    return squared * squared;
+}
+
+template<typename F>
+SIMPLEX_INLINE F remap01(const F sum) {
+    const F low = select(sum < -1.0f, broadcast<F>(-1.0f), sum);
+    return select(low > 1.0f, broadcast<F>(1.0f), low) * 0.5f + 0.5f;
+}
+
+// Primes are premultiplied, so neighbouring lattice points differ by a prime in the coordinate they step along
+template<typename I>
+SIMPLEX_INLINE I hash(const I seed, const I xPrimed, const I yPrimed, const I zPrimed) {
+    return (seed ^ xPrimed ^ yPrimed ^ zPrimed) * 0x27D4EB2Du;
+}
+
+// One of 8 unit gradients evenly spaced around the circle, picked by the best mixed bits of the hash
+template<typename F, typename I>
+SIMPLEX_INLINE F gradient2D(const I hash, const F x, const F y) {
+    const I h = hash >> 29;
+    const auto swap = (h & 4u) == 0u;
+    const F u = select(swap, y, x);
+    const F v = select(swap, x, y);
+    return select((h & 1u) == 0u, u, -u) * 0.92387953f + select((h & 2u) == 0u, v, -v) * 0.38268343f;
+}
+
+// One of the 12 edge directions of the cube, 4 of them twice over, as in improved Perlin noise
+template<typename F, typename I>
+SIMPLEX_INLINE F gradient3D(const I hash, const F x, const F y, const F z) {
+    const I h = hash >> 28;
+    const F u = select((h & 8u) == 0u, x, y);                                 // h < 8
+    const F v = select((h & 12u) == 0u, y, select((h & 13u) == 12u, x, z));  // h < 4, h == 12 or h == 14
+    return select((h & 1u) == 0u, u, -u) + select((h & 2u) == 0u, v, -v);
+}
+
+template<typename F, typename I>
+SIMPLEX_INLINE F noise2D(const I seed, const F x, const F y) {
+    constexpr float Skew = 0.36602540378f;    // (sqrt(3) - 1) / 2
+    constexpr float Unskew = 0.21132486541f;  // (3 - sqrt(3)) / 6
+
+    // The triangle containing the point, and the point relative to its first corner
+    const F s = (x + y) * Skew;
+    const I i = floorToInt(x + s);
+    const I j = floorToInt(y + s);
+    const F xi = x + s - toFloat(i);
+    const F yi = y + s - toFloat(j);
+    const F t = (xi + yi) * Unskew;
+    const F x0 = xi - t;
+    const F y0 = yi - t;
+    const I iPrimed = i * PrimeX;
+    const I jPrimed = j * PrimeY;
+    const I zero = broadcast<I>(0u);
+
+    // The middle corner is on the same side of the diagonal as the point
+    const auto upper = y0 > x0;
+    const F x1 = x0 + select(upper, broadcast<F>(Unskew), broadcast<F>(Unskew - 1.0f));
+    const F y1 = y0 + select(upper, broadcast<F>(Unskew - 1.0f), broadcast<F>(Unskew));
+    const F x2 = x0 + (2.0f * Unskew - 1.0f);
+    const F y2 = y0 + (2.0f * Unskew - 1.0f);
+
+    const F n0 = kernel(0.5f - x0 * x0 - y0 * y0) * gradient2D(hash(seed, iPrimed, jPrimed, zero), x0, y0);
+    const I i1 = iPrimed + select(upper, zero, broadcast<I>(PrimeX));
+    const I j1 = jPrimed + select(upper, broadcast<I>(PrimeY), zero);
+    const F n1 = kernel(0.5f - x1 * x1 - y1 * y1) * gradient2D(hash(seed, i1, j1, zero), x1, y1);
+    const F n2 = kernel(0.5f - x2 * x2 - y2 * y2) *
+                 gradient2D(hash<I>(seed, iPrimed + PrimeX, jPrimed + PrimeY, zero), x2, y2);
+    return (n0 + n1 + n2) * Scale2D;
+}
+
+// The kernels of the nearest point of one of the two cubic lattices making up the 3D lattice, and of its neighbour
+// along the axis the point is furthest from it in. (x, y, z) is the point relative to the nearest lattice point,
+// and (sx, sy, sz) the signs of the steps back towards the point.
+template<typename F, typename I>
+SIMPLEX_INLINE F nearestPair(const I seed, const I iPrimed, const I jPrimed, const I kPrimed, const F x, const F y,
+                             const F z, const F sx, const F sy, const F sz) {
+    const F a = 0.6f - x * x - y * y - z * z;
+    const F nearest = kernel(a) * gradient3D(hash(seed, iPrimed, jPrimed, kPrimed), x, y, z);
+
+    const F ax = magnitude(x);
+    const F ay = magnitude(y);
+    const F az = magnitude(z);
+    const auto alongX = (ax >= ay) & (ax >= az);
+    const auto alongY = (ay > ax) & (ay >= az);
+    const auto alongZ = (az > ax) & (az > ay);
+    const F zero = broadcast<F>(0.0f);
+    const F dx = select(alongX, sx, zero);
+    const F dy = select(alongY, sy, zero);
+    const F dz = select(alongZ, sz, zero);
+
+    // A step of 1 the other way from the point to its neighbour
+    const I none = broadcast<I>(0u);
+    const I i = iPrimed + select(alongX, select(sx < 0.0f, broadcast<I>(PrimeX), broadcast<I>(0u - PrimeX)), none);
+    const I j = jPrimed + select(alongY, select(sy < 0.0f, broadcast<I>(PrimeY), broadcast<I>(0u - PrimeY)), none);
+    const I k = kPrimed + select(alongZ, select(sz < 0.0f, broadcast<I>(PrimeZ), broadcast<I>(0u - PrimeZ)), none);
+    const F b = a - 1.0f - 2.0f * (dx * x + dy * y + dz * z);
+    const F second = kernel(b) * gradient3D(hash(seed, i, j, k), x + dx, y + dy, z + dz);
+    return nearest + second;
+}
+
+template<typename F, typename I>
+SIMPLEX_INLINE F noise3D(const I seed, const F x, const F y, const F z) {
+    // Rotated so that y runs along a main diagonal of the lattice, which makes xz slices look alike
+    constexpr float Root3Over3 = 0.57735026919f;
+    const F xz = x + z;
+    const F s = xz * -0.21132486541f;
+    const F yy = y * Root3Over3;
+    const F xr = x + s + yy;
+    const F yr = xz * -Root3Over3 + yy;
+    const F zr = z + s + yy;
+
+    // The nearest point of the first lattice
+    const I i = floorToInt(xr + 0.5f);
+    const I j = floorToInt(yr + 0.5f);
+    const I k = floorToInt(zr + 0.5f);
+    const F x0 = xr - toFloat(i);
+    const F y0 = yr - toFloat(j);
+    const F z0 = zr - toFloat(k);
+    const F sx = select(x0 >= 0.0f, broadcast<F>(-1.0f), broadcast<F>(1.0f));
+    const F sy = select(y0 >= 0.0f, broadcast<F>(-1.0f), broadcast<F>(1.0f));
+    const F sz = select(z0 >= 0.0f, broadcast<F>(-1.0f), broadcast<F>(1.0f));
+    const I iPrimed = i * PrimeX;
+    const I jPrimed = j * PrimeY;
+    const I kPrimed = k * PrimeZ;
+    const F first = nearestPair(seed, iPrimed, jPrimed, kPrimed, x0, y0, z0, sx, sy, sz);
+
+    // The second lattice is offset by half a step along each axis, and has its own gradients. Its point (i, j, k)
+    // is at (i - 0.5, j - 0.5, k - 0.5).
+    const F x1 = sx * (0.5f - magnitude(x0));
+    const F y1 = sy * (0.5f - magnitude(y0));
+    const F z1 = sz * (0.5f - magnitude(z0));
+    const I i1 = select(sx < 0.0f, iPrimed + PrimeX, iPrimed);
+    const I j1 = select(sy < 0.0f, jPrimed + PrimeY, jPrimed);
+    const I k1 = select(sz < 0.0f, kPrimed + PrimeZ, kPrimed);
+    const F second = nearestPair(~seed, i1, j1, k1, x1, y1, z1, -sx, -sy, -sz);
+    return (first + second) * Scale3D;
+}
+
+// Octaves of noise at a point or a vector of them, remapped to [0, 1]. Every lane runs the same operations as a
+// single point would, so batches return exactly what the scalar functions do.
+template<bool Is3D, typename F, typename I>
+SIMPLEX_INLINE F octave(const uint32_t seed, const F x, const F y, const F z, const int octaves,
+                        const float persistence) {
+    F sum = broadcast<F>(0.0f);
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    for (int octave = 0; octave < octaves; ++octave) {
+        const I octaveSeed = broadcast<I>(seed + static_cast<uint32_t>(octave) * OctaveSeedStep);
+        if constexpr (Is3D) {
+            sum += noise3D(octaveSeed, x * frequency, y * frequency, z * frequency) * amplitude;
+        } else {
+            sum += noise2D(octaveSeed, x * frequency, y * frequency) * amplitude;
+        }
+        frequency *= 2.0f;
+        amplitude *= persistence;
+    }
+    return remap01(sum);
+}
+
+// Whole vectors of points, then the rest one at a time
+template<bool Is3D>
+SIMPLEX_INLINE void batch(const uint32_t seed, const float* xs, const float* ys, const float* zs, float* out,
+                          const size_t count, const int octaves, const float persistence) {
+    size_t i = 0;
+#if defined(SIMPLEX_VECTORS)
+    for (; i + Lanes <= count; i += Lanes) {
+        FloatLanes x;
+        FloatLanes y;
+        FloatLanes z{};
+        std::memcpy(&x, xs + i, sizeof(FloatLanes));
+        std::memcpy(&y, ys + i, sizeof(FloatLanes));
+        if constexpr (Is3D) {
+            std::memcpy(&z, zs + i, sizeof(FloatLanes));
+        }
+        const FloatLanes noise = octave<Is3D, FloatLanes, IntLanes>(seed, x, y, z, octaves, persistence);
+        std::memcpy(out + i, &noise, sizeof(FloatLanes));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = octave<Is3D, float, uint32_t>(seed, xs[i], ys[i], Is3D ? zs[i] : 0.0f, octaves, persistence);
+    }
+}
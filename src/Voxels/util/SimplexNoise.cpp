@@ -0,0 +1,90 @@
+#include "SimplexNoise.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+#include "PerlinNoise.hpp"
+
+// The kernels are compiled once with 4-lane vectors, which every x86-64 CPU has SSE for, and on x86-64 again with
+// 8-lane vectors for AVX2. The AVX2 copy is compiled entirely for AVX2 rather than inlined into an AVX2 function, as GCC
+// warns that passing 8-lane vectors between functions compiled without AVX changes the ABI. Vectors use the GCC and
+// Clang vector extensions; other compilers evaluate batches a point at a time.
+#if defined(__GNUC__) || defined(__clang__)
+#   define SIMPLEX_VECTORS
+#   define SIMPLEX_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#   define SIMPLEX_INLINE __forceinline
+#else
+#   define SIMPLEX_INLINE inline
+#endif
+
+namespace {
+#   define SIMPLEX_LANES 4
+#   include "SimplexKernels.hpp"
+#   undef SIMPLEX_LANES
+
+#if defined(SIMPLEX_VECTORS) && defined(SIVPERLIN_X86_SIMD)
+#   if defined(__clang__)
+#       pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#   else
+#       pragma GCC push_options
+#       pragma GCC target("avx2")
+#   endif
+    namespace avx2 {
+#       define SIMPLEX_LANES 8
+#       include "SimplexKernels.hpp"
+#       undef SIMPLEX_LANES
+
+        template<bool Is3D>
+        void octaveBatch(const uint32_t seed, const float* xs, const float* ys, const float* zs, float* out,
+                         const size_t count, const int octaves, const float persistence) {
+            batch<Is3D>(seed, xs, ys, zs, out, count, octaves, persistence);
+        }
+    }
+#   if defined(__clang__)
+#       pragma clang attribute pop
+#   else
+#       pragma GCC pop_options
+#   endif
+#endif
+
+    template<bool Is3D>
+    void octaveBatchDispatch(const uint32_t seed, const float* xs, const float* ys, const float* zs, float* out,
+                             const size_t count, const int octaves, const float persistence) {
+#if defined(SIMPLEX_VECTORS) && defined(SIVPERLIN_X86_SIMD)
+        if (siv::perlin_detail::SupportedSimdLevel() == siv::perlin_detail::SimdLevel::AVX2) {
+            avx2::octaveBatch<Is3D>(seed, xs, ys, zs, out, count, octaves, persistence);
+            return;
+        }
+#endif
+        batch<Is3D>(seed, xs, ys, zs, out, count, octaves, persistence);
+    }
+}
+
+float SimplexNoise::noise2D(const float x, const float y) const {
+    return ::noise2D(seed, x, y);
+}
+
+float SimplexNoise::noise3D(const float x, const float y, const float z) const {
+    return ::noise3D(seed, x, y, z);
+}
+
+float SimplexNoise::octave2D_01(const float x, const float y, const int octaves, const float persistence) const {
+    return octave<false, float, uint32_t>(seed, x, y, 0.0f, octaves, persistence);
+}
+
+float SimplexNoise::octave3D_01(const float x, const float y, const float z, const int octaves,
+                                const float persistence) const {
+    return octave<true, float, uint32_t>(seed, x, y, z, octaves, persistence);
+}
+
+void SimplexNoise::octave2D_01(const std::span<const float> x, const std::span<const float> y,
+                               const std::span<float> out, const int octaves, const float persistence) const {
+    octaveBatchDispatch<false>(seed, x.data(), y.data(), nullptr, out.data(), out.size(), octaves, persistence);
+}
+
+void SimplexNoise::octave3D_01(const std::span<const float> x, const std::span<const float> y,
+                               const std::span<const float> z, const std::span<float> out, const int octaves,
+                               const float persistence) const {
+    octaveBatchDispatch<true>(seed, x.data(), y.data(), z.data(), out.data(), out.size(), octaves, persistence);
+}
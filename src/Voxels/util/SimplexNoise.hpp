@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+// Gradient noise on the lattices of OpenSimplex2: triangles in 2D, and in 3D the body-centred cubic lattice, rotated so
+// that horizontal slices of it look alike. A point sums the kernels of its 3 (2D) or 4 (3D) nearest lattice points,
+// where Perlin noise blends all 4 or 8 corners of its square or cube. Everything is float, and gradients come from the
+// bits of each lattice point's hash rather than a permutation table, so every point of a batch runs the same arithmetic
+// without branches or table lookups and the compiler vectorizes whole blocks of points.
+class SimplexNoise {
+public:
+    explicit SimplexNoise(const uint32_t seed = 0) : seed(seed) {}
+
+    // In [-1, 1]
+    [[nodiscard]] float noise2D(float x, float y) const;
+    [[nodiscard]] float noise3D(float x, float y, float z) const;
+
+    // Octaves summed as siv::PerlinNoise sums them, each at twice the frequency of the last, then clamped to [-1, 1]
+    // and remapped to [0, 1]. Each octave is seeded differently, so they don't line up at the origin.
+    [[nodiscard]] float octave2D_01(float x, float y, int octaves, float persistence = 0.5f) const;
+    [[nodiscard]] float octave3D_01(float x, float y, float z, int octaves, float persistence = 0.5f) const;
+
+    // As above for every point, vectorized with AVX2 where the CPU supports it; out holds the same values the scalar
+    // functions return
+    void octave2D_01(std::span<const float> x, std::span<const float> y, std::span<float> out, int octaves,
+                     float persistence = 0.5f) const;
+    void octave3D_01(std::span<const float> x, std::span<const float> y, std::span<const float> z,
+                     std::span<float> out, int octaves, float persistence = 0.5f) const;
+
+private:
+    uint32_t seed;
+};
@@ -0,0 +1,60 @@
+#include "Biome.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace {
+    // Voxels are palette entries, so these are the colours of the default palette: 1 green, 2 red, 4 yellow, 5 lime and
+    // 6 cyan. Mesher draws 3 (orange) like any other voxel, but RunMesher skips it in heightmap terrain, so it's left
+    // out to keep the biomes looking the same with either mesher.
+    constexpr std::array Biomes{
+        Biome{"plains", {0.5f, 0.5f}, 1, 2, {0.45f, 0.6f, 0.5f}},
+        Biome{"forest", {0.5f, 0.85f}, 1, 2, {0.5f, 0.8f, 4.0f}},
+        Biome{"desert", {0.85f, 0.15f}, 4, 4, {0.4f, 0.3f, 0.0f}},
+        Biome{"jungle", {0.85f, 0.8f}, 5, 2, {0.45f, 0.5f, 3.0f}},
+        Biome{"tundra", {0.15f, 0.65f}, 6, 2, {0.55f, 0.8f, 0.5f}},
+        Biome{"mountains", {0.2f, 0.15f}, 2, 2, {0.6f, 1.4f, 0.0f}},
+    };
+
+    // How far in climate a biome's shape reaches. Biomes are about 0.35 apart, so at its own climate a biome's shape
+    // outweighs every other's more than a hundred times over.
+    constexpr float Reach = 0.15f;
+
+    float distanceSquared(const Climate a, const Climate b) {
+        const float dt = a.temperature - b.temperature;
+        const float dh = a.humidity - b.humidity;
+        return dt * dt + dh * dh;
+    }
+}
+
+std::span<const Biome> Biome::all() {
+    return Biomes;
+}
+
+const Biome& Biome::nearest(const Climate climate) {
+    const Biome* nearest = &Biomes[0];
+    float nearestDistance = distanceSquared(climate, nearest->climate);
+    for (const Biome& biome : Biomes) {
+        if (const float distance = distanceSquared(climate, biome.climate); distance < nearestDistance) {
+            nearest = &biome;
+            nearestDistance = distance;
+        }
+    }
+    return *nearest;
+}
+
+TerrainShape Biome::blend(const Climate climate) {
+    TerrainShape shape{0.0f, 0.0f, 0.0f};
+    float total = 0.0f;
+    for (const Biome& biome : Biomes) {
+        const float weight = std::exp(-distanceSquared(climate, biome.climate) / (Reach * Reach));
+        shape.height += biome.shape.height * weight;
+        shape.relief += biome.shape.relief * weight;
+        shape.trees += biome.shape.trees * weight;
+        total += weight;
+    }
+    shape.height /= total;
+    shape.relief /= total;
+    shape.trees /= total;
+    return shape;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <span>
+
+#include "ChunkConstants.hpp"
+
+// Both in [0, 1]
+struct Climate {
+    float temperature = 0.5f;
+    float humidity = 0.5f;
+};
+
+// What the heightmap terrain looks like: a column's height is TerrainHeight * (height + relief * (noise - 0.5)), where
+// the noise is in [0, 1], so the terrain without biomes has a height of 0.5 and a relief of 1
+struct TerrainShape {
+    float height = 0.5f;
+    float relief = 1.0f;
+    float trees = 1.0f;  // Scales the chance of a tree growing in each column
+};
+
+// A kind of terrain, most pronounced where the climate is nearest its own
+struct Biome {
+    const char* name;
+    Climate climate;
+    Voxel surface;  // The top voxel of each column
+    Voxel ground;   // The voxels below it
+    TerrainShape shape;
+
+    // The built-in biomes
+    static std::span<const Biome> all();
+
+    // The biome whose climate is nearest, which gives the column its voxels
+    static const Biome& nearest(Climate climate);
+
+    // The shapes of every biome, weighted by how near their climate is, so the terrain changes smoothly from one
+    // biome to the next even though its voxels don't
+    static TerrainShape blend(Climate climate);
+};
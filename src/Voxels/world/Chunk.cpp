@@ -1,114 +1,208 @@
 #include "Chunk.hpp"
 
-#include "../util/PerlinNoise.hpp"
+#include "ClimateMap.hpp"
+#include "LatticeNoise.hpp"
+#include "TerrainNoise.hpp"
 
-constexpr float Epsilon = 0.000001;
+#include <array>
+#include <span>
+#include <vector>
 
-constexpr unsigned int seed = 123456u;
-constexpr siv::PerlinNoise::seed_type s = seed;
-const siv::PerlinNoise perlin{ s };
+constexpr float Epsilon = 0.000001;
 
-Chunk::Chunk(const int cx, const int cz)
-  : cx(cx), cz(cz)
+Chunk::Chunk(const int cx, const int cy, const int cz)
+  : cx(cx), cy(cy), cz(cz)
 {}
 
-void Chunk::store(const int x, const int y, const int z, const int v) {
-    storeInto(voxels, minY, maxY, x, y, z, v);
+void Chunk::store(const int x, const int y, const int z, const Voxel v) {
+    storeInto(voxels.write(), minY, maxY, x, y, z, v);
+}
+
+void Chunk::fill(const int x, const int z, const int yBegin, const int yEnd, const Voxel v) {
+    fillInto(voxels.write(), minY, maxY, x, z, yBegin, yEnd, v);
 }
 
-int Chunk::load(const int x, const int y, const int z) const {
-    return voxels[getVoxelIndex(x + 1, y, z + 1)];
+Voxel Chunk::load(const int x, const int y, const int z) const {
+    return voxels->load(x >> lod, y >> lod, z >> lod);
 }
 
-void Chunk::storeInto(std::vector<int>& field, int& minY, int& maxY, const int x, const int y, const int z, const int v) {
-    field[getVoxelIndex(x + 1, y, z + 1)] = v;
+void Chunk::storeInto(VoxelStorage& field, int& minY, int& maxY, const int x, const int y, const int z, const Voxel v) {
+    field.store(x, y, z, v);
     minY = std::min(minY, y);
-    maxY = std::max(maxY, y + 2);
+    maxY = std::min(ChunkHeight, std::max(maxY, y + 2));
+}
+
+// The bounds are updated once for the whole span, as storeInto would for its lowest and highest voxels
+void Chunk::fillInto(VoxelStorage& field, int& minY, int& maxY, const int x, const int z, const int yBegin,
+                     const int yEnd, const Voxel v) {
+    if (yBegin >= yEnd) {
+        return;
+    }
+
+    field.fillColumn(x, z, yBegin, yEnd, v);
+    minY = std::min(minY, yBegin);
+    maxY = std::min(ChunkHeight, std::max(maxY, yEnd + 1));
+}
+
+auto Chunk::generate(const GenerationType type, const int cx, const int cy, const int cz,
+                     const NoiseLattice lattice) -> GenerationResult {
+    switch (type) {
+        case GenerationType::Flat:
+            return generateFlat(cy);
+        case GenerationType::Perlin2D:
+            return generateVoxels2D(cx, cy, cz);
+        case GenerationType::Perlin3D:
+            return generateVoxels3D(cx, cy, cz, lattice);
+        case GenerationType::None:
+        default:
+            return {};
+    }
 }
 
-auto Chunk::generateFlat() -> GenerationResult {
+auto Chunk::generateFlat(const int cy) -> GenerationResult {
     GenerationResult result;
 
-    for (int y = 0; y < ChunkHeight; ++y) {
-        for (int z = -1; z < ChunkSize + 1; ++z) {
-            for (int x = -1; x < ChunkSize + 1; ++x) {
-                if (y == ChunkHeight / 2) {
-                    storeInto(result.voxelField, result.minY, result.maxY, x, y, z, 1);
-                } else if (y < ChunkHeight / 2) {
-                    storeInto(result.voxelField, result.minY, result.maxY, x, y, z, 2);
-                }
+    // Height of the grass layer above the bottom of the chunk
+    const int surface = TerrainHeight / 2 - cy * ChunkHeight;
+    if (surface < 0) {
+        return result;
+    }
+
+    // Whole sections below the surface are uniform, so fill them directly rather than voxel by voxel
+    const int uniformSections = std::min(surface >> SectionHeightShift, SectionCount);
+    for (int s = 0; s < uniformSections; ++s) {
+        result.voxelField.fillSection(s, 2);
+    }
+
+    // The rest of each column is stone up to the surface, then a single grass voxel
+    const int stoneBegin = uniformSections << SectionHeightShift;
+    const int stoneEnd = std::min(surface, ChunkHeight);
+    for (int z = 0; z < ChunkSize; ++z) {
+        for (int x = 0; x < ChunkSize; ++x) {
+            fillInto(result.voxelField, result.minY, result.maxY, x, z, stoneBegin, stoneEnd, 2);
+            if (surface < ChunkHeight) {
+                storeInto(result.voxelField, result.minY, result.maxY, x, surface, z, 1);
             }
         }
     }
 
     result.minY = 0;
-    result.maxY = ChunkHeight / 2 + 2;
+    result.maxY = std::min(ChunkHeight, surface + 2);
 
     return result;
 }
 
-double terrainNoise(const int x, const int z) {
-    auto clamp = [](auto v, auto low, auto high) {
-        return std::max(low, std::min(v, high));
-    };
+// Height of the heightmap terrain where its noise is the given value
+int terrainHeight(const double noise) {
+    const int height = static_cast<int>(std::min(noise, 1.0 - Epsilon) * TerrainHeight);
+    return std::min(std::max(0, height), TerrainHeight - 1);
+}
 
-    return clamp(perlin.octave2D_01(x * 0.01, z * 0.01, 1), 0.0, 1.0 - Epsilon);
+// Height of the heightmap terrain of the given shape where its noise is the given value
+int terrainHeight(const TerrainShape& shape, const double noise) {
+    return terrainHeight(shape.height + shape.relief * (noise - 0.5));
 }
 
-auto Chunk::generateVoxels2D(const int cx, const int cz) -> GenerationResult {
-    GenerationResult result;
+// Terrain heights of a heightmap tile, sampled in one batch so the noise is evaluated several columns at a time. With
+// biomes, each column takes the shape blended from the biomes around it.
+void terrainHeights(const NoiseBackend backend, const bool biomes, const int x0, const int z0,
+                    HeightmapCache::Tile& heights) {
+    constexpr size_t Columns = HeightmapCache::TileSize * HeightmapCache::TileSize;
+    thread_local std::array<double, Columns> xs;
+    thread_local std::array<double, Columns> zs;
+    thread_local std::array<double, Columns> noise;
+    for (int z = 0; z < HeightmapCache::TileSize; ++z) {
+        for (int x = 0; x < HeightmapCache::TileSize; ++x) {
+            const int noise_x = x0 + x + 1;
+            const int noise_z = z0 + z + 1;
+            xs[HeightmapCache::getColumnIndex(x, z)] = noise_x * 0.01;
+            zs[HeightmapCache::getColumnIndex(x, z)] = noise_z * 0.01;
+        }
+    }
 
-    int heightMap[ChunkSize + 2][ChunkSize + 2];
-    heightMap[0][0] = static_cast<int>(terrainNoise(cx * ChunkSize, cz * ChunkSize) * ChunkHeight);
+    TerrainNoise::terrain(backend).octave2D_01(xs, zs, noise, 1);
+    if (!biomes) {
+        for (size_t i = 0; i < Columns; ++i) {
+            heights[i] = static_cast<uint16_t>(terrainHeight(noise[i]));
+        }
+        return;
+    }
 
-    for (int z = -1; z < ChunkSize + 1; ++z) {
-        for (int x = -1; x < ChunkSize + 1; ++x) {
-            const int noise_x = cx * ChunkSize + x + 1;
-            const int noise_z = cz * ChunkSize + z + 1;
+    const std::shared_ptr<const ClimateMap::Region> region = ClimateMap::climate(backend).regionAt(x0, z0);
+    for (int z = 0; z < HeightmapCache::TileSize; ++z) {
+        for (int x = 0; x < HeightmapCache::TileSize; ++x) {
+            const size_t i = HeightmapCache::getColumnIndex(x, z);
+            heights[i] = static_cast<uint16_t>(terrainHeight(region->at(x0 + x, z0 + z).shape, noise[i]));
+        }
+    }
+}
 
-            // Calculate adjacent noise values in the +x and +z directions
-            const double noise10 = terrainNoise(noise_x + 1, noise_z);
-            const double noise01 = terrainNoise(noise_x, noise_z + 1);
+// Heights of the given terrain, as a HeightmapCache computes them
+HeightmapCache::Generator terrainHeights(const NoiseBackend backend, const bool biomes) {
+    return [=](const int x0, const int z0, HeightmapCache::Tile& heights) {
+        terrainHeights(backend, biomes, x0, z0, heights);
+    };
+}
 
-            if (x != ChunkSize) {
-                heightMap[x + 2][z + 1] = static_cast<int>(noise10 * ChunkHeight);
-            }
-            if (z != ChunkSize) {
-                heightMap[x + 1][z + 2] = static_cast<int>(noise01 * ChunkHeight);
-            }
+HeightmapCache& Chunk::heightmapCache(const NoiseBackend backend, const bool biomes) {
+    static HeightmapCache perlinCache(terrainHeights(NoiseBackend::Perlin, false));
+    static HeightmapCache simplexCache(terrainHeights(NoiseBackend::Simplex, false));
+    static HeightmapCache perlinBiomeCache(terrainHeights(NoiseBackend::Perlin, true));
+    static HeightmapCache simplexBiomeCache(terrainHeights(NoiseBackend::Simplex, true));
+    if (backend == NoiseBackend::Simplex) {
+        return biomes ? simplexBiomeCache : simplexCache;
+    }
+    return biomes ? perlinBiomeCache : perlinCache;
+}
+
+auto Chunk::generateVoxels2D(const int cx, const int cy, const int cz, const NoiseBackend backend,
+                             const bool biomes) -> GenerationResult {
+    // Heightmap terrain is stored natively as column runs, which are built in O(columns)
+    GenerationResult result(VoxelStorage::Representation::Columns);
+
+    // Every chunk of a column of chunks reads the same heights, so they come from the shared cache
+    const int x0 = cx * ChunkSize;
+    const int z0 = cz * ChunkSize;
+    const std::shared_ptr<const HeightmapCache::Tile> heights = heightmapCache(backend, biomes).tileAt(x0, z0);
+    const std::shared_ptr<const ClimateMap::Region> region =
+        biomes ? ClimateMap::climate(backend).regionAt(x0, z0) : nullptr;
 
-            int y = heightMap[x + 1][z + 1];
-            y = std::min(std::max(0, y), ChunkHeight - 1);
+    const int base = cy * ChunkHeight;
+    for (int z = 0; z < ChunkSize; ++z) {
+        for (int x = 0; x < ChunkSize; ++x) {
+            // Neighbouring chunks are read directly when meshing, so each column only needs its own height
+            const int height = (*heights)[HeightmapCache::getColumnIndex(x0 + x, z0 + z)];
+
+            // Height of the column within this chunk
+            const int y = std::min(std::max(0, height - base), ChunkHeight);
 
             result.minY = std::min(y, result.minY);
             result.maxY = std::max(y, result.maxY);
 
-            // Lowest visible height is the minimum of the current height and the adjacent heights
-            int lowestVisibleHeight = y;
-            if (x != -1) {
-                lowestVisibleHeight = std::min(lowestVisibleHeight, heightMap[x][z + 1]);
-            }
-            if (x != ChunkSize) {
-                lowestVisibleHeight = std::min(lowestVisibleHeight, heightMap[x + 2][z + 1]);
+            if (y == 0) {
+                continue;
             }
-            if (z != -1) {
-                lowestVisibleHeight = std::min(lowestVisibleHeight, heightMap[x + 1][z]);
+
+            // Stone up to the surface with a single grass voxel on top, which may be in the chunk above; with biomes, the
+            // ground and surface voxels of the column's biome instead
+            Voxel ground = 2;
+            Voxel surface = 1;
+            if (region) {
+                const Biome& biome = Biome::nearest(region->at(x0 + x, z0 + z).climate);
+                ground = biome.ground;
+                surface = biome.surface;
             }
-            if (z != ChunkSize) {
-                lowestVisibleHeight = std::min(lowestVisibleHeight, heightMap[x + 1][z + 2]);
+            const int stone = std::min(height - 1 - base, ChunkHeight);
+            std::array<ColumnStorage::Span, 2> spans{};
+            size_t count = 0;
+            if (stone > 0) {
+                spans[count++] = {.type = ground, .length = static_cast<uint16_t>(stone)};
             }
-
-            for (int y0 = 0; y0 < y; ++y0) {
-                int voxelType;
-                if (y0 == y - 1) {
-                    voxelType = 1;
-                } else if (y0 < lowestVisibleHeight) {
-                    voxelType = 2;
-                } else {
-                    voxelType = 2;
-                }
-                storeInto(result.voxelField, result.minY, result.maxY, x, y0, z, voxelType);
+            if (stone < ChunkHeight) {
+                spans[count++] = {.type = surface, .length = 1};
             }
+            result.voxelField.setColumn(x, z, std::span(spans).first(count));
+            result.maxY = std::max(result.maxY, y + 1);
         }
     }
 
@@ -118,31 +212,178 @@ auto Chunk::generateVoxels2D(const int cx, const int cz) -> GenerationResult {
     return result;
 }
 
-auto Chunk::generateVoxels3D(const int cx, const int cz) -> GenerationResult {
+auto Chunk::generateVoxels3D(const int cx, const int cy, const int cz, const NoiseLattice lattice,
+                             const NoiseBackend backend) -> GenerationResult {
     GenerationResult result;
 
-    for (int y = -1; y < ChunkHeight + 1; ++y) {
-        for (int z = -1; z < ChunkSize + 1; ++z) {
-            for (int x = -1; x < ChunkSize + 1; ++x) {
-                const auto noise_x = static_cast<float>(cx * ChunkSize + x + 1);
-                const auto noise_y = static_cast<float>(y + 1);
-                const auto noise_z = static_cast<float>(cz * ChunkSize + z + 1);
-
-                if (const double noise = perlin.octave3D_01(noise_x * 0.01, noise_y * 0.01, noise_z * 0.01, 4); noise > 0.5) {
-                    storeInto(result.voxelField, result.minY, result.maxY, x, y, z, 1);
-                    result.minY = std::min(y, result.minY);
-                    result.maxY = std::max(y, result.maxY);
-                }
+    const int base = cy * ChunkHeight;
+    const int top = std::min(ChunkHeight, TerrainHeight - base);
+    if (top <= 0) {
+        return result;
+    }
+
+    LatticeNoise noise(TerrainNoise::terrain(backend), cx, cy, cz, top, lattice);
+
+    // Visit each section in storage order, so consecutive stores land in the same packed words
+    for (int sectionBase = 0; sectionBase < top; sectionBase += SectionHeight) {
+        const int sectionTop = std::min(top - sectionBase, SectionHeight);
+        const std::span<const double> density = noise.section(sectionBase);
+
+        SectionLayout::forEach([&](const size_t x, const size_t ly, const size_t z) {
+            if (static_cast<int>(ly) < sectionTop && density[LatticeNoise::getIndex(x, ly, z)] > 0.5) {
+                const int y = sectionBase + static_cast<int>(ly);
+                storeInto(result.voxelField, result.minY, result.maxY, static_cast<int>(x), y, static_cast<int>(z), 1);
+                result.minY = std::min(y, result.minY);
+                result.maxY = std::max(y, result.maxY);
             }
-        }
+        });
     }
 
+    result.voxelField.compact();
+
     result.minY = std::max(0, result.minY - 1);
     result.maxY = std::min(ChunkHeight, result.maxY + 2);
 
     return result;
 }
 
+auto Chunk::generateLod(const GenerationType type, const int cx, const int cy, const int cz, const int lod,
+                        const NoiseBackend backend, const bool biomes) -> GenerationResult {
+    if (lod == 0) {
+        switch (type) {
+            case GenerationType::Perlin2D:
+                return generateVoxels2D(cx, cy, cz, backend, biomes);
+            case GenerationType::Perlin3D:
+                return generateVoxels3D(cx, cy, cz, {}, backend);
+            default:
+                return generate(type, cx, cy, cz);
+        }
+    }
+
+    const TerrainNoise& terrain = TerrainNoise::terrain(backend);
+
+    const int scale = 1 << lod;
+    const int size = ChunkSize >> lod;
+    const int height = ChunkHeight >> lod;
+    const int base = cy * ChunkHeight;
+    const int top = std::min(ChunkHeight, TerrainHeight - base);
+
+    GenerationResult result(type == GenerationType::Perlin3D ? VoxelStorage::Representation::Sections
+                                                             : VoxelStorage::Representation::Columns);
+    result.lod = lod;
+    if (top <= 0 || type == GenerationType::None) {
+        return result;
+    }
+
+    if (type == GenerationType::Perlin3D) {
+        // Samples below the top of the terrain, at the same noise coordinates as LatticeNoise
+        const int rows = (top + scale - 1) >> lod;
+        const size_t points = static_cast<size_t>(size) * size * rows;
+        thread_local std::vector<double> xs;
+        thread_local std::vector<double> ys;
+        thread_local std::vector<double> zs;
+        thread_local std::vector<double> noise;
+        xs.resize(points);
+        ys.resize(points);
+        zs.resize(points);
+        noise.resize(points);
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                for (int y = 0; y < rows; ++y) {
+                    const size_t i = static_cast<size_t>((z * size + x) * rows + y);
+                    xs[i] = static_cast<float>(cx * ChunkSize + x * scale + 1) * 0.01;
+                    ys[i] = static_cast<float>(base + y * scale + 1) * 0.01;
+                    zs[i] = static_cast<float>(cz * ChunkSize + z * scale + 1) * 0.01;
+                }
+            }
+        }
+        terrain.octave3D_01(xs, ys, zs, noise, 4);
+
+        for (int y = 0; y < rows; ++y) {
+            for (int z = 0; z < size; ++z) {
+                for (int x = 0; x < size; ++x) {
+                    if (noise[static_cast<size_t>((z * size + x) * rows + y)] > 0.5) {
+                        storeInto(result.voxelField, result.minY, result.maxY, x, y, z, 1);
+                    }
+                }
+            }
+        }
+
+        result.voxelField.compact();
+        result.minY = std::max(0, result.minY - 1);
+        result.maxY = std::min(height, result.maxY);
+        return result;
+    }
+
+    // Heights of the sampled columns, from the same noise as terrainHeights
+    thread_local std::vector<double> xs;
+    thread_local std::vector<double> zs;
+    thread_local std::vector<double> noise;
+    const size_t columns = static_cast<size_t>(size) * size;
+    if (type == GenerationType::Perlin2D) {
+        xs.resize(columns);
+        zs.resize(columns);
+        noise.resize(columns);
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                xs[z * size + x] = (cx * ChunkSize + x * scale + 1) * 0.01;
+                zs[z * size + x] = (cz * ChunkSize + z * scale + 1) * 0.01;
+            }
+        }
+        terrain.octave2D_01(xs, zs, noise, 1);
+    }
+
+    // Biomes shape the columns and pick their voxels as in generateVoxels2D
+    const std::shared_ptr<const ClimateMap::Region> region = biomes && type == GenerationType::Perlin2D
+        ? ClimateMap::climate(backend).regionAt(cx * ChunkSize, cz * ChunkSize)
+        : nullptr;
+
+    int lowest = height;
+    int highest = 0;
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            Voxel ground = 2;
+            Voxel surface = 1;
+            int grass = TerrainHeight / 2;
+            if (region) {
+                const ClimateMap::Sample sample = region->at(cx * ChunkSize + x * scale, cz * ChunkSize + z * scale);
+                const Biome& biome = Biome::nearest(sample.climate);
+                ground = biome.ground;
+                surface = biome.surface;
+                grass = terrainHeight(sample.shape, noise[z * size + x]) - 1;
+            } else if (type == GenerationType::Perlin2D) {
+                grass = terrainHeight(noise[z * size + x]) - 1;
+            }
+
+            // Top of the column above the bottom of the chunk, grass included
+            const int local = grass + 1 - base;
+
+            // Voxels sampled below the top are solid, and the highest is grass if the grass is in this chunk
+            const int y = std::min(std::max(0, (local + scale - 1) >> lod), height);
+            lowest = std::min(lowest, y);
+            highest = std::max(highest, y);
+            if (y == 0) {
+                continue;
+            }
+
+            const int stone = local <= ChunkHeight ? y - 1 : y;
+            std::array<ColumnStorage::Span, 2> spans{};
+            size_t count = 0;
+            if (stone > 0) {
+                spans[count++] = {.type = ground, .length = static_cast<uint16_t>(stone)};
+            }
+            if (stone < y) {
+                spans[count++] = {.type = surface, .length = 1};
+            }
+            result.voxelField.setColumn(x, z, std::span(spans).first(count));
+        }
+    }
+
+    result.minY = std::max(0, lowest - 1);
+    result.maxY = std::min(height, highest + 1);
+    return result;
+}
+
 size_t Chunk::getVoxelIndex(const size_t x, const size_t y, const size_t z) {
-    return y * (ChunkSize + 2) * (ChunkSize + 2) + z * (ChunkSize + 2) + x;
+    return (y >> SectionHeightShift) * SectionVolume + VoxelStorage::getSectionIndex(x, y & (SectionHeight - 1), z);
 }
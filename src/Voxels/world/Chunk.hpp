@@ -1,15 +1,19 @@
 #pragma once
 
 #include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <vector>
 
-constexpr int ChunkSizeShift = 4;
-constexpr int ChunkHeightShift = 7;
-constexpr int ChunkSize = 1 << ChunkSizeShift;
-constexpr int ChunkHeight = 1 << ChunkHeightShift;
+#include "ChunkConstants.hpp"
+#include "HeightmapCache.hpp"
+#include "SharedVoxels.hpp"
+#include "VoxelStorage.hpp"
 
-constexpr int VoxelsSize = (ChunkSize + 2) * (ChunkSize + 2) * ChunkHeight;
+// Seeds the noise every terrain generator samples
+constexpr unsigned int TerrainSeed = 123456u;
 
 enum class GenerationType {
     None,
@@ -18,18 +22,53 @@ enum class GenerationType {
     Perlin3D
 };
 
-constexpr int EmptyVoxel = 0;
+// The noise the heightmap and density terrain are sampled from (see TerrainNoise). GenerationType's terrain is Perlin.
+enum class NoiseBackend {
+    Perlin,
+    Simplex
+};
+
+// Spacing in voxels of the lattice generateVoxels3D samples its noise on, interpolating trilinearly in between. The
+// lattice is aligned to world coordinates, so neighbouring chunks agree along their shared faces. A step of 1 in both
+// directions samples every voxel.
+struct NoiseLattice {
+    int horizontal = 4;
+    int vertical = 8;
+
+    static constexpr NoiseLattice exact() { return {1, 1}; }
+
+    // Steps must be powers of two no wider than a chunk, nor taller than a section
+    [[nodiscard]] constexpr bool isValid() const {
+        return std::has_single_bit(static_cast<unsigned>(horizontal)) && horizontal <= ChunkSize &&
+               std::has_single_bit(static_cast<unsigned>(vertical)) && vertical <= SectionHeight;
+    }
+};
+
+// Distant chunks are generated at a coarser level of detail. At level lod a chunk holds one voxel per cube of 2^lod
+// voxels along each axis, sampled at the cube's lowest corner, in the lowest (ChunkSize >> lod) x (ChunkHeight >> lod)
+// x (ChunkSize >> lod) corner of its storage. Level 0 is full resolution.
+constexpr int MaxLod = 3;
+static_assert(MaxLod <= ChunkSizeShift && MaxLod <= ChunkHeightShift, "Every level of detail needs a voxel per chunk");
 
 class Chunk {
 public:
     struct GenerationResult {
         std::shared_ptr<Chunk> chunk;
-        std::vector<int> voxelField = std::vector(VoxelsSize, 0);
+        VoxelStorage voxelField{};
         int minY{};
         int maxY{};
+        int lod = 0;
+
+        // Results are handed from the generation threads to the main thread, so never copy the voxels
+        GenerationResult() = default;
+        explicit GenerationResult(const VoxelStorage::Representation representation) : voxelField(representation) {}
+        GenerationResult(const GenerationResult&) = delete;
+        GenerationResult(GenerationResult&&) noexcept = default;
+        GenerationResult& operator=(const GenerationResult&) = delete;
+        GenerationResult& operator=(GenerationResult&&) noexcept = default;
     };
 
-    Chunk(int cx, int cz);
+    Chunk(int cx, int cy, int cz);
 
     Chunk(const Chunk& chunk) = delete;                // Copy constructor
     Chunk(Chunk&& other) noexcept = delete;            // Move constructor
@@ -37,8 +76,9 @@ public:
     Chunk& operator=(Chunk&& other) noexcept = delete; // Move assignment operator
 
     int cx;
+    int cy;
     int cz;
-    int minY = ChunkHeight;
+    int minY = ChunkHeight;  // Local to the chunk, like every y of its voxels
     int maxY = 0;
 
     int neighbours = 0;
@@ -50,17 +90,41 @@ public:
 
     std::atomic_bool bufferRegionAllocated = false;
     std::atomic_bool destroyed = false;
+    bool generated = false;  // Main thread only; set once the generated voxels have been stored
+    uint64_t meshRequests = 0;  // Main thread only; mesh jobs queued so far, numbering each from 1
+    uint64_t meshedRequest = 0;  // Main thread only; the job whose mesh is uploaded
+    int lod = 0;  // Main thread only; level of detail of the voxels, so their y bounds are in units of 2^lod voxels
+    int targetLod = 0;  // Main thread only; level of detail last asked of the generator
+    bool inView = false;  // Main thread only; in the view frustum as of the last WorldManager::updateVisibility
     int debug = 0;
 
-    std::vector<int> voxels{};
-    void store(int x, int y, int z, int v);
-    int load(int x, int y, int z) const;
-
-    static void storeInto(std::vector<int>& field, int& minY, int& maxY, int x, int y, int z, int v);  // TODO: maybe a better way to do this
-
-    static GenerationResult generateFlat();
-    static GenerationResult generateVoxels2D(int cx, int cz);
-    static GenerationResult generateVoxels3D(int cx, int cz);
+    SharedVoxels voxels;
+    // Writes take coordinates at the chunk's own level of detail; reads take them at full resolution, and a coarser
+    // chunk answers with the voxel sampled for the cube containing them
+    void store(int x, int y, int z, Voxel v);
+    void fill(int x, int z, int yBegin, int yEnd, Voxel v);  // [yBegin, yEnd) of column (x, z)
+    Voxel load(int x, int y, int z) const;
+    bool isSolid(const int x, const int y, const int z) const { return voxels->isSolid(x >> lod, y >> lod, z >> lod); }
+
+    static void storeInto(VoxelStorage& field, int& minY, int& maxY, int x, int y, int z, Voxel v);  // TODO: maybe a better way to do this
+    static void fillInto(VoxelStorage& field, int& minY, int& maxY, int x, int z, int yBegin, int yEnd, Voxel v);
+
+    // Chunk rows at or above TerrainChunkRows are always empty, so are never generated
+    static GenerationResult generate(GenerationType type, int cx, int cy, int cz, NoiseLattice lattice = {});
+    static GenerationResult generateFlat(int cy);
+    // With biomes, the shape of the terrain and the voxels of each column follow the climate there (see ClimateMap)
+    static GenerationResult generateVoxels2D(int cx, int cy, int cz, NoiseBackend backend = NoiseBackend::Perlin,
+                                             bool biomes = false);
+    static GenerationResult generateVoxels3D(int cx, int cy, int cz, NoiseLattice lattice = {},
+                                             NoiseBackend backend = NoiseBackend::Perlin);
+
+    // The terrain of generate at the given level of detail, sampled directly from the noise rather than downsampled
+    // from the full resolution voxels
+    static GenerationResult generateLod(GenerationType type, int cx, int cy, int cz, int lod,
+                                        NoiseBackend backend = NoiseBackend::Perlin, bool biomes = false);
+
+    // Terrain heights for generateVoxels2D from each noise, with and without biomes, shared by every generation thread
+    static HeightmapCache& heightmapCache(NoiseBackend backend = NoiseBackend::Perlin, bool biomes = false);
 
     static size_t getVoxelIndex(size_t x, size_t y, size_t z);
 };
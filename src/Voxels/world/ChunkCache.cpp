@@ -0,0 +1,64 @@
+#include "ChunkCache.hpp"
+
+#include <iterator>
+#include <utility>
+
+ChunkCache::ChunkCache(const size_t maxBytes)
+    : maxBytes(maxBytes)
+{}
+
+void ChunkCache::insert(const glm::ivec3& coords, Entry entry) {
+    erase(coords);
+
+    const size_t bytes = entryBytes(entry);
+    nodes.push_front({coords, std::move(entry), bytes});
+    nodeByCoords[coords] = nodes.begin();
+    ++stats.entries;
+    stats.bytes += bytes;
+
+    while (stats.bytes > maxBytes && !nodes.empty()) {
+        remove(std::prev(nodes.end()));
+        ++stats.evictions;
+    }
+}
+
+std::optional<ChunkCache::Entry> ChunkCache::take(const glm::ivec3& coords) {
+    const auto it = nodeByCoords.find(coords);
+    if (it == nodeByCoords.end()) {
+        ++stats.misses;
+        return std::nullopt;
+    }
+
+    ++stats.hits;
+    Entry entry = std::move(it->second->entry);
+    remove(it->second);
+    return entry;
+}
+
+void ChunkCache::erase(const glm::ivec3& coords) {
+    if (const auto it = nodeByCoords.find(coords); it != nodeByCoords.end()) {
+        remove(it->second);
+    }
+}
+
+void ChunkCache::clear() {
+    nodes.clear();
+    nodeByCoords.clear();
+    stats.entries = 0;
+    stats.bytes = 0;
+}
+
+size_t ChunkCache::entryBytes(const Entry& entry) {
+    // Uniform chunks share their voxels with every other chunk of the same type
+    if (entry.voxels->uniformValue()) {
+        return sizeof(Node);
+    }
+    return sizeof(Node) + entry.voxels->memoryUsage();
+}
+
+void ChunkCache::remove(const std::list<Node>::iterator it) {
+    --stats.entries;
+    stats.bytes -= it->bytes;
+    nodeByCoords.erase(it->coords);
+    nodes.erase(it);
+}
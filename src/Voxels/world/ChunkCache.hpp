@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "Primitive.hpp"
+#include "SharedVoxels.hpp"
+
+struct ChunkCacheStats {
+    size_t hits = 0;       // Calls to take that found the chunk
+    size_t misses = 0;     // Calls to take that didn't, so the chunk had to be generated
+    size_t evictions = 0;  // Chunks dropped to stay within the budget
+    size_t entries = 0;    // Chunks currently cached
+    size_t bytes = 0;
+};
+
+// Least recently used cache of the voxels of chunks that were unloaded, so walking back over ground that was streamed
+// out restores its chunks instead of generating them again. The voxels are kept as the snapshot the chunk last had,
+// which is already palette and run-length compressed, and chunks of a single voxel type share their voxels, so they
+// cost next to nothing. Not thread-safe: only the main thread streams chunks.
+class ChunkCache {
+public:
+    struct Entry {
+        SharedVoxels::Snapshot voxels;
+        int minY;
+        int maxY;
+    };
+
+    explicit ChunkCache(size_t maxBytes = size_t{128} << 20);
+
+    // Adds or replaces the chunk at coords, evicting the least recently used chunks while over the budget
+    void insert(const glm::ivec3& coords, Entry entry);
+
+    // Removes and returns the chunk at coords, if it's cached
+    [[nodiscard]] std::optional<Entry> take(const glm::ivec3& coords);
+
+    // Drops the chunk at coords, for when its cached voxels no longer match what it would generate with
+    void erase(const glm::ivec3& coords);
+    void clear();
+
+    [[nodiscard]] const ChunkCacheStats& getStats() const { return stats; }
+
+private:
+    struct Node {
+        glm::ivec3 coords;
+        Entry entry;
+        size_t bytes;
+    };
+
+    static size_t entryBytes(const Entry& entry);
+    void remove(std::list<Node>::iterator it);
+
+    size_t maxBytes;
+    std::list<Node> nodes;  // Most recently inserted first
+    std::unordered_map<glm::ivec3, std::list<Node>::iterator, IVec3Hash> nodeByCoords;
+    ChunkCacheStats stats;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// Integer type used to store a single voxel, selected with the VOXELS_VOXEL_TYPE build option
+#ifndef VOXELS_VOXEL_TYPE
+#define VOXELS_VOXEL_TYPE uint8_t
+#endif
+
+using Voxel = VOXELS_VOXEL_TYPE;
+static_assert(std::is_integral_v<Voxel> && std::is_unsigned_v<Voxel>, "Voxel must be an unsigned integer type");
+
+// Chunk dimensions as powers of two, selected with the VOXELS_CHUNK_SIZE_SHIFT and VOXELS_CHUNK_HEIGHT_SHIFT build
+// options
+#ifndef VOXELS_CHUNK_SIZE_SHIFT
+#define VOXELS_CHUNK_SIZE_SHIFT 4
+#endif
+#ifndef VOXELS_CHUNK_HEIGHT_SHIFT
+#define VOXELS_CHUNK_HEIGHT_SHIFT 7
+#endif
+
+constexpr int ChunkSizeShift = VOXELS_CHUNK_SIZE_SHIFT;
+constexpr int ChunkHeightShift = VOXELS_CHUNK_HEIGHT_SHIFT;
+static_assert(4 <= ChunkSizeShift && ChunkSizeShift <= 6, "Chunks must be 16, 32 or 64 voxels wide");
+static_assert(4 <= ChunkHeightShift && ChunkHeightShift <= 8, "Chunks must be 16 to 256 voxels tall");
+constexpr int ChunkSize = 1 << ChunkSizeShift;
+constexpr int ChunkHeight = 1 << ChunkHeightShift;
+
+constexpr int VoxelsSize = ChunkSize * ChunkSize * ChunkHeight;
+
+// Chunks are stacked vertically, so the world is as tall as WorldHeight however tall each chunk is. The world starts at
+// y = 0; everything below it is solid.
+constexpr int WorldHeightShift = 12;
+constexpr int WorldHeight = 1 << WorldHeightShift;
+constexpr int WorldChunkRows = WorldHeight >> ChunkHeightShift;
+
+// The generators only produce terrain below TerrainHeight, so chunks above TerrainChunkRows are empty sky
+constexpr int TerrainHeight = 128;
+constexpr int TerrainChunkRows = (TerrainHeight + ChunkHeight - 1) >> ChunkHeightShift;
+
+// Chunks are split vertically into sections, each covering the full ChunkSize^2 footprint
+constexpr int SectionHeightShift = 4;
+constexpr int SectionHeight = 1 << SectionHeightShift;
+constexpr int SectionCount = ChunkHeight / SectionHeight;
+constexpr int SectionVolume = ChunkSize * ChunkSize * SectionHeight;
+
+constexpr Voxel EmptyVoxel = 0;
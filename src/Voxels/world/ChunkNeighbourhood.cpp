@@ -0,0 +1,46 @@
+#include "ChunkNeighbourhood.hpp"
+
+#include <utility>
+
+ChunkNeighbourhood::ChunkNeighbourhood(Snapshot centre, const bool floor)
+    : floor(floor)
+{
+    chunks[CentreIndex] = std::move(centre);
+}
+
+void ChunkNeighbourhood::setNeighbour(const int dx, const int dy, const int dz, Snapshot voxels) {
+    chunks[getNeighbourIndex(dx, dy, dz)] = std::move(voxels);
+}
+
+bool ChunkNeighbourhood::isLayerEnclosed(const int y) const {
+    const VoxelStorage& voxels = centre();
+    if (!voxels.isLayerSolid(y)) {
+        return false;
+    }
+
+    // The layers above and below may be in the chunks above and below
+    const auto isLayerSolid = [this, &voxels](const int layer) {
+        if (layer < 0) {
+            const VoxelStorage* below = neighbour(0, -1, 0);
+            return floor || (below && below->isLayerSolid(ChunkHeight - 1));
+        }
+        if (layer >= ChunkHeight) {
+            const VoxelStorage* above = neighbour(0, 1, 0);
+            return above && above->isLayerSolid(0);
+        }
+        return voxels.isLayerSolid(layer);
+    };
+    if (!isLayerSolid(y + 1) || !isLayerSolid(y - 1)) {
+        return false;
+    }
+
+    // Only the side neighbours share faces with the layer
+    for (const auto& [dx, dz] : {std::pair{-1, 0}, {1, 0}, {0, -1}, {0, 1}}) {
+        const VoxelStorage* other = neighbour(dx, 0, dz);
+        if (!other || !other->isLayerSolid(y)) {
+            return false;
+        }
+    }
+
+    return true;
+}
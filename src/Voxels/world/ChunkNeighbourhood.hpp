@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "ChunkConstants.hpp"
+#include "SharedVoxels.hpp"
+#include "VoxelStorage.hpp"
+
+// Read-only view of a chunk's voxels together with the 26 chunks around it, so that meshing can look one voxel past
+// the chunk's borders without the chunk having to store a halo. Neighbours that have not been generated read as empty.
+//
+// A chunk in the bottom row of the world sits on its floor: the voxels below it are solid for face culling, but (as
+// there is nothing there to see) don't occlude anything.
+class ChunkNeighbourhood {
+public:
+    using Snapshot = SharedVoxels::Snapshot;
+
+    explicit ChunkNeighbourhood(Snapshot centre, bool floor = false);
+
+    // dx, dy and dz are in [-1, 1]
+    void setNeighbour(int dx, int dy, int dz, Snapshot voxels);
+    [[nodiscard]] const VoxelStorage* neighbour(int dx, int dy, int dz) const {
+        return chunks[getNeighbourIndex(dx, dy, dz)].get();
+    }
+
+    [[nodiscard]] const VoxelStorage& centre() const { return *chunks[CentreIndex]; }
+    [[nodiscard]] bool onFloor() const { return floor; }
+
+    // x and z are in [-1, ChunkSize] and y is in [-1, ChunkHeight], i.e. up to one voxel into the neighbouring chunks
+    [[nodiscard]] Voxel load(const int x, const int y, const int z) const {
+        if (isInCentre(x, y, z)) {
+            return chunks[CentreIndex]->load(x, y, z);
+        }
+
+        const VoxelStorage* voxels = neighbourContaining(x, y, z);
+        return voxels ? voxels->load(x & (ChunkSize - 1), y & (ChunkHeight - 1), z & (ChunkSize - 1)) : EmptyVoxel;
+    }
+
+    [[nodiscard]] bool isSolid(const int x, const int y, const int z) const {
+        if (isInCentre(x, y, z)) {
+            return chunks[CentreIndex]->isSolid(x, y, z);
+        }
+        if (y < 0 && floor) {
+            return true;
+        }
+
+        const VoxelStorage* voxels = neighbourContaining(x, y, z);
+        return voxels && voxels->isSolid(x & (ChunkSize - 1), y & (ChunkHeight - 1), z & (ChunkSize - 1));
+    }
+
+    // Occupancy of column (x, z) of the chunk's own row, with the same range as load
+    [[nodiscard]] OccupancyMask::Column column(const int x, const int z) const {
+        const VoxelStorage* voxels = neighbour(offset(x, ChunkSize), 0, offset(z, ChunkSize));
+        return voxels ? voxels->occupancy().column(x & (ChunkSize - 1), z & (ChunkSize - 1)) : OccupancyMask::Column{};
+    }
+
+    // True if every voxel in layer y and every voxel next to it is solid, so nothing in the layer can have a visible
+    // face
+    [[nodiscard]] bool isLayerEnclosed(int y) const;
+
+private:
+    static constexpr int CentreIndex = 13;
+
+    static int getNeighbourIndex(const int dx, const int dy, const int dz) {
+        return (dy + 1) * 9 + (dz + 1) * 3 + dx + 1;
+    }
+
+    // Which chunk along an axis of the given size the coordinate falls in, from -1 to 1
+    static int offset(const int v, const int size) {
+        return (v >= size) - (v < 0);
+    }
+
+    static bool isInCentre(const int x, const int y, const int z) {
+        return static_cast<unsigned int>(x) < ChunkSize && static_cast<unsigned int>(y) < ChunkHeight &&
+               static_cast<unsigned int>(z) < ChunkSize;
+    }
+
+    [[nodiscard]] const VoxelStorage* neighbourContaining(const int x, const int y, const int z) const {
+        return neighbour(offset(x, ChunkSize), offset(y, ChunkHeight), offset(z, ChunkSize));
+    }
+
+    std::array<Snapshot, 27> chunks;
+    bool floor;
+};
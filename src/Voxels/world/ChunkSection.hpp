@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ChunkConstants.hpp"
+
+// Vertex sub-range and bounding box of the mesh of one section of a chunk. The mesher groups a chunk's vertices by
+// section, so drawcmd_comp.glsl can cull and draw each section on its own rather than the chunk's whole column.
+struct ChunkSection {
+    uint32_t firstVertex;  // Relative to the chunk's first vertex
+    uint32_t numVertices;
+    uint32_t boundsMin;    // Local voxel coordinates packed by packBounds; the box covers [boundsMin, boundsMax)
+    uint32_t boundsMax;
+
+    // x and z take 8 bits each and y the upper 16, so the exclusive maximum of a full chunk fits
+    static constexpr uint32_t packBounds(const int x, const int y, const int z) {
+        return static_cast<uint32_t>(x) | static_cast<uint32_t>(z) << 8 | static_cast<uint32_t>(y) << 16;
+    }
+    static constexpr int boundsX(const uint32_t bounds) { return static_cast<int>(bounds & 0xff); }
+    static constexpr int boundsY(const uint32_t bounds) { return static_cast<int>(bounds >> 16); }
+    static constexpr int boundsZ(const uint32_t bounds) { return static_cast<int>(bounds >> 8 & 0xff); }
+};
+static_assert(sizeof(ChunkSection) == 16, "ChunkSection must match the std430 ChunkSection struct in the shaders");
+static_assert(ChunkSize < 256 && ChunkHeight < 65536, "Chunk bounds must fit ChunkSection::packBounds");
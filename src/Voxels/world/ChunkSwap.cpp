@@ -0,0 +1,236 @@
+#include "ChunkSwap.hpp"
+
+#include <cstring>
+#include <utility>
+
+#include "tracy/Tracy.hpp"
+
+namespace {
+    template<typename T>
+    void put(std::vector<std::byte>& bytes, const T& value) {
+        const size_t offset = bytes.size();
+        bytes.resize(offset + sizeof(T));
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    // Returns false rather than reading past the end of bytes
+    template<typename T>
+    bool get(const std::span<const std::byte> bytes, size_t& offset, T& value) {
+        if (bytes.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    // Sections are either a single voxel type or runs of voxels in SectionLayout order
+    enum class SectionEncoding : uint8_t {
+        Uniform,
+        Runs
+    };
+}
+
+ChunkSwap::ChunkSwap(std::filesystem::path path)
+    : path(std::move(path))
+{}
+
+bool ChunkSwap::store(const glm::ivec3& coords, const VoxelStorage& voxels, const int minY, const int maxY) {
+    ZoneScoped;
+
+    erase(coords);
+    if (!file.isOpen() && !openFile()) {
+        return false;
+    }
+
+    buffer.clear();
+    encode(voxels, buffer);
+
+    const Region region = allocator.allocate(buffer.size());
+    // Growing the file can fail, which leaves it unmapped with every chunk in it lost. Opening it again would truncate
+    // it, so the records are dropped along with it, and those chunks are generated again with their edits replayed.
+    if (!file.isOpen()) {
+        clear();
+        return false;
+    }
+    if (region.offset + region.length > file.size()) {
+        allocator.deallocate(region.offset, region.length);
+        return false;
+    }
+
+    std::memcpy(file.data() + region.offset, buffer.data(), buffer.size());
+    records[coords] = {region, buffer.size(), minY, maxY};
+
+    ++stats.stores;
+    ++stats.entries;
+    stats.bytes += buffer.size();
+    return true;
+}
+
+std::optional<ChunkCache::Entry> ChunkSwap::take(const glm::ivec3& coords) {
+    ZoneScoped;
+
+    const auto it = records.find(coords);
+    if (it == records.end() || !file.isOpen()) {
+        return std::nullopt;
+    }
+
+    const Record& record = it->second;
+    std::optional<VoxelStorage> voxels = decode({file.data() + record.region.offset, record.size});
+    const int minY = record.minY;
+    const int maxY = record.maxY;
+    erase(coords);
+    if (!voxels) {
+        return std::nullopt;
+    }
+    ++stats.loads;
+    return ChunkCache::Entry{std::make_shared<const VoxelStorage>(std::move(*voxels)), minY, maxY};
+}
+
+void ChunkSwap::erase(const glm::ivec3& coords) {
+    const auto it = records.find(coords);
+    if (it == records.end()) {
+        return;
+    }
+
+    allocator.deallocate(it->second.region.offset, it->second.region.length);
+    --stats.entries;
+    stats.bytes -= it->second.size;
+    records.erase(it);
+}
+
+void ChunkSwap::clear() {
+    records.clear();
+    file.close();
+    stats.entries = 0;
+    stats.bytes = 0;
+    stats.fileBytes = 0;
+}
+
+bool ChunkSwap::openFile() {
+    if (!file.open(path, InitialFileSize)) {
+        return false;
+    }
+
+    allocator = FreeListAllocator(InitialFileSize, Alignment, [this](const size_t capacity) {
+        const size_t newCapacity = capacity * 2;
+        file.resize(newCapacity);
+        stats.fileBytes = file.size();
+        return newCapacity;
+    });
+    stats.fileBytes = file.size();
+    return true;
+}
+
+void ChunkSwap::encode(const VoxelStorage& voxels, std::vector<std::byte>& bytes) {
+    put(bytes, voxels.getRepresentation());
+
+    if (voxels.getRepresentation() == VoxelStorage::Representation::Columns) {
+        for (size_t z = 0; z < ChunkSize; ++z) {
+            for (size_t x = 0; x < ChunkSize; ++x) {
+                const std::span<const ColumnStorage::Span> column = voxels.columns().column(x, z);
+                put(bytes, static_cast<uint16_t>(column.size()));
+                for (const auto& [type, length] : column) {
+                    put(bytes, type);
+                    put(bytes, length);
+                }
+            }
+        }
+        return;
+    }
+
+    for (size_t section = 0; section < SectionCount; ++section) {
+        const size_t y0 = section << SectionHeightShift;
+        if (voxels.sectionState(section) != VoxelStorage::SectionState::Dense) {
+            put(bytes, SectionEncoding::Uniform);
+            put(bytes, voxels.load(0, y0, 0));
+            continue;
+        }
+
+        put(bytes, SectionEncoding::Runs);
+        Voxel run = voxels.load(0, y0, 0);
+        uint32_t length = 0;
+        SectionLayout::forEach([&](const size_t x, const size_t y, const size_t z) {
+            const Voxel v = voxels.load(x, y0 + y, z);
+            if (v != run) {
+                put(bytes, run);
+                put(bytes, length);
+                run = v;
+                length = 0;
+            }
+            ++length;
+        });
+        put(bytes, run);
+        put(bytes, length);
+    }
+}
+
+std::optional<VoxelStorage> ChunkSwap::decode(const std::span<const std::byte> bytes) {
+    size_t offset = 0;
+    VoxelStorage::Representation representation{};
+    if (!get(bytes, offset, representation) || (representation != VoxelStorage::Representation::Sections &&
+                                                representation != VoxelStorage::Representation::Columns)) {
+        return std::nullopt;
+    }
+    VoxelStorage voxels(representation);
+
+    if (representation == VoxelStorage::Representation::Columns) {
+        std::vector<ColumnStorage::Span> column;
+        for (size_t z = 0; z < ChunkSize; ++z) {
+            for (size_t x = 0; x < ChunkSize; ++x) {
+                uint16_t count = 0;
+                if (!get(bytes, offset, count) || count > ColumnStorage::MaxSpans) {
+                    return std::nullopt;
+                }
+                column.resize(count);
+                size_t height = 0;
+                for (ColumnStorage::Span& span : column) {
+                    if (!get(bytes, offset, span.type) || !get(bytes, offset, span.length) || span.length == 0) {
+                        return std::nullopt;
+                    }
+                    height += span.length;
+                }
+                // Anything above the last span is empty, so the spans needn't reach the top
+                if (height > ChunkHeight) {
+                    return std::nullopt;
+                }
+                voxels.setColumn(x, z, column);
+            }
+        }
+        return offset == bytes.size() ? std::optional(std::move(voxels)) : std::nullopt;
+    }
+
+    for (size_t section = 0; section < SectionCount; ++section) {
+        SectionEncoding encoding{};
+        if (!get(bytes, offset, encoding) ||
+            (encoding != SectionEncoding::Uniform && encoding != SectionEncoding::Runs)) {
+            return std::nullopt;
+        }
+
+        if (encoding == SectionEncoding::Uniform) {
+            Voxel v{};
+            if (!get(bytes, offset, v)) {
+                return std::nullopt;
+            }
+            if (v != EmptyVoxel) {
+                voxels.fillSection(section, v);
+            }
+            continue;
+        }
+
+        // Runs are in SectionLayout order, so each fills a range of the section's indices
+        for (size_t index = 0; index < SectionVolume;) {
+            Voxel run{};
+            uint32_t length = 0;
+            if (!get(bytes, offset, run) || !get(bytes, offset, length) || length == 0 ||
+                length > SectionVolume - index) {
+                return std::nullopt;
+            }
+            if (run != EmptyVoxel) {
+                voxels.fillSectionRange(section, index, index + length, run);
+            }
+            index += length;
+        }
+    }
+    return offset == bytes.size() ? std::optional(std::move(voxels)) : std::nullopt;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ChunkCache.hpp"
+#include "Primitive.hpp"
+#include "VoxelStorage.hpp"
+#include "../core/FreeListAllocator.hpp"
+#include "../core/MappedFile.hpp"
+
+struct ChunkSwapStats {
+    size_t stores = 0;     // Chunks written out
+    size_t loads = 0;      // Chunks read back in
+    size_t entries = 0;    // Chunks currently swapped out
+    size_t bytes = 0;      // Encoded size of the swapped out chunks
+    size_t fileBytes = 0;  // Size of the swap file
+};
+
+// Swap space for the voxels of edited chunks that have left the render distance, so they can be paged back in as they
+// were rather than generated again with every edit replayed on top. Each chunk is run-length encoded into a region of a
+// memory-mapped file; the file is created on the first store and deleted when the swap is cleared or destroyed. Not
+// thread-safe: only the main thread streams chunks.
+class ChunkSwap {
+public:
+    explicit ChunkSwap(std::filesystem::path path);
+
+    ChunkSwap(const ChunkSwap&) = delete;
+    ChunkSwap& operator=(const ChunkSwap&) = delete;
+
+    // Writes out the chunk at coords, replacing any earlier copy. Returns false if the swap file isn't usable.
+    bool store(const glm::ivec3& coords, const VoxelStorage& voxels, int minY, int maxY);
+
+    // Reads back and removes the chunk at coords, if it's swapped out
+    [[nodiscard]] std::optional<ChunkCache::Entry> take(const glm::ivec3& coords);
+
+    [[nodiscard]] bool contains(const glm::ivec3& coords) const { return records.contains(coords); }
+    void erase(const glm::ivec3& coords);
+    void clear();
+
+    [[nodiscard]] const ChunkSwapStats& getStats() const { return stats; }
+
+    static void encode(const VoxelStorage& voxels, std::vector<std::byte>& bytes);
+
+    // Checks every byte, as region files persist between runs; returns nullopt if they aren't a whole, valid chunk
+    [[nodiscard]] static std::optional<VoxelStorage> decode(std::span<const std::byte> bytes);
+
+private:
+    static constexpr size_t InitialFileSize = size_t{16} << 20;
+    static constexpr size_t Alignment = 256;
+
+    struct Record {
+        Region region;
+        size_t size;
+        int minY;
+        int maxY;
+    };
+
+    std::filesystem::path path;
+    MappedFile file;
+    FreeListAllocator allocator;
+    std::unordered_map<glm::ivec3, Record, IVec3Hash> records;
+    std::vector<std::byte> buffer;  // Reused between stores
+    ChunkSwapStats stats;
+
+    bool openFile();
+};
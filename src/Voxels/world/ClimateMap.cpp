@@ -0,0 +1,74 @@
+#include "ClimateMap.hpp"
+
+#include <algorithm>
+
+#include "tracy/Tracy.hpp"
+
+namespace {
+    constexpr double Frequency = 0.002;
+    constexpr int Octaves = 2;
+
+    // Perlin octaves mostly stay within [0.25, 0.75], so are stretched out to cover about as much of [0, 1] as simplex
+    // octaves do
+    float contrastOf(const NoiseBackend backend) {
+        return backend == NoiseBackend::Simplex ? 1.0f : 2.0f;
+    }
+
+    float lerp(const float a, const float b, const float t) {
+        return a + (b - a) * t;
+    }
+
+    ClimateMap::Sample lerp(const ClimateMap::Sample& a, const ClimateMap::Sample& b, const float t) {
+        return {
+            {lerp(a.climate.temperature, b.climate.temperature, t), lerp(a.climate.humidity, b.climate.humidity, t)},
+            {lerp(a.shape.height, b.shape.height, t), lerp(a.shape.relief, b.shape.relief, t),
+             lerp(a.shape.trees, b.shape.trees, t)},
+        };
+    }
+}
+
+ClimateMap::Sample ClimateMap::Region::at(const int x, const int z) const {
+    const int lx = x & (RegionSize - 1);
+    const int lz = z & (RegionSize - 1);
+    const size_t i = static_cast<size_t>((lz >> SpacingShift) * Samples + (lx >> SpacingShift));
+    const float fx = static_cast<float>(lx & (Spacing - 1)) / Spacing;
+    const float fz = static_cast<float>(lz & (Spacing - 1)) / Spacing;
+    return lerp(lerp(samples[i], samples[i + 1], fx), lerp(samples[i + Samples], samples[i + Samples + 1], fx), fz);
+}
+
+ClimateMap::ClimateMap(const NoiseBackend backend, const unsigned int seed, const size_t maxRegions)
+    : temperature(backend, seed), humidity(backend, seed + 1), contrast(contrastOf(backend)),
+      regions([this](const int rx, const int rz, Region& region) { sample(rx, rz, region); }, maxRegions)
+{}
+
+ClimateMap& ClimateMap::climate(const NoiseBackend backend) {
+    static ClimateMap perlinClimate(NoiseBackend::Perlin, TerrainSeed + 1);
+    static ClimateMap simplexClimate(NoiseBackend::Simplex, TerrainSeed + 1);
+    return backend == NoiseBackend::Simplex ? simplexClimate : perlinClimate;
+}
+
+void ClimateMap::sample(const int rx, const int rz, Region& region) const {
+    ZoneScopedN("Sample climate region");
+    constexpr size_t Count = Samples * Samples;
+    thread_local std::array<double, Count> xs;
+    thread_local std::array<double, Count> zs;
+    thread_local std::array<double, Count> temperatures;
+    thread_local std::array<double, Count> humidities;
+    for (int z = 0; z < Samples; ++z) {
+        for (int x = 0; x < Samples; ++x) {
+            xs[z * Samples + x] = ((rx << RegionSizeShift) + (x << SpacingShift)) * Frequency;
+            zs[z * Samples + x] = ((rz << RegionSizeShift) + (z << SpacingShift)) * Frequency;
+        }
+    }
+    temperature.octave2D_01(xs, zs, temperatures, Octaves);
+    humidity.octave2D_01(xs, zs, humidities, Octaves);
+
+    // Blending the biomes is the costly part, so it's done here rather than for every column
+    const auto stretch = [this](const double noise) {
+        return std::clamp(0.5f + (static_cast<float>(noise) - 0.5f) * contrast, 0.0f, 1.0f);
+    };
+    for (size_t i = 0; i < Count; ++i) {
+        const Climate climate{stretch(temperatures[i]), stretch(humidities[i])};
+        region.samples[i] = {climate, Biome::blend(climate)};
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include "Biome.hpp"
+#include "Chunk.hpp"
+#include "TerrainNoise.hpp"
+#include "../core/TileCache.hpp"
+
+using ClimateMapStats = TileCacheStats;
+
+// Temperature and humidity, which vary over hundreds of voxels, so are only sampled every Spacing columns and blended
+// bilinearly in between, along with the terrain shape of the biomes there. Samples are cached per region of RegionSize x
+// RegionSize columns (RegionCache's regions) and shared by every generation thread, so a region costs two noise samples
+// and one blend of the biomes per Spacing x Spacing columns, once. Thread-safe; the least recently used regions are
+// evicted once there are more than maxRegions.
+class ClimateMap {
+public:
+    struct Sample {
+        Climate climate;
+        TerrainShape shape;
+    };
+
+    static constexpr int SpacingShift = 4;
+    static constexpr int Spacing = 1 << SpacingShift;
+    static constexpr int RegionSizeShift = 5 + ChunkSizeShift;
+    static constexpr int RegionSize = 1 << RegionSizeShift;
+    static_assert(RegionSizeShift >= HeightmapCache::TileSizeShift, "A heightmap tile's columns must lie in one region");
+
+    // Samples along each side, including those on the far edges, which are shared with the neighbouring regions
+    static constexpr int Samples = (RegionSize >> SpacingShift) + 1;
+
+    class Region {
+    public:
+        // World column (x, z), which must lie within the region
+        [[nodiscard]] Sample at(int x, int z) const;
+
+    private:
+        friend class ClimateMap;
+
+        std::array<Sample, Samples * Samples> samples;
+    };
+
+    ClimateMap(NoiseBackend backend, unsigned int seed, size_t maxRegions = 16);
+
+    ClimateMap(const ClimateMap&) = delete;
+    ClimateMap& operator=(const ClimateMap&) = delete;
+
+    // Seeded from TerrainSeed, shared by every generation thread
+    static ClimateMap& climate(NoiseBackend backend);
+
+    // The region containing world column (x, z)
+    [[nodiscard]] std::shared_ptr<const Region> regionAt(const int x, const int z) {
+        return regions.at(x >> RegionSizeShift, z >> RegionSizeShift);
+    }
+
+    [[nodiscard]] Sample at(const int x, const int z) { return regionAt(x, z)->at(x, z); }
+
+    [[nodiscard]] ClimateMapStats getStats() const { return regions.getStats(); }
+
+private:
+    TerrainNoise temperature;
+    TerrainNoise humidity;
+    float contrast;
+    TileCache<Region> regions;
+
+    void sample(int rx, int rz, Region& region) const;
+};
@@ -0,0 +1,115 @@
+#include "ColumnStorage.hpp"
+
+#include <algorithm>
+
+ColumnStorage::~ColumnStorage() {
+    spanPool().release(std::move(spans));
+}
+
+ColumnStorage::ColumnStorage(const ColumnStorage& other)
+    : spans(spanPool().reserve(other.spans.size())), offsets(other.offsets), highest(other.highest)
+{
+    spans.assign(other.spans.begin(), other.spans.end());
+}
+
+ColumnStorage& ColumnStorage::operator=(const ColumnStorage& other) {
+    if (this != &other) {
+        *this = ColumnStorage(other);
+    }
+    return *this;
+}
+
+ColumnStorage& ColumnStorage::operator=(ColumnStorage&& other) noexcept {
+    if (this != &other) {
+        spanPool().release(std::move(spans));
+        spans = std::move(other.spans);
+        offsets = other.offsets;
+        highest = other.highest;
+    }
+    return *this;
+}
+
+size_t ColumnStorage::fill(const size_t x, const size_t z, const size_t yBegin, const size_t yEnd, const Voxel v) {
+    // Expand the column to one entry per voxel up to the highest one that matters, edit it, then re-encode
+    std::array<Voxel, ChunkHeight> voxels{};
+    size_t height = 0;
+    for (const auto& [type, length] : column(x, z)) {
+        std::fill_n(voxels.begin() + height, length, type);
+        height += length;
+    }
+    std::fill(voxels.begin() + yBegin, voxels.begin() + yEnd, v);
+    height = std::max(height, yEnd);
+
+    // Trailing empty voxels are implicit
+    while (height > 0 && voxels[height - 1] == EmptyVoxel) {
+        --height;
+    }
+
+    std::array<Span, ChunkHeight> encoded{};
+    size_t spanCount = 0;
+    for (size_t i = 0; i < height; ++i) {
+        if (spanCount > 0 && encoded[spanCount - 1].type == voxels[i]) {
+            ++encoded[spanCount - 1].length;
+        } else {
+            encoded[spanCount++] = {voxels[i], 1};
+        }
+    }
+
+    setColumn(x, z, std::span(encoded).first(spanCount));
+    return spanCount;
+}
+
+void ColumnStorage::setColumn(const size_t x, const size_t z, const std::span<const Span> columnSpans) {
+    const size_t c = getColumnIndex(x, z);
+    const int oldColumnTop = columnTop(c);
+
+    // Heightmap terrain needs about two spans per column
+    if (spans.capacity() == 0) {
+        spans = spanPool().reserve(2 * ColumnCount);
+    }
+
+    const auto begin = spans.begin() + offsets[c];
+    const auto end = spans.begin() + offsets[c + 1];
+    const ptrdiff_t delta = static_cast<ptrdiff_t>(columnSpans.size()) - (end - begin);
+
+    // Columns are usually set in index order while generating, in which case this only ever appends
+    const auto it = spans.erase(begin, end);
+    spans.insert(it, columnSpans.begin(), columnSpans.end());
+
+    if (delta != 0) {
+        for (size_t i = c + 1; i <= ColumnCount; ++i) {
+            offsets[i] = static_cast<uint16_t>(offsets[i] + delta);
+        }
+    }
+
+    // Only a column that used to be the highest can lower the overall top
+    if (const int newColumnTop = columnTop(c); newColumnTop >= highest) {
+        highest = newColumnTop;
+    } else if (oldColumnTop == highest) {
+        highest = 0;
+        for (size_t i = 0; i < ColumnCount; ++i) {
+            highest = std::max(highest, columnTop(i));
+        }
+    }
+}
+
+size_t ColumnStorage::memoryUsage() const {
+    return sizeof(ColumnStorage) + spans.capacity() * sizeof(Span);
+}
+
+BufferPool<ColumnStorage::Span>& ColumnStorage::spanPool() {
+    static BufferPool<Span> pool;
+    return pool;
+}
+
+int ColumnStorage::columnTop(const size_t c) const {
+    int y = 0;
+    int top = 0;
+    for (size_t i = offsets[c]; i < offsets[c + 1]; ++i) {
+        y += spans[i].length;
+        if (spans[i].type != EmptyVoxel) {
+            top = y;
+        }
+    }
+    return top;
+}
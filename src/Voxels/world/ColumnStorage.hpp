@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ChunkConstants.hpp"
+#include "../core/BufferPool.hpp"
+
+// Voxels of a single chunk stored as run-length encoded (x, z) columns. Each column is a short
+// list of spans from y = 0 upwards; anything above the last span is empty. Heightmap terrain is typically two spans
+// per column (stone, then a single grass voxel), so this is built in O(columns) and is very small.
+class ColumnStorage {
+public:
+    struct Span {
+        Voxel type;
+        uint16_t length;
+    };
+
+    static constexpr size_t ColumnCount = ChunkSize * ChunkSize;
+
+    // Columns with more spans than this are considered heavily edited
+    static constexpr size_t MaxSpans = 8;
+
+    ColumnStorage() = default;
+    ~ColumnStorage();
+
+    ColumnStorage(const ColumnStorage& other);
+    ColumnStorage(ColumnStorage&& other) noexcept = default;
+    ColumnStorage& operator=(const ColumnStorage& other);
+    ColumnStorage& operator=(ColumnStorage&& other) noexcept;
+
+    // x and z are in [0, ChunkSize)
+    [[nodiscard]] Voxel load(const size_t x, const size_t y, const size_t z) const {
+        const size_t column = getColumnIndex(x, z);
+        size_t top = 0;
+        for (size_t i = offsets[column]; i < offsets[column + 1]; ++i) {
+            top += spans[i].length;
+            if (y < top) {
+                return spans[i].type;
+            }
+        }
+        return EmptyVoxel;
+    }
+
+    // Returns the number of spans in the edited column
+    size_t store(const size_t x, const size_t y, const size_t z, const Voxel v) { return fill(x, z, y, y + 1, v); }
+
+    // Sets [yBegin, yEnd) of column (x, z) to v. Returns the number of spans in the edited column.
+    size_t fill(size_t x, size_t z, size_t yBegin, size_t yEnd, Voxel v);
+
+    void setColumn(size_t x, size_t z, std::span<const Span> columnSpans);
+
+    [[nodiscard]] std::span<const Span> column(const size_t x, const size_t z) const {
+        const size_t c = getColumnIndex(x, z);
+        return {spans.data() + offsets[c], spans.data() + offsets[c + 1]};
+    }
+
+    // One past the highest non-empty voxel in any column
+    [[nodiscard]] int top() const { return highest; }
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+    static BufferPool<Span>& spanPool();
+
+    static size_t getColumnIndex(const size_t x, const size_t z) {
+        return z * ChunkSize + x;
+    }
+
+private:
+    std::vector<Span> spans;
+    std::array<uint16_t, ColumnCount + 1> offsets{};
+    int highest = 0;
+
+    [[nodiscard]] int columnTop(size_t c) const;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+// Planes of a view frustum, each facing inwards, and the box test that drawcmd_comp.glsl runs on the GPU. The CPU copy
+// is the reference the shader's culling is checked against.
+struct Frustum {
+    std::array<glm::vec4, 6> planes;
+
+    // Planes of the clip space volume of viewProjection
+    static Frustum fromMatrix(const glm::mat4& viewProjection) {
+        const glm::mat4 m = glm::transpose(viewProjection);
+        return {{
+            m[3] + m[0],  // x + w < 0
+            m[3] - m[0],  // x - w > 0
+            m[3] + m[1],  // y + w < 0
+            m[3] - m[1],  // y - w > 0
+            m[3] + m[2],  // z + w < 0
+            m[3] - m[2],  // z - w > 0
+        }};
+    }
+
+    // False only if every corner of the box is behind the same plane, so boxes near the frustum's edges may be kept.
+    // Only the corner furthest in front of each plane needs testing, as the rest are behind it if it is.
+    [[nodiscard]] bool isBoxVisible(const glm::vec3& min, const glm::vec3& max) const {
+        for (const glm::vec4& plane : planes) {
+            const glm::vec4 corner(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y,
+                                   plane.z >= 0.0f ? max.z : min.z, 1.0f);
+            if (glm::dot(plane, corner) < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
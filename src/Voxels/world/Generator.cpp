@@ -0,0 +1,493 @@
+#include "Generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ClimateMap.hpp"
+#include "HeightmapCache.hpp"
+#include "LatticeNoise.hpp"
+#include "TerrainNoise.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+    // Reads a [horizontal, vertical] lattice, keeping fallback if there isn't one
+    std::optional<NoiseLattice> readLattice(const json& params, const NoiseLattice fallback) {
+        const json latticeJson = params.value("lattice", json::array());
+        if (!latticeJson.is_array() || latticeJson.empty()) {
+            return fallback;
+        }
+
+        if (latticeJson.size() == 2 && latticeJson[0].is_number_integer() && latticeJson[1].is_number_integer()) {
+            const NoiseLattice lattice{latticeJson[0], latticeJson[1]};
+            if (lattice.isValid()) {
+                return lattice;
+            }
+        }
+        std::cerr << "Invalid noise lattice: " << latticeJson << std::endl;
+        return std::nullopt;
+    }
+
+    // Reads the name of a noise backend, which is Perlin if there isn't one
+    std::optional<NoiseBackend> readNoise(const json& params) {
+        const json name = params.value("noise", json("perlin"));
+        if (name == "perlin") {
+            return NoiseBackend::Perlin;
+        }
+        if (name == "simplex") {
+            return NoiseBackend::Simplex;
+        }
+        std::cerr << "Unknown noise: " << name << std::endl;
+        return std::nullopt;
+    }
+
+    // Perlin is left out of a stage's parameters, as are biomes unless it has them, so the parameters of stages from
+    // before either could be chosen, and the fingerprint of their region caches, are the same as they were
+    void writeNoise(json& params, const NoiseBackend noise) {
+        if (noise == NoiseBackend::Simplex) {
+            params["noise"] = "simplex";
+        }
+    }
+
+    // Reads whether the terrain has biomes, which it doesn't unless asked for
+    std::optional<bool> readBiomes(const json& params) {
+        const json biomes = params.value("biomes", json(false));
+        if (!biomes.is_boolean()) {
+            std::cerr << "Biomes must be true or false: " << biomes << std::endl;
+            return std::nullopt;
+        }
+        return biomes.get<bool>();
+    }
+
+    // Trees stand on the terrain of the heightmap stage before them, so take its noise and biomes. Returns false if the
+    // trees ask for others, which would leave them floating or buried.
+    bool useTerrainOf(const json& heightmap, json& trees) {
+        const std::pair<const char*, json> settings[] = {{"noise", "perlin"}, {"biomes", false}};
+        for (const auto& [key, fallback] : settings) {
+            const json terrain = heightmap.value(key, fallback);
+            if (trees.value(key, terrain) != terrain) {
+                std::cerr << "Trees must have the same " << key << " as the heightmap before them: " << trees
+                          << std::endl;
+                return false;
+            }
+            trees[key] = terrain;
+        }
+        return true;
+    }
+
+    class FlatStage final : public GeneratorStage {
+    public:
+        void apply(int, const int cy, int, Chunk::GenerationResult& result) const override {
+            result = Chunk::generateFlat(cy);
+        }
+
+        void applyLod(const int cx, const int cy, const int cz, const int lod,
+                      Chunk::GenerationResult& result) const override {
+            result = Chunk::generateLod(GenerationType::Flat, cx, cy, cz, lod);
+        }
+
+        [[nodiscard]] json toJson() const override { return {{"stage", "flat"}}; }
+    };
+
+    // Terrain heights come from the shared HeightmapCache, so every chunk of a column reads the same cached tile. With
+    // biomes, the terrain's shape and voxels follow the climate (see ClimateMap).
+    class HeightmapStage final : public GeneratorStage {
+    public:
+        HeightmapStage(const NoiseBackend noise, const bool biomes) : noise(noise), biomes(biomes) {}
+
+        void apply(const int cx, const int cy, const int cz, Chunk::GenerationResult& result) const override {
+            result = Chunk::generateVoxels2D(cx, cy, cz, noise, biomes);
+        }
+
+        // Coarse chunks sample only every few columns, so read the noise directly rather than whole cached tiles
+        void applyLod(const int cx, const int cy, const int cz, const int lod,
+                      Chunk::GenerationResult& result) const override {
+            result = Chunk::generateLod(GenerationType::Perlin2D, cx, cy, cz, lod, noise, biomes);
+        }
+
+        [[nodiscard]] StageFootprint footprint() const override { return {.radius = 0, .heights = true}; }
+
+        [[nodiscard]] json toJson() const override {
+            json params = {{"stage", "heightmap"}};
+            writeNoise(params, noise);
+            if (biomes) {
+                params["biomes"] = true;
+            }
+            return params;
+        }
+
+    private:
+        NoiseBackend noise;
+        bool biomes;
+    };
+
+    class DensityStage final : public GeneratorStage {
+    public:
+        DensityStage(const NoiseLattice lattice, const NoiseBackend noise) : lattice(lattice), noise(noise) {}
+
+        void apply(const int cx, const int cy, const int cz, Chunk::GenerationResult& result) const override {
+            result = Chunk::generateVoxels3D(cx, cy, cz, lattice, noise);
+        }
+
+        void applyLod(const int cx, const int cy, const int cz, const int lod,
+                      Chunk::GenerationResult& result) const override {
+            result = Chunk::generateLod(GenerationType::Perlin3D, cx, cy, cz, lod, noise);
+        }
+
+        [[nodiscard]] json toJson() const override {
+            json params = {{"stage", "density"}, {"lattice", {lattice.horizontal, lattice.vertical}}};
+            writeNoise(params, noise);
+            return params;
+        }
+
+    private:
+        NoiseLattice lattice;
+        NoiseBackend noise;
+    };
+
+    // Carves out the solid voxels where a second 3D noise field is above threshold
+    class CavesStage final : public GeneratorStage {
+    public:
+        CavesStage(const unsigned int seed, const double frequency, const double threshold, const NoiseLattice lattice,
+                   const NoiseBackend backend)
+            : noise(backend, seed), seed(seed), frequency(frequency), threshold(threshold), lattice(lattice)
+        {}
+
+        void apply(const int cx, const int cy, const int cz, Chunk::GenerationResult& result) const override {
+            VoxelStorage& voxels = result.voxelField;
+
+            // Only the voxels below the top of each column can be carved
+            std::array<int, ChunkSize * ChunkSize> heights{};
+            int top = 0;
+            for (int z = 0; z < ChunkSize; ++z) {
+                for (int x = 0; x < ChunkSize; ++x) {
+                    heights[z * ChunkSize + x] = voxels.height(x, z);
+                    top = std::max(top, heights[z * ChunkSize + x]);
+                }
+            }
+            if (top == 0) {
+                return;
+            }
+
+            LatticeNoise field(noise, cx, cy, cz, top, lattice, frequency, 2);
+            int lowest = top;
+            for (int sectionBase = 0; sectionBase < top; sectionBase += SectionHeight) {
+                const std::span<const double> density = field.section(sectionBase);
+                for (int z = 0; z < ChunkSize; ++z) {
+                    for (int x = 0; x < ChunkSize; ++x) {
+                        // Runs of carved voxels within the section's part of the column
+                        const int end = std::min(heights[z * ChunkSize + x] - sectionBase, SectionHeight);
+                        int run = -1;
+                        for (int ly = 0; ly <= end; ++ly) {
+                            const bool carve = ly < end && density[LatticeNoise::getIndex(x, ly, z)] > threshold;
+                            if (carve && run < 0) {
+                                run = ly;
+                            } else if (!carve && run >= 0) {
+                                voxels.fillColumn(x, z, sectionBase + run, sectionBase + ly, EmptyVoxel);
+                                lowest = std::min(lowest, sectionBase + run);
+                                run = -1;
+                            }
+                        }
+                    }
+                }
+            }
+
+            voxels.compact();
+            if (lowest < top) {
+                result.minY = std::max(0, std::min(result.minY, lowest - 1));
+            }
+        }
+
+        [[nodiscard]] json toJson() const override {
+            json params = {
+                {"stage", "caves"},
+                {"seed", seed},
+                {"frequency", frequency},
+                {"threshold", threshold},
+                {"lattice", {lattice.horizontal, lattice.vertical}},
+            };
+            writeNoise(params, noise.getBackend());
+            return params;
+        }
+
+    private:
+        TerrainNoise noise;
+        unsigned int seed;
+        double frequency;
+        double threshold;
+        NoiseLattice lattice;
+    };
+
+    // Scatters trees over the heightmap terrain of the given noise, and with biomes, more densely in some biomes than
+    // others. In a pipeline they take the noise and biomes of the heightmap stage before them (see useTerrainOf).
+    // Leaves overhang the trunk by LeafRadius columns, so the trees of neighbouring columns are found from their cached
+    // heights.
+    class TreesStage final : public GeneratorStage {
+    public:
+        static constexpr int LeafRadius = 2;
+
+        TreesStage(const unsigned int seed, const double chance, const int trunkHeight, const Voxel trunk,
+                   const Voxel leaves, const NoiseBackend noise, const bool biomes)
+            : seed(seed), chance(chance), trunkHeight(trunkHeight), trunk(trunk), leaves(leaves), noise(noise),
+              biomes(biomes), likeliest(biomes ? chance * mostTrees() : chance)
+        {}
+
+        void apply(const int cx, const int cy, const int cz, Chunk::GenerationResult& result) const override {
+            const int x0 = cx * ChunkSize;
+            const int z0 = cz * ChunkSize;
+            const int base = cy * ChunkHeight;
+
+            // Neighbouring columns usually share a tile, so it's only looked up again on leaving it
+            std::shared_ptr<const HeightmapCache::Tile> tile;
+            int tileX = 0;
+            int tileZ = 0;
+            std::vector<glm::ivec3> trees;  // Trunk positions relative to the chunk
+            for (int wz = z0 - LeafRadius; wz < z0 + ChunkSize + LeafRadius; ++wz) {
+                for (int wx = x0 - LeafRadius; wx < x0 + ChunkSize + LeafRadius; ++wx) {
+                    // The climate is only looked up for the few columns that could have a tree in any biome
+                    const double roll = treeRoll(wx, wz);
+                    if (roll >= likeliest ||
+                        (biomes && roll >= chance * ClimateMap::climate(noise).at(wx, wz).shape.trees)) {
+                        continue;
+                    }
+
+                    if (!tile || wx >> HeightmapCache::TileSizeShift != tileX ||
+                        wz >> HeightmapCache::TileSizeShift != tileZ) {
+                        tile = Chunk::heightmapCache(noise, biomes).tileAt(wx, wz);
+                        tileX = wx >> HeightmapCache::TileSizeShift;
+                        tileZ = wz >> HeightmapCache::TileSizeShift;
+                    }
+
+                    // Chunk rows above the terrain are never generated, so trees reaching them would be cut off
+                    const int ground = (*tile)[HeightmapCache::getColumnIndex(wx, wz)];
+                    if (ground + trunkHeight < TerrainHeight) {
+                        trees.emplace_back(wx - x0, ground - base, wz - z0);
+                    }
+                }
+            }
+
+            // Trunks go in after every tree's leaves, so overlapping trees look the same whichever is placed first
+            for (const glm::ivec3& tree : trees) {
+                placeLeaves(tree, result);
+            }
+            for (const glm::ivec3& tree : trees) {
+                fill(result, tree.x, tree.z, tree.y, tree.y + trunkHeight, trunk);
+            }
+        }
+
+        [[nodiscard]] StageFootprint footprint() const override { return {.radius = LeafRadius, .heights = true}; }
+
+        [[nodiscard]] json toJson() const override {
+            json params = {
+                {"stage", "trees"},
+                {"seed", seed},
+                {"chance", chance},
+                {"height", trunkHeight},
+                {"trunk", trunk},
+                {"leaves", leaves},
+            };
+            writeNoise(params, noise);
+            if (biomes) {
+                params["biomes"] = true;
+            }
+            return params;
+        }
+
+    private:
+        unsigned int seed;
+        double chance;
+        int trunkHeight;
+        Voxel trunk;
+        Voxel leaves;
+        NoiseBackend noise;
+        bool biomes;
+        double likeliest;  // The chance of a tree in the biome with the most trees
+
+        // Where trees are most common, relative to chance. Shapes are blended, so never have more.
+        static double mostTrees() {
+            double most = 0.0;
+            for (const Biome& biome : Biome::all()) {
+                most = std::max(most, static_cast<double>(biome.shape.trees));
+            }
+            return most;
+        }
+
+        // In [0, 1), the same for every column each time; the column has a tree if it's below the chance of one there
+        [[nodiscard]] double treeRoll(const int wx, const int wz) const {
+            uint32_t h = static_cast<uint32_t>(wx) * 0x9E3779B1u ^ static_cast<uint32_t>(wz) * 0x85EBCA77u ^ seed;
+            h ^= h >> 15;
+            h *= 0x2C1B3C6Du;
+            h ^= h >> 12;
+            return static_cast<double>(h & 0xFFFFFF) / static_cast<double>(1 << 24);
+        }
+
+        static void fill(Chunk::GenerationResult& result, const int x, const int z, const int yBegin, const int yEnd,
+                         const Voxel v) {
+            if (x >= 0 && x < ChunkSize && z >= 0 && z < ChunkSize) {
+                Chunk::fillInto(result.voxelField, result.minY, result.maxY, x, z, std::max(yBegin, 0),
+                                std::min(yEnd, ChunkHeight), v);
+            }
+        }
+
+        // Two wide layers of leaves below a narrow one at the top of the trunk, with the corners left off. The trunk is
+        // relative to the chunk, which the tree may only partly overlap.
+        void placeLeaves(const glm::ivec3& trunkBase, Chunk::GenerationResult& result) const {
+            const int canopy = trunkBase.y + trunkHeight;  // The highest leaf
+            for (int dz = -LeafRadius; dz <= LeafRadius; ++dz) {
+                for (int dx = -LeafRadius; dx <= LeafRadius; ++dx) {
+                    if (std::abs(dx) == LeafRadius && std::abs(dz) == LeafRadius) {
+                        continue;
+                    }
+                    const bool narrow = std::abs(dx) < LeafRadius && std::abs(dz) < LeafRadius;
+                    fill(result, trunkBase.x + dx, trunkBase.z + dz, canopy - 2, narrow ? canopy + 1 : canopy, leaves);
+                }
+            }
+        }
+    };
+}
+
+GeneratorPipeline::GeneratorPipeline(std::vector<std::unique_ptr<GeneratorStage>> stages)
+    : stages(std::move(stages))
+{}
+
+GeneratorPipeline GeneratorPipeline::fromType(const GenerationType type, const NoiseLattice lattice) {
+    std::vector<std::unique_ptr<GeneratorStage>> stages;
+    switch (type) {
+        case GenerationType::Flat:
+            stages.push_back(std::make_unique<FlatStage>());
+            break;
+        case GenerationType::Perlin2D:
+            stages.push_back(std::make_unique<HeightmapStage>(NoiseBackend::Perlin, false));
+            break;
+        case GenerationType::Perlin3D:
+            stages.push_back(std::make_unique<DensityStage>(lattice, NoiseBackend::Perlin));
+            break;
+        case GenerationType::None:
+        default:
+            break;
+    }
+    return GeneratorPipeline(std::move(stages));
+}
+
+std::optional<GeneratorPipeline> GeneratorPipeline::fromJson(const json& stages) {
+    if (!stages.is_array()) {
+        std::cerr << "Generator must be an array of stages" << std::endl;
+        return std::nullopt;
+    }
+
+    std::vector<std::unique_ptr<GeneratorStage>> built;
+    std::optional<json> heightmap;  // The latest heightmap stage, as written back out
+    for (json params : stages) {
+        const std::string name = params.is_object() ? params.value("stage", "") : "";
+        const auto it = registry().find(name);
+        if (it == registry().end()) {
+            std::cerr << "Unknown generator stage: " << params << std::endl;
+            return std::nullopt;
+        }
+        if (name == "trees") {
+            // Without a heightmap stage before them, the trees would stand on a surface that isn't there
+            if (!heightmap) {
+                std::cerr << "Trees need a heightmap stage before them: " << params << std::endl;
+                return std::nullopt;
+            }
+            if (!useTerrainOf(*heightmap, params)) {
+                return std::nullopt;
+            }
+        }
+
+        std::unique_ptr<GeneratorStage> stage = it->second(params);
+        if (!stage) {
+            std::cerr << "Invalid parameters for generator stage: " << params << std::endl;
+            return std::nullopt;
+        }
+        if (name == "heightmap") {
+            heightmap = stage->toJson();
+        }
+        built.push_back(std::move(stage));
+    }
+    return GeneratorPipeline(std::move(built));
+}
+
+json GeneratorPipeline::toJson() const {
+    json stagesJson = json::array();
+    for (const auto& stage : stages) {
+        stagesJson.push_back(stage->toJson());
+    }
+    return stagesJson;
+}
+
+void GeneratorPipeline::registerStage(const std::string& name, StageFactory factory) {
+    registry()[name] = std::move(factory);
+}
+
+Chunk::GenerationResult GeneratorPipeline::generate(const int cx, const int cy, const int cz, const int lod) const {
+    Chunk::GenerationResult result;
+    for (const auto& stage : stages) {
+        if (lod == 0) {
+            stage->apply(cx, cy, cz, result);
+        } else {
+            stage->applyLod(cx, cy, cz, lod, result);
+        }
+    }
+    result.lod = lod;
+    return result;
+}
+
+StageFootprint GeneratorPipeline::footprint() const {
+    StageFootprint widest;
+    for (const auto& stage : stages) {
+        const StageFootprint footprint = stage->footprint();
+        widest.radius = std::max(widest.radius, footprint.radius);
+        widest.heights = widest.heights || footprint.heights;
+    }
+    return widest;
+}
+
+std::unordered_map<std::string, GeneratorPipeline::StageFactory>& GeneratorPipeline::registry() {
+    static std::unordered_map<std::string, StageFactory> stages{
+        {"flat", [](const json&) { return std::make_unique<FlatStage>(); }},
+        {"heightmap", [](const json& params) -> std::unique_ptr<GeneratorStage> {
+            const std::optional<NoiseBackend> noise = readNoise(params);
+            const std::optional<bool> biomes = readBiomes(params);
+            return noise && biomes ? std::make_unique<HeightmapStage>(*noise, *biomes) : nullptr;
+        }},
+        {"density", [](const json& params) -> std::unique_ptr<GeneratorStage> {
+            const std::optional<NoiseLattice> lattice = readLattice(params, NoiseLattice{});
+            const std::optional<NoiseBackend> noise = readNoise(params);
+            return lattice && noise ? std::make_unique<DensityStage>(*lattice, *noise) : nullptr;
+        }},
+        {"caves", [](const json& params) -> std::unique_ptr<GeneratorStage> {
+            const std::optional<NoiseLattice> lattice = readLattice(params, NoiseLattice{4, 4});
+            const std::optional<NoiseBackend> noise = readNoise(params);
+            const double frequency = params.value("frequency", 0.03);
+            if (!lattice || !noise || frequency <= 0.0) {
+                return nullptr;
+            }
+            return std::make_unique<CavesStage>(params.value("seed", 654321u), frequency,
+                                                params.value("threshold", 0.7), *lattice, *noise);
+        }},
+        {"trees", [](const json& params) -> std::unique_ptr<GeneratorStage> {
+            const int height = params.value("height", 5);
+            const int trunk = params.value("trunk", 4);
+            const int leaves = params.value("leaves", 5);
+            const std::optional<NoiseBackend> noise = readNoise(params);
+            const std::optional<bool> biomes = readBiomes(params);
+            constexpr int MaxVoxel = std::numeric_limits<Voxel>::max();
+            if (height < 3 || height >= TerrainHeight || trunk <= 0 || trunk > MaxVoxel || leaves <= 0 ||
+                leaves > MaxVoxel || !noise || !biomes) {
+                return nullptr;
+            }
+            return std::make_unique<TreesStage>(params.value("seed", 13u), params.value("chance", 0.01), height,
+                                                static_cast<Voxel>(trunk), static_cast<Voxel>(leaves), *noise,
+                                                *biomes);
+        }},
+    };
+    return stages;
+}
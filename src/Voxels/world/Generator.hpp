@@ -0,0 +1,77 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Chunk.hpp"
+
+// What a generator stage reads besides the voxels the stages before it wrote into its own chunk
+struct StageFootprint {
+    // Columns past the edge of the chunk the stage reads, e.g. for trees whose leaves overhang their neighbours
+    int radius = 0;
+
+    // Whether it reads the terrain heights of its columns. Heights are cached per tile (see HeightmapCache) and shared
+    // by every chunk and generation thread, so a stage reading its neighbours' heights never waits for them to be
+    // generated.
+    bool heights = false;
+};
+
+// One step of world generation. Terrain stages create the chunk's voxels, replacing anything before them; the stages
+// after them edit those voxels in place. Stages are shared by every generation thread, so apply must be thread-safe.
+class GeneratorStage {
+public:
+    virtual ~GeneratorStage() = default;
+
+    virtual void apply(int cx, int cy, int cz, Chunk::GenerationResult& result) const = 0;
+
+    // As apply, for a chunk at a coarser level of detail (see MaxLod). By default the stage is skipped, as detail such
+    // as caves and trees is too small to make out from as far as coarse chunks are drawn.
+    virtual void applyLod(int, int, int, int, Chunk::GenerationResult&) const {}
+
+    [[nodiscard]] virtual StageFootprint footprint() const { return {}; }
+
+    // The stage as written in a level file, including its "stage" name
+    [[nodiscard]] virtual nlohmann::json toJson() const = 0;
+};
+
+// A world's generator: stages applied in order to each chunk, declared in the level file as e.g.
+//   "generator": [{"stage": "heightmap"}, {"stage": "caves", "threshold": 0.7}, {"stage": "trees"}]
+// Stages only read past their own chunk through shared caches (see StageFootprint), so chunks are generated
+// independently of each other.
+class GeneratorPipeline {
+public:
+    // Builds a stage from its parameters in the level file, or returns nullptr if they're invalid
+    using StageFactory = std::function<std::unique_ptr<GeneratorStage>(const nlohmann::json& params)>;
+
+    GeneratorPipeline() = default;
+    explicit GeneratorPipeline(std::vector<std::unique_ptr<GeneratorStage>> stages);
+
+    // The pipeline generating the same terrain as Chunk::generate
+    static GeneratorPipeline fromType(GenerationType type, NoiseLattice lattice = {});
+
+    // Reports unknown stages and invalid parameters to std::cerr
+    static std::optional<GeneratorPipeline> fromJson(const nlohmann::json& stages);
+    [[nodiscard]] nlohmann::json toJson() const;
+
+    // Makes a stage available to level files under name, replacing any stage registered under it before
+    static void registerStage(const std::string& name, StageFactory factory);
+
+    // Chunk rows at or above TerrainChunkRows are always empty, so are never generated
+    [[nodiscard]] Chunk::GenerationResult generate(int cx, int cy, int cz, int lod = 0) const;
+
+    // The widest footprint of any stage
+    [[nodiscard]] StageFootprint footprint() const;
+
+    [[nodiscard]] size_t stageCount() const { return stages.size(); }
+
+private:
+    std::vector<std::unique_ptr<GeneratorStage>> stages;
+
+    static std::unordered_map<std::string, StageFactory>& registry();
+};
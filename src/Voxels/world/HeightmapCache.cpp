@@ -0,0 +1,12 @@
+#include "HeightmapCache.hpp"
+
+#include <utility>
+
+#include "tracy/Tracy.hpp"
+
+HeightmapCache::HeightmapCache(Generator generator, const size_t maxTiles)
+    : tiles([generator = std::move(generator)](const int tx, const int tz, Tile& heights) {
+          ZoneScopedN("Compute heightmap tile");
+          generator(tx << TileSizeShift, tz << TileSizeShift, heights);
+      }, maxTiles)
+{}
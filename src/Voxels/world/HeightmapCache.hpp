@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "ChunkConstants.hpp"
+#include "../core/TileCache.hpp"
+
+using HeightmapCacheStats = TileCacheStats;
+
+// Heights of the terrain in square tiles of TileSize x TileSize columns, kept in a TileCache. Every chunk of a column
+// of chunks, and every chunk side by side within a tile, reads its heights from the same tile.
+class HeightmapCache {
+public:
+    static constexpr int TileSizeShift = 6;
+    static constexpr int TileSize = 1 << TileSizeShift;
+    static_assert(TileSizeShift >= ChunkSizeShift, "A chunk's columns must lie within a single tile");
+
+    // World heights indexed by getColumnIndex, relative to the tile's lowest corner
+    using Tile = std::array<uint16_t, TileSize * TileSize>;
+
+    // Fills heights for the tile whose lowest corner is at world column (x0, z0)
+    using Generator = std::function<void(int x0, int z0, Tile& heights)>;
+
+    explicit HeightmapCache(Generator generator, size_t maxTiles = 256);
+
+    // The tile containing world column (x, z)
+    [[nodiscard]] std::shared_ptr<const Tile> tileAt(const int x, const int z) {
+        return tiles.at(x >> TileSizeShift, z >> TileSizeShift);
+    }
+
+    void clear() { tiles.clear(); }
+
+    [[nodiscard]] HeightmapCacheStats getStats() const { return tiles.getStats(); }
+
+    static size_t getColumnIndex(const int x, const int z) {
+        return static_cast<size_t>((z & (TileSize - 1)) << TileSizeShift | (x & (TileSize - 1)));
+    }
+
+private:
+    TileCache<Tile> tiles;
+};
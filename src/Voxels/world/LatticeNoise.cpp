@@ -0,0 +1,85 @@
+#include "LatticeNoise.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace {
+    void lerpRows(const double* low, const double* high, const double t, double* out, const int count) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = low[i] + (high[i] - low[i]) * t;
+        }
+    }
+
+    // The lattice points either side of coordinate and its weight between them
+    std::tuple<int, int, double> cell(const int coordinate, const int step, const int last) {
+        const int i = coordinate / step;
+        return {i, std::min(i + 1, last), static_cast<double>(coordinate % step) / step};
+    }
+}
+
+LatticeNoise::LatticeNoise(const TerrainNoise& terrain, const int cx, const int cy, const int cz, const int top,
+                           const NoiseLattice lattice, const double frequency, const int octaves)
+    : top(top), h(lattice.horizontal), v(lattice.vertical),
+      nxz((ChunkSize + h - 2) / h + 1), ny((std::max(top, 1) + v - 2) / v + 1)
+{
+    // Lattice points covering [0, ChunkSize) horizontally and [0, top) vertically. Both steps divide the chunk and
+    // section sizes, so chunk-local lattice points are world lattice points.
+    thread_local std::vector<double> xs;
+    thread_local std::vector<double> ys;
+    thread_local std::vector<double> zs;
+    const size_t points = static_cast<size_t>(nxz) * nxz * ny;
+    xs.resize(points);
+    ys.resize(points);
+    zs.resize(points);
+    noise.resize(points);
+
+    const int base = cy * ChunkHeight;
+    for (int iz = 0; iz < nxz; ++iz) {
+        for (int ix = 0; ix < nxz; ++ix) {
+            for (int iy = 0; iy < ny; ++iy) {
+                const auto noise_x = static_cast<float>(cx * ChunkSize + ix * h + 1);
+                const auto noise_y = static_cast<float>(base + iy * v + 1);
+                const auto noise_z = static_cast<float>(cz * ChunkSize + iz * h + 1);
+                const size_t i = static_cast<size_t>((iz * nxz + ix) * ny + iy);
+                xs[i] = noise_x * frequency;
+                ys[i] = noise_y * frequency;
+                zs[i] = noise_z * frequency;
+            }
+        }
+    }
+    terrain.octave3D_01(xs, ys, zs, noise, octaves);
+
+    alongY.resize(static_cast<size_t>(nxz) * nxz * SectionHeight);
+    alongXY.resize(static_cast<size_t>(nxz) * ChunkSize * SectionHeight);
+    density.resize(static_cast<size_t>(ChunkSize) * ChunkSize * SectionHeight);
+}
+
+std::span<const double> LatticeNoise::section(const int sectionBase) {
+    // Interpolating along each axis in turn costs about one lerp per voxel, in loops over contiguous rows. A weight of
+    // 0 returns the lattice value exactly, so a step of 1 gives the exact noise.
+    const int sectionTop = std::min(top - sectionBase, SectionHeight);
+    for (int ly = 0; ly < sectionTop; ++ly) {
+        const auto [iy0, iy1, t] = cell(sectionBase + ly, v, ny - 1);
+        for (int i = 0; i < nxz * nxz; ++i) {
+            const double low = noise[static_cast<size_t>(i * ny + iy0)];
+            const double high = noise[static_cast<size_t>(i * ny + iy1)];
+            alongY[i * SectionHeight + ly] = low + (high - low) * t;
+        }
+    }
+
+    for (int iz = 0; iz < nxz; ++iz) {
+        for (int x = 0; x < ChunkSize; ++x) {
+            const auto [ix0, ix1, t] = cell(x, h, nxz - 1);
+            lerpRows(&alongY[(iz * nxz + ix0) * SectionHeight], &alongY[(iz * nxz + ix1) * SectionHeight], t,
+                     &alongXY[(iz * ChunkSize + x) * SectionHeight], sectionTop);
+        }
+    }
+
+    constexpr int Row = ChunkSize * SectionHeight;
+    for (int z = 0; z < ChunkSize; ++z) {
+        const auto [iz0, iz1, t] = cell(z, h, nxz - 1);
+        lerpRows(&alongXY[iz0 * Row], &alongXY[iz1 * Row], t, &density[z * Row], Row);
+    }
+
+    return density;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Chunk.hpp"
+#include "TerrainNoise.hpp"
+
+// Octave noise over the voxels [0, top) of a chunk, sampled at the points of a NoiseLattice in one batch and
+// interpolated trilinearly in between, one section at a time. Voxel (x, y, z) is sampled at the world position one
+// past it, scaled by frequency.
+class LatticeNoise {
+public:
+    LatticeNoise(const TerrainNoise& terrain, int cx, int cy, int cz, int top, NoiseLattice lattice,
+                 double frequency = 0.01, int octaves = 4);
+
+    // The noise of rows [sectionBase, min(sectionBase + SectionHeight, top)), indexed by getIndex
+    [[nodiscard]] std::span<const double> section(int sectionBase);
+
+    static size_t getIndex(const size_t x, const size_t ly, const size_t z) {
+        return (z * ChunkSize + x) * SectionHeight + ly;
+    }
+
+private:
+    int top;
+    int h;
+    int v;
+    int nxz;  // Lattice points along x and z
+    int ny;   // Lattice points along y
+
+    std::vector<double> noise;    // (iz, ix, iy)
+    std::vector<double> alongY;   // (iz, ix, y) for y in the section
+    std::vector<double> alongXY;  // (iz, x, y)
+    std::vector<double> density;  // (z, x, y)
+};
@@ -14,6 +14,14 @@ constexpr int TopFace = 5 * FaceSize;
 
 constexpr int VerticesLength = 6 * FaceSize;
 
+// Bits of a FaceMask, in the same order as the face masks built by meshColumns
+constexpr Mesher::FaceMask TopBit = 1 << 0;
+constexpr Mesher::FaceMask BottomBit = 1 << 1;
+constexpr Mesher::FaceMask LeftBit = 1 << 2;
+constexpr Mesher::FaceMask RightBit = 1 << 3;
+constexpr Mesher::FaceMask FrontBit = 1 << 4;
+constexpr Mesher::FaceMask BackBit = 1 << 5;
+
 constexpr int FrontNormal = 0;
 constexpr int BackNormal = 1;
 constexpr int LeftNormal = 2;
@@ -128,360 +136,438 @@ inline int Mesher::vertexAO(const uint8_t side1, const uint8_t side2, uint8_t co
     return side1 && side2 ? 0 : 3 - (side1 + side2 + corner);
 }
 
-bool Mesher::inBounds(const int x, const int y, const int z) {
-    constexpr int size = ChunkSize + 2;
-    constexpr int height = ChunkHeight;
-    return 0 <= x && x < size
-        && 0 <= y && y < height
-        && 0 <= z && z < size;
-}
-
 int Mesher::dirToIndex(const int i, const int j, const int k) {
     return (i + 1) * 9 + (j + 1) * 3 + k + 1;
 }
 
-auto Mesher::meshChunk(const std::shared_ptr<Chunk>& chunk, const std::vector<int>& voxels, const int minY, const int maxY) -> MeshResult {
+auto Mesher::meshChunk(const std::shared_ptr<Chunk>& chunk, const ChunkNeighbourhood& voxels, const int minY, const int maxY) -> MeshResult {
     std::vector<int> positions;
     std::vector<int> colours;
     std::vector<int> normals;
     std::vector<int> ao;
 
-    for (int y = minY; y < maxY; ++y) {
-        for (int z = 1; z < ChunkSize + 1; ++z) {
-            for (int x = 1; x < ChunkSize + 1; ++x) {
-                const int voxel = voxels[Chunk::getVoxelIndex(x, y, z)];
-                if (voxel == EmptyVoxel) {
-                    continue;
-                }
-
-                // Ambient occlusion (computed first so that quads can be flipped if necessary)
-                // (-1, -1, -1) to (1, 1, 1)
-                std::array<bool, 27> presence{};
-                int index = 0;
-                for (int i = -1; i <= 1; ++i) {
-                    for (int j = -1; j <= 1; ++j) {
-                        for (int k = -1; k <= 1; ++k) {
-                            presence[index] = inBounds(x + i, y + j, z + k)
-                                && voxels[Chunk::getVoxelIndex(x + i, y + j, z + k)] != 0;
-                            ++index;
-                        }
-                    }
-                }
+    std::array<ChunkSection, SectionCount> sections{};
+    meshColumns(voxels, minY, maxY, sections, positions, colours, normals, ao);
 
-                std::array<int, 24> voxelAO{};
-
-                // Top
-                voxelAO[0] = vertexAO(presence[dirToIndex(0, +1, -1)], presence[dirToIndex(-1, +1, 0)],
-                                      presence[dirToIndex(-1, +1, -1)]);  // bottom left   a00
-                voxelAO[1] = vertexAO(presence[dirToIndex(0, +1, -1)], presence[dirToIndex(+1, +1, 0)],
-                                      presence[dirToIndex(+1, +1, -1)]);  // bottom right  a10
-                voxelAO[2] = vertexAO(presence[dirToIndex(0, +1, +1)], presence[dirToIndex(+1, +1, 0)],
-                                      presence[dirToIndex(+1, +1, +1)]);  // top right     a11
-                voxelAO[3] = vertexAO(presence[dirToIndex(0, +1, +1)], presence[dirToIndex(-1, +1, 0)],
-                                      presence[dirToIndex(-1, +1, +1)]);  // top left      a01
-
-                // Bottom
-                voxelAO[4] = vertexAO(presence[dirToIndex(0, -1, -1)], presence[dirToIndex(-1, -1, 0)],
-                                      presence[dirToIndex(-1, -1, -1)]);  // bottom left
-                voxelAO[5] = vertexAO(presence[dirToIndex(0, -1, -1)], presence[dirToIndex(+1, -1, 0)],
-                                      presence[dirToIndex(+1, -1, -1)]);  // bottom right
-                voxelAO[6] = vertexAO(presence[dirToIndex(0, -1, +1)], presence[dirToIndex(+1, -1, 0)],
-                                      presence[dirToIndex(+1, -1, +1)]);  // top right
-                voxelAO[7] = vertexAO(presence[dirToIndex(0, -1, +1)], presence[dirToIndex(-1, -1, 0)],
-                                      presence[dirToIndex(-1, -1, +1)]);  // top left
-
-                // Left
-                voxelAO[8] = vertexAO(presence[dirToIndex(-1, 0, +1)], presence[dirToIndex(-1, -1, 0)],
-                                      presence[dirToIndex(-1, -1, +1)]);  // bottom left
-                voxelAO[9] = vertexAO(presence[dirToIndex(-1, 0, -1)], presence[dirToIndex(-1, -1, 0)],
-                                       presence[dirToIndex(-1, -1, -1)]);  // bottom right
-                voxelAO[10] = vertexAO(presence[dirToIndex(-1, 0, -1)], presence[dirToIndex(-1, +1, 0)],
-                                       presence[dirToIndex(-1, +1, -1)]);  // top right
-                voxelAO[11] = vertexAO(presence[dirToIndex(-1, 0, +1)], presence[dirToIndex(-1, +1, 0)],
-                                       presence[dirToIndex(-1, +1, +1)]);  // top left
-
-                // Right
-                voxelAO[12] = vertexAO(presence[dirToIndex(+1, 0, -1)], presence[dirToIndex(+1, -1, 0)],
-                                       presence[dirToIndex(+1, -1, -1)]);  // bottom left
-                voxelAO[13] = vertexAO(presence[dirToIndex(+1, 0, +1)], presence[dirToIndex(+1, -1, 0)],
-                                       presence[dirToIndex(+1, -1, +1)]);  // bottom right
-                voxelAO[14] = vertexAO(presence[dirToIndex(+1, 0, +1)], presence[dirToIndex(+1, +1, 0)],
-                                       presence[dirToIndex(+1, +1, +1)]);  // top right
-                voxelAO[15] = vertexAO(presence[dirToIndex(+1, 0, -1)], presence[dirToIndex(+1, +1, 0)],
-                                       presence[dirToIndex(+1, +1, -1)]);  // top left
-
-                // Front
-                voxelAO[16] = vertexAO(presence[dirToIndex(-1, 0, -1)], presence[dirToIndex(0, -1, -1)],
-                                       presence[dirToIndex(-1, -1, -1)]);  // bottom left
-                voxelAO[17] = vertexAO(presence[dirToIndex(+1, 0, -1)], presence[dirToIndex(0, -1, -1)],
-                                       presence[dirToIndex(+1, -1, -1)]);  // bottom right
-                voxelAO[18] = vertexAO(presence[dirToIndex(+1, 0, -1)], presence[dirToIndex(0, +1, -1)],
-                                       presence[dirToIndex(+1, +1, -1)]);  // top right
-                voxelAO[19] = vertexAO(presence[dirToIndex(-1, 0, -1)], presence[dirToIndex(0, +1, -1)],
-                                        presence[dirToIndex(-1, +1, -1)]);  // top left
-
-                // Back
-                voxelAO[20] = vertexAO(presence[dirToIndex(+1, 0, +1)], presence[dirToIndex(0, -1, +1)],
-                                       presence[dirToIndex(+1, -1, +1)]);  // bottom left
-                voxelAO[21] = vertexAO(presence[dirToIndex(-1, 0, +1)], presence[dirToIndex(0, -1, +1)],
-                                       presence[dirToIndex(-1, -1, +1)]);  // bottom right
-                voxelAO[22] = vertexAO(presence[dirToIndex(-1, 0, +1)], presence[dirToIndex(0, +1, +1)],
-                                       presence[dirToIndex(-1, +1, +1)]);  // top right
-                voxelAO[23] = vertexAO(presence[dirToIndex(+1, 0, +1)], presence[dirToIndex(0, +1, +1)],
-                                        presence[dirToIndex(+1, +1, +1)]);  // top left
-
-                // Top
-                if (shouldMeshFace(x, y, z, 0, 1, 0, voxels)) {
-                    if (voxelAO[0] + voxelAO[2] <= voxelAO[3] + voxelAO[1]) {
-                        // Flip
-                        ao.push_back(voxelAO[0]);
-                        ao.push_back(voxelAO[1]);
-                        ao.push_back(voxelAO[3]);
-                        ao.push_back(voxelAO[3]);
-                        ao.push_back(voxelAO[1]);
-                        ao.push_back(voxelAO[2]);
-                    } else {
-                        ao.push_back(voxelAO[0]);
-                        ao.push_back(voxelAO[1]);
-                        ao.push_back(voxelAO[2]);
-                        ao.push_back(voxelAO[2]);
-                        ao.push_back(voxelAO[3]);
-                        ao.push_back(voxelAO[0]);
-                    }
-                }
+    std::vector<uint32_t> vertices;
+    vertices.resize(positions.size() / 3);
+    for (int i = 0; i < positions.size() / 3; ++i) {
+        uint32_t vertex =
+                static_cast<uint32_t>(positions[3 * i]) |
+                static_cast<uint32_t>(positions[3 * i + 1]) << VertexFormat::YShift |
+                static_cast<uint32_t>(positions[3 * i + 2]) << VertexFormat::ZShift |
+                static_cast<uint32_t>(colours[i / 6]) << VertexFormat::ColourShift |
+                static_cast<uint32_t>(normals[i]) << VertexFormat::NormalShift |
+                static_cast<uint32_t>(ao[i]) << VertexFormat::AOShift;
 
-                // Bottom
-                if (shouldMeshFace(x, y, z, 0, -1, 0, voxels)) {
-                    if (voxelAO[4] + voxelAO[6] > voxelAO[7] + voxelAO[5]) {
-                        ao.push_back(voxelAO[4]);
-                        ao.push_back(voxelAO[5]);
-                        ao.push_back(voxelAO[7]);
-                        ao.push_back(voxelAO[7]);
-                        ao.push_back(voxelAO[5]);
-                        ao.push_back(voxelAO[6]);
-                    } else {
-                        ao.push_back(voxelAO[4]);
-                        ao.push_back(voxelAO[5]);
-                        ao.push_back(voxelAO[6]);
-                        ao.push_back(voxelAO[6]);
-                        ao.push_back(voxelAO[7]);
-                        ao.push_back(voxelAO[4]);
-                    }
-                }
+        vertices[i] = vertex;
+    }
 
-                // Left
-                if (shouldMeshFace(x, y, z, -1, 0, 0, voxels)) {
-                    if (voxelAO[8] + voxelAO[10] > voxelAO[11] + voxelAO[9]) {
-                        ao.push_back(voxelAO[11]);
-                        ao.push_back(voxelAO[10]);
-                        ao.push_back(voxelAO[8]);
-                        ao.push_back(voxelAO[8]);
-                        ao.push_back(voxelAO[10]);
-                        ao.push_back(voxelAO[9]);
-                    } else {
-                        ao.push_back(voxelAO[11]);
-                        ao.push_back(voxelAO[10]);
-                        ao.push_back(voxelAO[9]);
-                        ao.push_back(voxelAO[9]);
-                        ao.push_back(voxelAO[8]);
-                        ao.push_back(voxelAO[11]);
-                    }
-                }
+    return {
+        .chunk = chunk,
+        .vertices = std::move(vertices),
+        .sections = sections
+    };
+}
 
-                // Right
-                if (shouldMeshFace(x, y, z, 1, 0, 0, voxels)) {
-                    if (voxelAO[12] + voxelAO[14] <= voxelAO[15] + voxelAO[13]) {
-                        ao.push_back(voxelAO[14]);
-                        ao.push_back(voxelAO[15]);
-                        ao.push_back(voxelAO[13]);
-                        ao.push_back(voxelAO[13]);
-                        ao.push_back(voxelAO[15]);
-                        ao.push_back(voxelAO[12]);
-                    } else {
-                        ao.push_back(voxelAO[14]);
-                        ao.push_back(voxelAO[15]);
-                        ao.push_back(voxelAO[12]);
-                        ao.push_back(voxelAO[12]);
-                        ao.push_back(voxelAO[13]);
-                        ao.push_back(voxelAO[14]);
-                    }
-                }
+void Mesher::meshColumns(const ChunkNeighbourhood& voxels, const int minY, const int maxY,
+                         std::array<ChunkSection, SectionCount>& sections, std::vector<int>& positions,
+                         std::vector<int>& colours, std::vector<int>& normals, std::vector<int>& ao) {
+    // Occupancy of every column, plus the columns just past the borders in the neighbouring chunks
+    constexpr int Size = ChunkSize + 2;
+    std::array<OccupancyMask::Column, Size * Size> solid{};
+    const auto maskIndex = [](const int x, const int z) { return (z + 1) * Size + x + 1; };
+    for (int z = -1; z <= ChunkSize; ++z) {
+        for (int x = -1; x <= ChunkSize; ++x) {
+            solid[maskIndex(x, z)] = voxels.column(x, z);
+        }
+    }
 
-                // Front
-                if (shouldMeshFace(x, y, z, 0, 0, -1, voxels)) {
-                    if (voxelAO[16] + voxelAO[18] <= voxelAO[19] + voxelAO[17]) {
-                        ao.push_back(voxelAO[16]);
-                        ao.push_back(voxelAO[17]);
-                        ao.push_back(voxelAO[19]);
-                        ao.push_back(voxelAO[19]);
-                        ao.push_back(voxelAO[17]);
-                        ao.push_back(voxelAO[18]);
-                    } else {
-                        ao.push_back(voxelAO[16]);
-                        ao.push_back(voxelAO[17]);
-                        ao.push_back(voxelAO[18]);
-                        ao.push_back(voxelAO[18]);
-                        ao.push_back(voxelAO[19]);
-                        ao.push_back(voxelAO[16]);
-                    }
-                }
+    if (minY >= maxY) {
+        return;
+    }
+    const OccupancyMask::Column range = OccupancyMask::span(minY, maxY - minY);
+
+    // A face is visible where a solid voxel meets an empty one. The voxels shifted in at either end of a column come
+    // from the chunks above and below. Each column's six face masks are followed by their union, the voxels with any
+    // face exposed. Reused between calls on the same thread, as they are too large for the stack with big chunks.
+    thread_local std::vector<std::array<OccupancyMask::Column, 7>> columnFaces;
+    columnFaces.resize(OccupancyMask::ColumnCount);
+    for (int z = 0; z < ChunkSize; ++z) {
+        for (int x = 0; x < ChunkSize; ++x) {
+            std::array<OccupancyMask::Column, 7>& faces = columnFaces[OccupancyMask::getColumnIndex(x, z)];
+            const OccupancyMask::Column column = solid[maskIndex(x, z)] & range;
+            if (column.none()) {
+                faces[6].reset();
+                continue;
+            }
 
-                // Back
-                if (shouldMeshFace(x, y, z, 0, 0, 1, voxels)) {
-                    if (voxelAO[20] + voxelAO[22] > voxelAO[23] + voxelAO[21]) {
-                        ao.push_back(voxelAO[21]);
-                        ao.push_back(voxelAO[20]);
-                        ao.push_back(voxelAO[22]);
-                        ao.push_back(voxelAO[22]);
-                        ao.push_back(voxelAO[20]);
-                        ao.push_back(voxelAO[23]);
-                    } else {
-                        ao.push_back(voxelAO[21]);
-                        ao.push_back(voxelAO[20]);
-                        ao.push_back(voxelAO[23]);
-                        ao.push_back(voxelAO[23]);
-                        ao.push_back(voxelAO[22]);
-                        ao.push_back(voxelAO[21]);
-                    }
-                }
+            OccupancyMask::Column above = solid[maskIndex(x, z)] >> 1;
+            above[ChunkHeight - 1] = voxels.isSolid(x, ChunkHeight, z);
+            OccupancyMask::Column below = solid[maskIndex(x, z)] << 1;
+            below[0] = voxels.isSolid(x, -1, z);
+
+            faces[0] = column & ~above;
+            faces[1] = column & ~below;
+            faces[2] = column & ~solid[maskIndex(x - 1, z)];
+            faces[3] = column & ~solid[maskIndex(x + 1, z)];
+            faces[4] = column & ~solid[maskIndex(x, z - 1)];
+            faces[5] = column & ~solid[maskIndex(x, z + 1)];
+            faces[6] = faces[0] | faces[1] | faces[2] | faces[3] | faces[4] | faces[5];
+        }
+    }
 
-                // Add vertices
-                int translated_vertices[VerticesLength];
-                for (int k = 0; k < 36; ++k) {
-                    translated_vertices[3 * k] = cubeVertices[3 * k] + x - 1;
-                    translated_vertices[3 * k + 1] = cubeVertices[3 * k + 1] + y;
-                    translated_vertices[3 * k + 2] = cubeVertices[3 * k + 2] + z - 1;
-                }
+    // Sections are meshed one after another, so each one's vertices form a contiguous range that can be culled and
+    // drawn on its own
+    for (int s = 0; s < SectionCount; ++s) {
+        ChunkSection& section = sections[s];
+        section.firstVertex = static_cast<uint32_t>(positions.size() / 3);
 
-                int translated_flipped_vertices[VerticesLength];
-                for (int k = 0; k < 36; ++k) {
-                    translated_flipped_vertices[3 * k] = flippedCubeVertices[3 * k] + x - 1;
-                    translated_flipped_vertices[3 * k + 1] = flippedCubeVertices[3 * k + 1] + y;
-                    translated_flipped_vertices[3 * k + 2] = flippedCubeVertices[3 * k + 2] + z - 1;
+        const int sectionMinY = std::max(minY, s << SectionHeightShift);
+        const int sectionMaxY = std::min(maxY, (s + 1) << SectionHeightShift);
+        if (sectionMinY >= sectionMaxY) {
+            continue;
+        }
+        const OccupancyMask::Column sectionRange = OccupancyMask::span(sectionMinY, sectionMaxY - sectionMinY);
+
+        std::array<int, 3> boundsMin{ChunkSize, ChunkHeight, ChunkSize};
+        std::array<int, 3> boundsMax{};
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                const std::array<OccupancyMask::Column, 7>& faces = columnFaces[OccupancyMask::getColumnIndex(x, z)];
+                if ((faces[6] & sectionRange).none()) {
+                    continue;
                 }
 
-                // Top face
-                if (shouldMeshFace(x, y, z, 0, 1, 0, voxels)) {
-                    if (voxelAO[0] + voxelAO[2] <= voxelAO[3] + voxelAO[1]) {
-                        positions.insert(positions.end(), &translated_flipped_vertices[TopFace],
-                                         &translated_flipped_vertices[TopFace + 18]);
-                    } else {
-                        positions.insert(positions.end(), &translated_vertices[TopFace],
-                                         &translated_vertices[TopFace + 18]);
+                for (int y = sectionMinY; y < sectionMaxY; ++y) {
+                    if (!faces[6][y]) {
+                        continue;
                     }
-                    for (int i = 0; i < 6; i++) {
-                        normals.push_back(TopNormal);
+
+                    FaceMask visible = 0;
+                    for (int f = 0; f < 6; ++f) {
+                        visible |= faces[f][y] << f;
                     }
+                    meshVoxel(x, y, z, voxels.load(x, y, z), visible, voxels, positions, colours, normals, ao);
 
-                    // Subtract 1 because empty voxel is 0, so we don't need a palette slot for it
-                    colours.push_back(voxel - 1);
+                    boundsMin = {std::min(boundsMin[0], x), std::min(boundsMin[1], y), std::min(boundsMin[2], z)};
+                    boundsMax = {std::max(boundsMax[0], x + 1), std::max(boundsMax[1], y + 1),
+                                 std::max(boundsMax[2], z + 1)};
                 }
+            }
+        }
 
-                // Bottom
-                if (shouldMeshFace(x, y, z, 0, -1, 0, voxels)) {
-                    if (voxelAO[4] + voxelAO[6] > voxelAO[7] + voxelAO[5]) {
-                        positions.insert(positions.end(), &translated_flipped_vertices[BottomFace],
-                                         &translated_flipped_vertices[BottomFace + 18]);
-                    } else {
-                        positions.insert(positions.end(), &translated_vertices[BottomFace],
-                                         &translated_vertices[BottomFace + 18]);
-                    }
-                    for (int i = 0; i < 6; i++) {
-                        normals.push_back(BottomNormal);
-                    }
-                    colours.push_back(voxel - 1);
-                }
+        section.numVertices = static_cast<uint32_t>(positions.size() / 3) - section.firstVertex;
+        if (section.numVertices > 0) {
+            section.boundsMin = ChunkSection::packBounds(boundsMin[0], boundsMin[1], boundsMin[2]);
+            section.boundsMax = ChunkSection::packBounds(boundsMax[0], boundsMax[1], boundsMax[2]);
+        }
+    }
+}
 
-                // Left
-                if (shouldMeshFace(x, y, z, -1, 0, 0, voxels)) {
-                    if (voxelAO[8] + voxelAO[10] > voxelAO[11] + voxelAO[9]) {
-                        positions.insert(positions.end(), &translated_flipped_vertices[LeftFace],
-                                         &translated_flipped_vertices[LeftFace + 18]);
-                    } else {
-                        positions.insert(positions.end(), &translated_vertices[LeftFace],
-                                         &translated_vertices[LeftFace + 18]);
-                    }
-                    for (int i = 0; i < 6; i++) {
-                        normals.push_back(LeftNormal);
-                    }
-                    colours.push_back(voxel - 1);
+void Mesher::meshVoxel(const int x, const int y, const int z, const Voxel voxel, const FaceMask faces,
+                       const ChunkNeighbourhood& voxels,
+                       std::vector<int>& positions, std::vector<int>& colours, std::vector<int>& normals,
+                       std::vector<int>& ao) {
+    // Ambient occlusion (computed first so that quads can be flipped if necessary)
+    // (-1, -1, -1) to (1, 1, 1)
+    std::array<bool, 27> presence{};
+    for (int i = -1; i <= 1; ++i) {
+        for (int k = -1; k <= 1; ++k) {
+            const OccupancyMask::Column column = voxels.column(x + i, z + k);
+            for (int j = -1; j <= 1; ++j) {
+                if (static_cast<unsigned int>(y + j) < ChunkHeight) {
+                    presence[dirToIndex(i, j, k)] = column[y + j];
+                } else {
+                    // The floor of the world is solid but doesn't occlude
+                    presence[dirToIndex(i, j, k)] = !(y + j < 0 && voxels.onFloor()) &&
+                                                    voxels.isSolid(x + i, y + j, z + k);
                 }
+            }
+        }
+    }
 
-                // Right
-                if (shouldMeshFace(x, y, z, 1, 0, 0, voxels)) {
-                    if (voxelAO[12] + voxelAO[14] <= voxelAO[15] + voxelAO[13]) {
-                        positions.insert(positions.end(), &translated_flipped_vertices[RightFace],
-                                         &translated_flipped_vertices[RightFace + 18]);
-                    } else {
-                        positions.insert(positions.end(), &translated_vertices[RightFace],
-                                         &translated_vertices[RightFace + 18]);
-                    }
-                    for (int i = 0; i < 6; i++) {
-                        normals.push_back(RightNormal);
-                    }
-                    colours.push_back(voxel - 1);
-                }
+    std::array<int, 24> voxelAO{};
+
+    // Top
+    voxelAO[0] = vertexAO(presence[dirToIndex(0, +1, -1)], presence[dirToIndex(-1, +1, 0)],
+                          presence[dirToIndex(-1, +1, -1)]);  // bottom left   a00
+    voxelAO[1] = vertexAO(presence[dirToIndex(0, +1, -1)], presence[dirToIndex(+1, +1, 0)],
+                          presence[dirToIndex(+1, +1, -1)]);  // bottom right  a10
+    voxelAO[2] = vertexAO(presence[dirToIndex(0, +1, +1)], presence[dirToIndex(+1, +1, 0)],
+                          presence[dirToIndex(+1, +1, +1)]);  // top right     a11
+    voxelAO[3] = vertexAO(presence[dirToIndex(0, +1, +1)], presence[dirToIndex(-1, +1, 0)],
+                          presence[dirToIndex(-1, +1, +1)]);  // top left      a01
+
+    // Bottom
+    voxelAO[4] = vertexAO(presence[dirToIndex(0, -1, -1)], presence[dirToIndex(-1, -1, 0)],
+                          presence[dirToIndex(-1, -1, -1)]);  // bottom left
+    voxelAO[5] = vertexAO(presence[dirToIndex(0, -1, -1)], presence[dirToIndex(+1, -1, 0)],
+                          presence[dirToIndex(+1, -1, -1)]);  // bottom right
+    voxelAO[6] = vertexAO(presence[dirToIndex(0, -1, +1)], presence[dirToIndex(+1, -1, 0)],
+                          presence[dirToIndex(+1, -1, +1)]);  // top right
+    voxelAO[7] = vertexAO(presence[dirToIndex(0, -1, +1)], presence[dirToIndex(-1, -1, 0)],
+                          presence[dirToIndex(-1, -1, +1)]);  // top left
+
+    // Left
+    voxelAO[8] = vertexAO(presence[dirToIndex(-1, 0, +1)], presence[dirToIndex(-1, -1, 0)],
+                          presence[dirToIndex(-1, -1, +1)]);  // bottom left
+    voxelAO[9] = vertexAO(presence[dirToIndex(-1, 0, -1)], presence[dirToIndex(-1, -1, 0)],
+                           presence[dirToIndex(-1, -1, -1)]);  // bottom right
+    voxelAO[10] = vertexAO(presence[dirToIndex(-1, 0, -1)], presence[dirToIndex(-1, +1, 0)],
+                           presence[dirToIndex(-1, +1, -1)]);  // top right
+    voxelAO[11] = vertexAO(presence[dirToIndex(-1, 0, +1)], presence[dirToIndex(-1, +1, 0)],
+                           presence[dirToIndex(-1, +1, +1)]);  // top left
+
+    // Right
+    voxelAO[12] = vertexAO(presence[dirToIndex(+1, 0, -1)], presence[dirToIndex(+1, -1, 0)],
+                           presence[dirToIndex(+1, -1, -1)]);  // bottom left
+    voxelAO[13] = vertexAO(presence[dirToIndex(+1, 0, +1)], presence[dirToIndex(+1, -1, 0)],
+                           presence[dirToIndex(+1, -1, +1)]);  // bottom right
+    voxelAO[14] = vertexAO(presence[dirToIndex(+1, 0, +1)], presence[dirToIndex(+1, +1, 0)],
+                           presence[dirToIndex(+1, +1, +1)]);  // top right
+    voxelAO[15] = vertexAO(presence[dirToIndex(+1, 0, -1)], presence[dirToIndex(+1, +1, 0)],
+                           presence[dirToIndex(+1, +1, -1)]);  // top left
+
+    // Front
+    voxelAO[16] = vertexAO(presence[dirToIndex(-1, 0, -1)], presence[dirToIndex(0, -1, -1)],
+                           presence[dirToIndex(-1, -1, -1)]);  // bottom left
+    voxelAO[17] = vertexAO(presence[dirToIndex(+1, 0, -1)], presence[dirToIndex(0, -1, -1)],
+                           presence[dirToIndex(+1, -1, -1)]);  // bottom right
+    voxelAO[18] = vertexAO(presence[dirToIndex(+1, 0, -1)], presence[dirToIndex(0, +1, -1)],
+                           presence[dirToIndex(+1, +1, -1)]);  // top right
+    voxelAO[19] = vertexAO(presence[dirToIndex(-1, 0, -1)], presence[dirToIndex(0, +1, -1)],
+                            presence[dirToIndex(-1, +1, -1)]);  // top left
+
+    // Back
+    voxelAO[20] = vertexAO(presence[dirToIndex(+1, 0, +1)], presence[dirToIndex(0, -1, +1)],
+                           presence[dirToIndex(+1, -1, +1)]);  // bottom left
+    voxelAO[21] = vertexAO(presence[dirToIndex(-1, 0, +1)], presence[dirToIndex(0, -1, +1)],
+                           presence[dirToIndex(-1, -1, +1)]);  // bottom right
+    voxelAO[22] = vertexAO(presence[dirToIndex(-1, 0, +1)], presence[dirToIndex(0, +1, +1)],
+                           presence[dirToIndex(-1, +1, +1)]);  // top right
+    voxelAO[23] = vertexAO(presence[dirToIndex(+1, 0, +1)], presence[dirToIndex(0, +1, +1)],
+                            presence[dirToIndex(+1, +1, +1)]);  // top left
+
+    // Top
+    if (faces & TopBit) {
+        if (voxelAO[0] + voxelAO[2] <= voxelAO[3] + voxelAO[1]) {
+            // Flip
+            ao.push_back(voxelAO[0]);
+            ao.push_back(voxelAO[1]);
+            ao.push_back(voxelAO[3]);
+            ao.push_back(voxelAO[3]);
+            ao.push_back(voxelAO[1]);
+            ao.push_back(voxelAO[2]);
+        } else {
+            ao.push_back(voxelAO[0]);
+            ao.push_back(voxelAO[1]);
+            ao.push_back(voxelAO[2]);
+            ao.push_back(voxelAO[2]);
+            ao.push_back(voxelAO[3]);
+            ao.push_back(voxelAO[0]);
+        }
+    }
 
-                // Front
-                if (shouldMeshFace(x, y, z, 0, 0, -1, voxels)) {
-                    if (voxelAO[16] + voxelAO[18] <= voxelAO[19] + voxelAO[17]) {
-                        positions.insert(positions.end(), &translated_flipped_vertices[FrontFace],
-                                         &translated_flipped_vertices[FrontFace + 18]);
-                    } else {
-                        positions.insert(positions.end(), &translated_vertices[FrontFace],
-                                         &translated_vertices[FrontFace + 18]);
-                    }
-                    for (int i = 0; i < 6; i++) {
-                        normals.push_back(FrontNormal);
-                    }
-                    colours.push_back(voxel - 1);
-                }
+    // Bottom
+    if (faces & BottomBit) {
+        if (voxelAO[4] + voxelAO[6] > voxelAO[7] + voxelAO[5]) {
+            ao.push_back(voxelAO[4]);
+            ao.push_back(voxelAO[5]);
+            ao.push_back(voxelAO[7]);
+            ao.push_back(voxelAO[7]);
+            ao.push_back(voxelAO[5]);
+            ao.push_back(voxelAO[6]);
+        } else {
+            ao.push_back(voxelAO[4]);
+            ao.push_back(voxelAO[5]);
+            ao.push_back(voxelAO[6]);
+            ao.push_back(voxelAO[6]);
+            ao.push_back(voxelAO[7]);
+            ao.push_back(voxelAO[4]);
+        }
+    }
 
-                // Back
-                if (shouldMeshFace(x, y, z, 0, 0, 1, voxels)) {
-                    if (voxelAO[20] + voxelAO[22] > voxelAO[23] + voxelAO[21]) {
-                        positions.insert(positions.end(), &translated_flipped_vertices[BackFace],
-                                         &translated_flipped_vertices[BackFace + 18]);
-                    } else {
-                        positions.insert(positions.end(), &translated_vertices[BackFace],
-                                         &translated_vertices[BackFace + 18]);
-                    }
-                    for (int i = 0; i < 6; i++) {
-                        normals.push_back(BackNormal);
-                    }
-                    colours.push_back(voxel - 1);
-                }
-            }
+    // Left
+    if (faces & LeftBit) {
+        if (voxelAO[8] + voxelAO[10] > voxelAO[11] + voxelAO[9]) {
+            ao.push_back(voxelAO[11]);
+            ao.push_back(voxelAO[10]);
+            ao.push_back(voxelAO[8]);
+            ao.push_back(voxelAO[8]);
+            ao.push_back(voxelAO[10]);
+            ao.push_back(voxelAO[9]);
+        } else {
+            ao.push_back(voxelAO[11]);
+            ao.push_back(voxelAO[10]);
+            ao.push_back(voxelAO[9]);
+            ao.push_back(voxelAO[9]);
+            ao.push_back(voxelAO[8]);
+            ao.push_back(voxelAO[11]);
         }
     }
 
-    std::vector<uint32_t> vertices;
-    vertices.resize(positions.size() / 3);
-    for (int i = 0; i < positions.size() / 3; ++i) {
-        uint32_t vertex =
-                static_cast<uint32_t>(positions[3 * i]) |
-                static_cast<uint32_t>(positions[3 * i + 1]) << VertexFormat::YShift |
-                static_cast<uint32_t>(positions[3 * i + 2]) << VertexFormat::ZShift |
-                static_cast<uint32_t>(colours[i / 6]) << VertexFormat::ColourShift |
-                static_cast<uint32_t>(normals[i]) << VertexFormat::NormalShift |
-                static_cast<uint32_t>(ao[i]) << VertexFormat::AOShift;
+    // Right
+    if (faces & RightBit) {
+        if (voxelAO[12] + voxelAO[14] <= voxelAO[15] + voxelAO[13]) {
+            ao.push_back(voxelAO[14]);
+            ao.push_back(voxelAO[15]);
+            ao.push_back(voxelAO[13]);
+            ao.push_back(voxelAO[13]);
+            ao.push_back(voxelAO[15]);
+            ao.push_back(voxelAO[12]);
+        } else {
+            ao.push_back(voxelAO[14]);
+            ao.push_back(voxelAO[15]);
+            ao.push_back(voxelAO[12]);
+            ao.push_back(voxelAO[12]);
+            ao.push_back(voxelAO[13]);
+            ao.push_back(voxelAO[14]);
+        }
+    }
 
-        vertices[i] = vertex;
+    // Front
+    if (faces & FrontBit) {
+        if (voxelAO[16] + voxelAO[18] <= voxelAO[19] + voxelAO[17]) {
+            ao.push_back(voxelAO[16]);
+            ao.push_back(voxelAO[17]);
+            ao.push_back(voxelAO[19]);
+            ao.push_back(voxelAO[19]);
+            ao.push_back(voxelAO[17]);
+            ao.push_back(voxelAO[18]);
+        } else {
+            ao.push_back(voxelAO[16]);
+            ao.push_back(voxelAO[17]);
+            ao.push_back(voxelAO[18]);
+            ao.push_back(voxelAO[18]);
+            ao.push_back(voxelAO[19]);
+            ao.push_back(voxelAO[16]);
+        }
     }
 
-    return {
-        .chunk = chunk,
-        .vertices = std::move(vertices)
-    };
-}
+    // Back
+    if (faces & BackBit) {
+        if (voxelAO[20] + voxelAO[22] > voxelAO[23] + voxelAO[21]) {
+            ao.push_back(voxelAO[21]);
+            ao.push_back(voxelAO[20]);
+            ao.push_back(voxelAO[22]);
+            ao.push_back(voxelAO[22]);
+            ao.push_back(voxelAO[20]);
+            ao.push_back(voxelAO[23]);
+        } else {
+            ao.push_back(voxelAO[21]);
+            ao.push_back(voxelAO[20]);
+            ao.push_back(voxelAO[23]);
+            ao.push_back(voxelAO[23]);
+            ao.push_back(voxelAO[22]);
+            ao.push_back(voxelAO[21]);
+        }
+    }
 
-bool Mesher::shouldMeshFace(const int x, const int y, const int z, const int i, const int j, const int k, const std::vector<int>& voxels) {
-    const bool adjInBounds = y + j >= 0 && y + j < ChunkHeight + 1;
+    // Add vertices
+    int translated_vertices[VerticesLength];
+    for (int k = 0; k < 36; ++k) {
+        translated_vertices[3 * k] = cubeVertices[3 * k] + x;
+        translated_vertices[3 * k + 1] = cubeVertices[3 * k + 1] + y;
+        translated_vertices[3 * k + 2] = cubeVertices[3 * k + 2] + z;
+    }
 
-    bool isAdjVoxelEmpty = true;
-    if (adjInBounds) {
-        isAdjVoxelEmpty = voxels[Chunk::getVoxelIndex(x + i, y + j, z + k)] == 0;
+    int translated_flipped_vertices[VerticesLength];
+    for (int k = 0; k < 36; ++k) {
+        translated_flipped_vertices[3 * k] = flippedCubeVertices[3 * k] + x;
+        translated_flipped_vertices[3 * k + 1] = flippedCubeVertices[3 * k + 1] + y;
+        translated_flipped_vertices[3 * k + 2] = flippedCubeVertices[3 * k + 2] + z;
     }
 
-    return adjInBounds && isAdjVoxelEmpty;
+    // Top face
+    if (faces & TopBit) {
+        if (voxelAO[0] + voxelAO[2] <= voxelAO[3] + voxelAO[1]) {
+            positions.insert(positions.end(), &translated_flipped_vertices[TopFace],
+                             &translated_flipped_vertices[TopFace + 18]);
+        } else {
+            positions.insert(positions.end(), &translated_vertices[TopFace],
+                             &translated_vertices[TopFace + 18]);
+        }
+        for (int i = 0; i < 6; i++) {
+            normals.push_back(TopNormal);
+        }
+
+        // Subtract 1 because empty voxel is 0, so we don't need a palette slot for it
+        colours.push_back(voxel - 1);
+    }
+
+    // Bottom
+    if (faces & BottomBit) {
+        if (voxelAO[4] + voxelAO[6] > voxelAO[7] + voxelAO[5]) {
+            positions.insert(positions.end(), &translated_flipped_vertices[BottomFace],
+                             &translated_flipped_vertices[BottomFace + 18]);
+        } else {
+            positions.insert(positions.end(), &translated_vertices[BottomFace],
+                             &translated_vertices[BottomFace + 18]);
+        }
+        for (int i = 0; i < 6; i++) {
+            normals.push_back(BottomNormal);
+        }
+        colours.push_back(voxel - 1);
+    }
+
+    // Left
+    if (faces & LeftBit) {
+        if (voxelAO[8] + voxelAO[10] > voxelAO[11] + voxelAO[9]) {
+            positions.insert(positions.end(), &translated_flipped_vertices[LeftFace],
+                             &translated_flipped_vertices[LeftFace + 18]);
+        } else {
+            positions.insert(positions.end(), &translated_vertices[LeftFace],
+                             &translated_vertices[LeftFace + 18]);
+        }
+        for (int i = 0; i < 6; i++) {
+            normals.push_back(LeftNormal);
+        }
+        colours.push_back(voxel - 1);
+    }
+
+    // Right
+    if (faces & RightBit) {
+        if (voxelAO[12] + voxelAO[14] <= voxelAO[15] + voxelAO[13]) {
+            positions.insert(positions.end(), &translated_flipped_vertices[RightFace],
+                             &translated_flipped_vertices[RightFace + 18]);
+        } else {
+            positions.insert(positions.end(), &translated_vertices[RightFace],
+                             &translated_vertices[RightFace + 18]);
+        }
+        for (int i = 0; i < 6; i++) {
+            normals.push_back(RightNormal);
+        }
+        colours.push_back(voxel - 1);
+    }
+
+    // Front
+    if (faces & FrontBit) {
+        if (voxelAO[16] + voxelAO[18] <= voxelAO[19] + voxelAO[17]) {
+            positions.insert(positions.end(), &translated_flipped_vertices[FrontFace],
+                             &translated_flipped_vertices[FrontFace + 18]);
+        } else {
+            positions.insert(positions.end(), &translated_vertices[FrontFace],
+                             &translated_vertices[FrontFace + 18]);
+        }
+        for (int i = 0; i < 6; i++) {
+            normals.push_back(FrontNormal);
+        }
+        colours.push_back(voxel - 1);
+    }
+
+    // Back
+    if (faces & BackBit) {
+        if (voxelAO[20] + voxelAO[22] > voxelAO[23] + voxelAO[21]) {
+            positions.insert(positions.end(), &translated_flipped_vertices[BackFace],
+                             &translated_flipped_vertices[BackFace + 18]);
+        } else {
+            positions.insert(positions.end(), &translated_vertices[BackFace],
+                             &translated_vertices[BackFace + 18]);
+        }
+        for (int i = 0; i < 6; i++) {
+            normals.push_back(BackNormal);
+        }
+        colours.push_back(voxel - 1);
+    }
 }
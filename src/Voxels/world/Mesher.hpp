@@ -1,25 +1,38 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <cstdint>
 
 #include "Chunk.hpp"
+#include "ChunkNeighbourhood.hpp"
+#include "ChunkSection.hpp"
 
 class Mesher {
 public:
     struct MeshResult {
         std::shared_ptr<Chunk> chunk;
-        std::vector<uint32_t> vertices;
+        std::vector<uint32_t> vertices;  // Grouped by section, bottom section first
+        std::array<ChunkSection, SectionCount> sections{};
+        uint64_t request = 0;  // Which of the chunk's mesh requests this answers (see Chunk::meshRequests)
+        int lod = 0;  // Level of detail of those voxels
     };
 
-    [[nodiscard]] static MeshResult meshChunk(const std::shared_ptr<Chunk>& chunk, const std::vector<int>& voxels, int minY, int maxY);
+    // Bit per face of a voxel, set when the face is visible
+    using FaceMask = uint8_t;
+
+    [[nodiscard]] static MeshResult meshChunk(const std::shared_ptr<Chunk>& chunk, const ChunkNeighbourhood& voxels, int minY, int maxY);
 
 private:
-    static inline int vertexAO(uint8_t side1, uint8_t side2, uint8_t corner);
+    static void meshColumns(const ChunkNeighbourhood& voxels, int minY, int maxY,
+                            std::array<ChunkSection, SectionCount>& sections, std::vector<int>& positions,
+                            std::vector<int>& colours, std::vector<int>& normals, std::vector<int>& ao);
 
-    static bool inBounds(int x, int y, int z);
+    static void meshVoxel(int x, int y, int z, Voxel voxel, FaceMask faces, const ChunkNeighbourhood& voxels,
+                          std::vector<int>& positions, std::vector<int>& colours, std::vector<int>& normals,
+                          std::vector<int>& ao);
 
-    static int dirToIndex(int i, int j, int k);
+    static inline int vertexAO(uint8_t side1, uint8_t side2, uint8_t corner);
 
-    static bool shouldMeshFace(int x, int y, int z, int i, int j, int k, const std::vector<int>& voxels);
+    static int dirToIndex(int i, int j, int k);
 };
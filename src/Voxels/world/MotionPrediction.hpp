@@ -0,0 +1,38 @@
+#pragma once
+
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+// Where the player is heading: the straight line they'd follow over the next few seconds at their current velocity,
+// relative to wherever they are, and the direction they're looking in. Streaming prefetches chunks along the line and
+// in view first, so chunks ahead of a fast moving player are ready by the time they get there.
+struct MotionPrediction {
+    glm::vec3 offset{};         // From the player to the end of the line
+    glm::vec3 lookDirection{};  // Unit length, or zero if the player isn't looking anywhere in particular
+
+    // The line is cut off at maxLength, past which nothing is streamed in anyway
+    static MotionPrediction fromVelocity(const glm::vec3& velocity, const glm::vec3& lookDirection, const float seconds,
+                                         const float maxLength) {
+        glm::vec3 offset = velocity * std::max(seconds, 0.0f);
+        if (const float length = glm::length(offset); length > maxLength) {
+            offset *= maxLength / length;
+        }
+        const float look = glm::length(lookDirection);
+        return {offset, look > 0.0f ? lookDirection / look : glm::vec3()};
+    }
+
+    // The point of the line from position nearest to point
+    [[nodiscard]] glm::vec3 nearestPoint(const glm::vec3& position, const glm::vec3& point) const {
+        const float lengthSquared = glm::dot(offset, offset);
+        if (lengthSquared == 0.0f) {
+            return position;
+        }
+        return position + offset * std::clamp(glm::dot(point - position, offset) / lengthSquared, 0.0f, 1.0f);
+    }
+
+    // Whether point is more than margin behind the player at position
+    [[nodiscard]] bool isBehind(const glm::vec3& position, const glm::vec3& point, const float margin) const {
+        return glm::dot(point - position, lookDirection) < -margin;
+    }
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+#include "ChunkConstants.hpp"
+
+// One bit per voxel of a chunk, set where the voxel is solid. Bits are grouped into a ChunkHeight-bit mask per (x, z)
+// column, so vertical neighbours are a shift away and horizontal neighbours are a single AND of two columns.
+//
+// A heightmap of the top of each column is kept up to date alongside. Solid stores raise it in O(1); only clearing the
+// top voxel of a column has to scan down for the new top, which is usually a voxel or two below.
+class OccupancyMask {
+public:
+    using Column = std::bitset<ChunkHeight>;
+
+    static constexpr size_t ColumnCount = ChunkSize * ChunkSize;
+
+    // x and z are in [0, ChunkSize)
+    [[nodiscard]] const Column& column(const size_t x, const size_t z) const {
+        return columns[getColumnIndex(x, z)];
+    }
+
+    [[nodiscard]] bool isSolid(const size_t x, const size_t y, const size_t z) const {
+        return columns[getColumnIndex(x, z)][y];
+    }
+
+    // One above the highest solid voxel in column (x, z), or 0 if the column is empty
+    [[nodiscard]] int height(const size_t x, const size_t z) const {
+        return heights[getColumnIndex(x, z)];
+    }
+
+    void set(const size_t x, const size_t y, const size_t z, const bool solid) {
+        const size_t index = getColumnIndex(x, z);
+        columns[index][y] = solid;
+        if (solid) {
+            heights[index] = std::max(heights[index], static_cast<uint16_t>(y + 1));
+        } else if (y + 1 == heights[index]) {
+            heights[index] = top(columns[index], y);
+        }
+    }
+
+    // Sets layers [yBegin, yEnd) of column (x, z)
+    void fillColumn(const size_t x, const size_t z, const size_t yBegin, const size_t yEnd, const bool solid) {
+        const size_t index = getColumnIndex(x, z);
+        const Column layers = span(yBegin, yEnd - yBegin);
+        if (solid) {
+            columns[index] |= layers;
+            heights[index] = std::max(heights[index], static_cast<uint16_t>(yEnd));
+        } else {
+            columns[index] &= ~layers;
+            if (yBegin < heights[index] && heights[index] <= yEnd) {
+                heights[index] = top(columns[index], yBegin);
+            }
+        }
+    }
+
+    // height is that of the column, as the caller building it usually knows it already
+    void setColumn(const size_t x, const size_t z, const Column& column, const int height) {
+        const size_t index = getColumnIndex(x, z);
+        columns[index] = column;
+        heights[index] = static_cast<uint16_t>(height);
+    }
+
+    // Sets layers [yBegin, yEnd) of every column
+    void fillLayers(const size_t yBegin, const size_t yEnd, const bool solid) {
+        const Column layers = span(yBegin, yEnd - yBegin);
+        for (size_t i = 0; i < ColumnCount; ++i) {
+            if (solid) {
+                columns[i] |= layers;
+                heights[i] = std::max(heights[i], static_cast<uint16_t>(yEnd));
+            } else {
+                columns[i] &= ~layers;
+                if (yBegin < heights[i] && heights[i] <= yEnd) {
+                    heights[i] = top(columns[i], yBegin);
+                }
+            }
+        }
+    }
+
+    // Mask with layers [yBegin, yBegin + length) set
+    static Column span(const size_t yBegin, const size_t length) {
+        return ~Column{} >> (ChunkHeight - length) << yBegin;
+    }
+
+    static size_t getColumnIndex(const size_t x, const size_t z) {
+        return z * ChunkSize + x;
+    }
+
+private:
+    std::array<Column, ColumnCount> columns{};
+    std::array<uint16_t, ColumnCount> heights{};
+
+    // Height of a column with no solid voxels at or above from
+    static uint16_t top(const Column& column, size_t from) {
+        while (from > 0 && !column[from - 1]) {
+            --from;
+        }
+        return static_cast<uint16_t>(from);
+    }
+};
@@ -0,0 +1,229 @@
+#include "PaletteStorage.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+
+PaletteStorage::PaletteStorage(const size_t size, const Voxel initial)
+    : count(size), uniform(initial)
+{}
+
+PaletteStorage::~PaletteStorage() {
+    palettePool().release(std::move(palette));
+    wordPool().release(std::move(words));
+}
+
+PaletteStorage::PaletteStorage(const PaletteStorage& other)
+    : count(other.count), bits(other.bits), bitsShift(other.bitsShift), entriesPerWordShift(other.entriesPerWordShift),
+      uniform(other.uniform), palette(palettePool().reserve(other.palette.capacity())),
+      words(wordPool().acquire(other.words.size()))
+{
+    palette.assign(other.palette.begin(), other.palette.end());
+    std::ranges::copy(other.words, words.begin());
+}
+
+PaletteStorage::PaletteStorage(PaletteStorage&& other) noexcept
+    : count(other.count), bits(other.bits), bitsShift(other.bitsShift), entriesPerWordShift(other.entriesPerWordShift),
+      uniform(other.uniform), palette(std::move(other.palette)), words(std::move(other.words))
+{
+    other.bits = 0;
+}
+
+PaletteStorage& PaletteStorage::operator=(const PaletteStorage& other) {
+    if (this != &other) {
+        *this = PaletteStorage(other);
+    }
+    return *this;
+}
+
+PaletteStorage& PaletteStorage::operator=(PaletteStorage&& other) noexcept {
+    if (this != &other) {
+        palettePool().release(std::move(palette));
+        wordPool().release(std::move(words));
+        count = other.count;
+        bits = other.bits;
+        bitsShift = other.bitsShift;
+        entriesPerWordShift = other.entriesPerWordShift;
+        uniform = other.uniform;
+        palette = std::move(other.palette);
+        words = std::move(other.words);
+        other.bits = 0;
+    }
+    return *this;
+}
+
+void PaletteStorage::store(const size_t index, const Voxel v) {
+    const uint32_t paletteIndex = paletteIndexOf(v);
+    if (bits == 0) {
+        return;
+    }
+
+    setIndex(index, paletteIndex);
+}
+
+void PaletteStorage::store(const std::span<const size_t> indices, const Voxel v) {
+    if (indices.empty()) {
+        return;
+    }
+
+    const uint32_t paletteIndex = paletteIndexOf(v);
+    if (bits == 0) {
+        return;
+    }
+
+    for (const size_t index : indices) {
+        setIndex(index, paletteIndex);
+    }
+}
+
+void PaletteStorage::fill(const Voxel v) {
+    uniform = v;
+    palettePool().release(std::move(palette));
+    wordPool().release(std::move(words));
+    bits = 0;
+}
+
+void PaletteStorage::fill(size_t begin, const size_t end, const Voxel v) {
+    if (begin >= end) {
+        return;
+    }
+    if (begin == 0 && end == count) {
+        fill(v);
+        return;
+    }
+
+    const uint32_t paletteIndex = paletteIndexOf(v);
+    if (bits == 0) {
+        return;
+    }
+
+    // The index repeated across a whole word
+    const uint64_t pattern = paletteIndex * (~uint64_t{0} / mask());
+    const size_t entries = entriesPerWord();
+    for (; begin < end && (begin & (entries - 1)) != 0; ++begin) {
+        setIndex(begin, paletteIndex);
+    }
+    for (; begin + entries <= end; begin += entries) {
+        words[begin >> entriesPerWordShift] = pattern;
+    }
+    for (; begin < end; ++begin) {
+        setIndex(begin, paletteIndex);
+    }
+}
+
+void PaletteStorage::compact() {
+    if (bits == 0) {
+        return;
+    }
+
+    // Reused between calls on the same thread, so compacting doesn't allocate once warmed up
+    constexpr uint32_t Unused = std::numeric_limits<uint32_t>::max();
+    thread_local std::vector<uint32_t> remap;
+    remap.assign(palette.size(), Unused);
+    size_t used = 0;
+    // Usually every entry is still in use, which shows up long before the end of the section
+    for (size_t i = 0; i < count && used < palette.size(); ++i) {
+        if (uint32_t& entry = remap[indexAt(i)]; entry == Unused) {
+            entry = 0;
+            ++used;
+        }
+    }
+
+    // Move the used entries to the front of the palette, keeping their order
+    size_t newSize = 0;
+    for (size_t p = 0; p < palette.size(); ++p) {
+        if (remap[p] != Unused) {
+            remap[p] = static_cast<uint32_t>(newSize);
+            palette[newSize++] = palette[p];
+        }
+    }
+
+    if (newSize == palette.size()) {
+        return;
+    }
+
+    if (newSize == 1) {
+        fill(palette[0]);
+        return;
+    }
+
+    int newBits = 1;
+    while (newSize > size_t{1} << newBits) {
+        newBits *= 2;
+    }
+
+    palette.resize(newSize);
+    repack(newBits, remap);
+}
+
+size_t PaletteStorage::memoryUsage() const {
+    return sizeof(PaletteStorage) + palette.capacity() * sizeof(Voxel) + words.capacity() * sizeof(uint64_t);
+}
+
+BufferPool<uint64_t>& PaletteStorage::wordPool() {
+    static BufferPool<uint64_t> pool;
+    return pool;
+}
+
+BufferPool<Voxel>& PaletteStorage::palettePool() {
+    static BufferPool<Voxel> pool;
+    return pool;
+}
+
+uint32_t PaletteStorage::paletteIndexOf(const Voxel v) {
+    if (bits == 0) {
+        if (v == uniform) {
+            return 0;
+        }
+
+        palette = palettePool().reserve(2);
+        palette.push_back(uniform);
+        palette.push_back(v);
+        repack(1, {});
+        return 1;
+    }
+
+    if (const auto it = std::ranges::find(palette, v); it != palette.end()) {
+        return static_cast<uint32_t>(it - palette.begin());
+    }
+
+    // Widen the indices if the new palette entry doesn't fit (1 -> 2 -> 4 -> 8 -> 16 bits). The palette always has
+    // room for 1 << bits entries, so pushing onto it never reallocates.
+    if (palette.size() == size_t{1} << bits) {
+        const int newBits = bits * 2;
+        assert(newBits <= MaxBits && "PaletteStorage: too many distinct voxel types");
+
+        std::vector<Voxel> newPalette = palettePool().reserve(size_t{1} << newBits);
+        newPalette.assign(palette.begin(), palette.end());
+        palettePool().release(std::move(palette));
+        palette = std::move(newPalette);
+
+        repack(newBits, {});
+    }
+
+    palette.push_back(v);
+    return static_cast<uint32_t>(palette.size() - 1);
+}
+
+void PaletteStorage::repack(const int newBits, const std::span<const uint32_t> remap) {
+    const size_t newBitsShift = std::countr_zero(static_cast<unsigned int>(newBits));
+    const size_t newEntriesPerWordShift = 6 - newBitsShift;
+    const size_t newEntriesPerWord = size_t{1} << newEntriesPerWordShift;
+
+    std::vector<uint64_t> newWords = wordPool().acquire((count + newEntriesPerWord - 1) >> newEntriesPerWordShift);
+
+    // Existing indices are all 0 when bits == 0, which is already what newWords holds
+    if (bits != 0) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t paletteIndex = remap.empty() ? indexAt(i) : remap[indexAt(i)];
+            newWords[i >> newEntriesPerWordShift] |= paletteIndex << ((i & (newEntriesPerWord - 1)) << newBitsShift);
+        }
+    }
+
+    wordPool().release(std::move(words));
+    words = std::move(newWords);
+    bits = newBits;
+    bitsShift = newBitsShift;
+    entriesPerWordShift = newEntriesPerWordShift;
+}
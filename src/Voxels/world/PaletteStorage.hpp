@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ChunkConstants.hpp"
+#include "../core/BufferPool.hpp"
+
+// Fixed-size voxel array stored as indices into a small local palette.
+// Indices are bit-packed into 64-bit words using 0, 1, 2, 4, 8 or 16 bits per voxel, so an index never straddles
+// a word boundary. While only a single voxel type is present neither a palette nor any words are allocated. The bit
+// width grows automatically when a store introduces a type that does not fit in the current palette.
+// Palettes and word buffers are taken from and returned to shared pools, so chunks that are streamed in and out reuse
+// them rather than allocating.
+class PaletteStorage {
+public:
+    explicit PaletteStorage(size_t size = 0, Voxel initial = EmptyVoxel);
+    ~PaletteStorage();
+
+    // A moved-from storage is left uniform
+    PaletteStorage(const PaletteStorage& other);
+    PaletteStorage(PaletteStorage&& other) noexcept;
+    PaletteStorage& operator=(const PaletteStorage& other);
+    PaletteStorage& operator=(PaletteStorage&& other) noexcept;
+
+    [[nodiscard]] Voxel load(const size_t index) const {
+        if (bits == 0) {
+            return uniform;
+        }
+
+        const size_t word = index >> entriesPerWordShift;
+        const size_t shift = (index & (entriesPerWord() - 1)) << bitsShift;
+        return palette[words[word] >> shift & mask()];
+    }
+
+    void store(size_t index, Voxel v);
+
+    // Set every entry in indices to v, looking v up in the palette once
+    void store(std::span<const size_t> indices, Voxel v);
+
+    // Replace every entry with v, releasing the packed words
+    void fill(Voxel v);
+
+    // Set entries [begin, end) to v, a whole word at a time where the range covers one
+    void fill(size_t begin, size_t end, Voxel v);
+
+    // Drop palette entries that are no longer referenced and narrow the indices to match
+    void compact();
+
+    [[nodiscard]] bool isUniform() const { return bits == 0; }
+    [[nodiscard]] Voxel uniformValue() const { return uniform; }
+
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] int bitsPerIndex() const { return bits; }
+    [[nodiscard]] size_t paletteSize() const { return bits == 0 ? 1 : palette.size(); }
+    [[nodiscard]] size_t memoryUsage() const;
+
+    static BufferPool<uint64_t>& wordPool();
+    static BufferPool<Voxel>& palettePool();
+
+private:
+    static constexpr int MaxBits = 16;
+
+    size_t count;
+    int bits = 0;
+    size_t bitsShift = 0;            // log2(bits), valid when bits > 0
+    size_t entriesPerWordShift = 0;  // log2(64 / bits), valid when bits > 0
+
+    Voxel uniform;
+    std::vector<Voxel> palette;  // Empty while uniform
+    std::vector<uint64_t> words;
+
+    [[nodiscard]] size_t entriesPerWord() const { return size_t{1} << entriesPerWordShift; }
+    [[nodiscard]] uint64_t mask() const { return (uint64_t{1} << bits) - 1; }
+    [[nodiscard]] uint32_t indexAt(const size_t i) const {
+        return static_cast<uint32_t>(words[i >> entriesPerWordShift] >> ((i & (entriesPerWord() - 1)) << bitsShift) & mask());
+    }
+
+    uint32_t paletteIndexOf(Voxel v);
+
+    void setIndex(const size_t index, const uint32_t paletteIndex) {
+        const size_t word = index >> entriesPerWordShift;
+        const size_t shift = (index & (entriesPerWord() - 1)) << bitsShift;
+        words[word] = (words[word] & ~(mask() << shift)) | static_cast<uint64_t>(paletteIndex) << shift;
+    }
+
+    // An empty remap keeps every index as it is
+    void repack(int newBits, std::span<const uint32_t> remap);
+};
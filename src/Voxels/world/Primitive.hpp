@@ -9,8 +9,8 @@
 #include "Chunk.hpp"
 
 struct Edit {
-    int voxelType;
-    int oldVoxelType;
+    Voxel voxelType;
+    Voxel oldVoxelType;
 };
 
 struct IVec3Hash {
@@ -23,21 +23,21 @@ struct Primitive {
     virtual ~Primitive() = default;
 
     using EditMap = std::unordered_map<glm::ivec3, std::optional<Edit>, IVec3Hash>;
-    using UserEditMap = std::unordered_map<glm::ivec3, int, IVec3Hash>;
+    using UserEditMap = std::unordered_map<glm::ivec3, Voxel, IVec3Hash>;
 
     [[nodiscard]] virtual EditMap generateEdits() = 0;
     [[nodiscard]] virtual bool isPosInside(const glm::ivec3& pos) const = 0;
 
     EditMap edits;  // global pos -> optional Edit
     UserEditMap userEdits;  // local pos -> voxelType
-    int voxelType{};
+    Voxel voxelType{};
     glm::ivec3 origin{};
     glm::ivec3 start{};
     glm::ivec3 end{};
 };
 
 struct Cuboid : Primitive {
-    Cuboid(const int voxelType, const glm::ivec3& start, const glm::ivec3& end) {
+    Cuboid(const Voxel voxelType, const glm::ivec3& start, const glm::ivec3& end) {
         this->start = glm::min(start, end);
         this->end = glm::max(start, end);
         this->voxelType = voxelType;
@@ -46,14 +46,14 @@ struct Cuboid : Primitive {
     EditMap generateEdits() override {
         EditMap editMap;
         for (int x = start.x; x <= end.x; ++x) {
-            for (int y = std::max(0, start.y); y <= std::min(ChunkHeight, end.y); ++y) {
+            for (int y = std::max(0, start.y); y <= std::min(WorldHeight, end.y); ++y) {
                 for (int z = start.z; z <= end.z; ++z) {
                     const int wx = origin.x + x;
                     const int wy = origin.y + y;
                     const int wz = origin.z + z;
 
                     const auto it = userEdits.find(glm::ivec3(x, y, z));
-                    const int voxelType = it != userEdits.end() ? it->second : this->voxelType;
+                    const Voxel voxelType = it != userEdits.end() ? it->second : this->voxelType;
                     if (voxelType == 0) {
                         // There still needs to be an entry for this position, but there is just no edit there
                         editMap[{wx, wy, wz}] = std::nullopt;
@@ -76,7 +76,7 @@ struct Cuboid : Primitive {
 };
 
 struct Sphere : Primitive {
-    explicit Sphere(const int voxelType, const glm::ivec3& origin, const int r) : radius(r) {
+    explicit Sphere(const Voxel voxelType, const glm::ivec3& origin, const int r) : radius(r) {
         this->voxelType = voxelType;
         this->origin = origin;
         this->start = glm::ivec3(-radius);
@@ -91,11 +91,11 @@ struct Sphere : Primitive {
         // oy + y >= 0
         // y >= -oy
 
-        // oy + y < ChunkHeight
-        // y < ChunkHeight - oy
+        // oy + y < WorldHeight
+        // y < WorldHeight - oy
 
         for (int x = -radius; x <= radius; ++x) {
-            for (int y = std::max(-origin.y, -radius); y <= std::min(ChunkHeight - origin.y, radius); ++y) {
+            for (int y = std::max(-origin.y, -radius); y <= std::min(WorldHeight - origin.y, radius); ++y) {
                 for (int z = -radius; z <= radius; ++z) {
                     if (x * x + y * y + z * z <= radius * radius) {
                         const int wx = origin.x + x;
@@ -103,7 +103,7 @@ struct Sphere : Primitive {
                         const int wz = origin.z + z;
 
                         const auto it = userEdits.find(glm::ivec3(x, y, z));
-                        const int voxelType = it != userEdits.end() ? it->second : this->voxelType;
+                        const Voxel voxelType = it != userEdits.end() ? it->second : this->voxelType;
                         if (voxelType == 0) {
                             editMap[{wx, wy, wz}] = std::nullopt;
                             continue;
@@ -125,7 +125,7 @@ struct Sphere : Primitive {
 };
 
 struct Cylinder : Primitive {
-    Cylinder(const int voxelType, const glm::ivec3& origin, const int r, const int h)
+    Cylinder(const Voxel voxelType, const glm::ivec3& origin, const int r, const int h)
         : radius(r), height(h) {
         this->voxelType = voxelType;
         this->origin = origin;
@@ -148,7 +148,7 @@ struct Cylinder : Primitive {
                         const int wz = origin.z + z;
 
                         const auto it = userEdits.find(glm::ivec3(x, y, z));
-                        const int voxelType = it != userEdits.end() ? it->second : this->voxelType;
+                        const Voxel voxelType = it != userEdits.end() ? it->second : this->voxelType;
                         if (voxelType == 0) {
                             editMap[{wx, wy, wz}] = std::nullopt;
                             continue;
@@ -173,7 +173,7 @@ struct Cylinder : Primitive {
 struct Plane : Primitive {
     enum class Axis { X, Y, Z };
 
-    Plane(const int voxelType, const glm::ivec3& start, const glm::ivec3& end, const Axis axis) : axis(axis) {
+    Plane(const Voxel voxelType, const glm::ivec3& start, const glm::ivec3& end, const Axis axis) : axis(axis) {
         this->start = glm::min(start, end);
         this->end = glm::max(start, end);
         this->voxelType = voxelType;
@@ -199,13 +199,13 @@ struct Plane : Primitive {
                 int z = static_cast<int>(std::round(start.z + t * dz));
 
                 // For each point on the line, create voxels along the Y axis
-                for (int y = std::max(0, start.y); y <= std::min(ChunkHeight - 1, end.y); ++y) {
+                for (int y = std::max(0, start.y); y <= std::min(WorldHeight - 1, end.y); ++y) {
                     const int wx = origin.x + x;
                     const int wy = origin.y + y;
                     const int wz = origin.z + z;
 
                     const auto it = userEdits.find(glm::ivec3(x, y, z));
-                    const int voxelType = it != userEdits.end() ? it->second : this->voxelType;
+                    const Voxel voxelType = it != userEdits.end() ? it->second : this->voxelType;
                     if (voxelType == 0) {
                         editMap[{wx, wy, wz}] = std::nullopt;
                         continue;
@@ -227,7 +227,7 @@ struct Plane : Primitive {
                 int y = static_cast<int>(std::round(start.y + t * dy));
                 int z = static_cast<int>(std::round(start.z + t * dz));
 
-                if (y < 0 || y >= ChunkHeight) continue;
+                if (y < 0 || y >= WorldHeight) continue;
 
                 // For each point on the line, create voxels along the X axis
                 for (int x = start.x; x <= end.x; ++x) {
@@ -236,7 +236,7 @@ struct Plane : Primitive {
                     const int wz = origin.z + z;
 
                     const auto it = userEdits.find(glm::ivec3(x, y, z));
-                    const int voxelType = it != userEdits.end() ? it->second : this->voxelType;
+                    const Voxel voxelType = it != userEdits.end() ? it->second : this->voxelType;
                     if (voxelType == 0) {
                         editMap[{wx, wy, wz}] = std::nullopt;
                         continue;
@@ -258,7 +258,7 @@ struct Plane : Primitive {
                 int x = static_cast<int>(std::round(start.x + t * dx));
                 int y = static_cast<int>(std::round(start.y + t * dy));
 
-                if (y < 0 || y >= ChunkHeight) continue;
+                if (y < 0 || y >= WorldHeight) continue;
 
                 // For each point on the line, create voxels along the Z axis
                 for (int z = start.z; z <= end.z; ++z) {
@@ -267,7 +267,7 @@ struct Plane : Primitive {
                     const int wz = origin.z + z;
 
                     const auto it = userEdits.find(glm::ivec3(x, y, z));
-                    const int voxelType = it != userEdits.end() ? it->second : this->voxelType;
+                    const Voxel voxelType = it != userEdits.end() ? it->second : this->voxelType;
                     if (voxelType == 0) {
                         editMap[{wx, wy, wz}] = std::nullopt;
                         continue;
@@ -0,0 +1,337 @@
+#include "RegionCache.hpp"
+
+#include <algorithm>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "ChunkSwap.hpp"
+#include "VoxelLayout.hpp"
+#include "../core/TileCache.hpp"
+#include "tracy/Tracy.hpp"
+
+namespace {
+    constexpr uint32_t Magic = 0x47525856;  // "VXRG"
+    constexpr uint32_t Version = 1;
+
+    // FNV-1a
+    void hashBytes(uint64_t& hash, const void* data, const size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<const unsigned char*>(data)[i];
+            hash *= 0x100000001B3ull;
+        }
+    }
+
+    template<typename T>
+    void hashValue(uint64_t& hash, const T& value) {
+        hashBytes(hash, &value, sizeof(T));
+    }
+}
+
+RegionCache::RegionCache(std::filesystem::path directory)
+    : directory(std::move(directory))
+{}
+
+std::optional<Chunk::GenerationResult> RegionCache::load(const glm::ivec3& coords, const uint64_t fingerprint) {
+    ZoneScoped;
+
+    if (coords.y < 0 || coords.y >= TerrainChunkRows) {
+        return std::nullopt;
+    }
+
+    const int rx = coords.x >> RegionSizeShift;
+    const int rz = coords.z >> RegionSizeShift;
+    thread_local std::vector<std::byte> bytes;
+    TableEntry entry{};
+    {
+        const std::shared_ptr<Region> region = this->region(rx, rz);
+        std::scoped_lock lock(region->mutex);
+        open(*region, rx, rz);
+
+        if (region->fingerprint == fingerprint) {
+            entry = region->table[getChunkIndex(coords)];
+        }
+        if (entry.offset != 0 && entry.offset + entry.size <= region->end) {
+            bytes.resize(entry.size);
+            region->file.seekg(static_cast<std::streamoff>(entry.offset));
+            region->file.read(reinterpret_cast<char*>(bytes.data()), entry.size);
+            if (!region->file) {
+                region->file.clear();
+                entry.offset = 0;
+            }
+        } else {
+            entry.offset = 0;
+        }
+    }
+
+    // Decoded outside the region's lock, so other threads can read the rest of the region meanwhile. A chunk that
+    // doesn't decode, e.g. from a file cut short, is a miss, and is generated again. So is one with heights outside the
+    // chunk, which the mesher would read past its voxels at; like generated chunks, minY >= maxY means it's empty.
+    const bool inChunk = 0 <= entry.minY && entry.minY <= ChunkHeight && 0 <= entry.maxY && entry.maxY <= ChunkHeight;
+    std::optional<VoxelStorage> voxels;
+    if (entry.offset != 0 && inChunk) {
+        voxels = ChunkSwap::decode(bytes);
+    }
+
+    {
+        std::scoped_lock lock(mutex);
+        if (!voxels) {
+            ++stats.misses;
+            return std::nullopt;
+        }
+        ++stats.hits;
+        stats.bytes += entry.size;
+    }
+
+    Chunk::GenerationResult result;
+    result.voxelField = std::move(*voxels);
+    result.minY = entry.minY;
+    result.maxY = entry.maxY;
+    return result;
+}
+
+bool RegionCache::store(const glm::ivec3& coords, const Chunk::GenerationResult& result, const uint64_t fingerprint) {
+    ZoneScoped;
+
+    if (coords.y < 0 || coords.y >= TerrainChunkRows) {
+        return false;
+    }
+
+    thread_local std::vector<std::byte> bytes;
+    bytes.clear();
+    ChunkSwap::encode(result.voxelField, bytes);
+
+    const int rx = coords.x >> RegionSizeShift;
+    const int rz = coords.z >> RegionSizeShift;
+    bool wasReset = false;
+    {
+        const std::shared_ptr<Region> region = this->region(rx, rz);
+        std::scoped_lock lock(region->mutex);
+        open(*region, rx, rz);
+
+        if (region->fingerprint != fingerprint) {
+            wasReset = region->fingerprint.has_value();
+            if (!reset(*region, rx, rz, fingerprint)) {
+                return false;
+            }
+        }
+
+        // Chunks are only appended, so a chunk written again leaves its old encoding behind. Once those take up more
+        // than the chunks still in the file, and more than StaleSlack, the file is rewritten without them.
+        const uint64_t stale = region->end - tableEnd() - region->live;
+        if (stale > std::max(region->live, StaleSlack) && !compact(*region, rx, rz)) {
+            return false;
+        }
+
+        const TableEntry entry{
+            region->end,
+            static_cast<uint32_t>(bytes.size()),
+            static_cast<int16_t>(result.minY),
+            static_cast<int16_t>(result.maxY),
+        };
+        region->file.seekp(static_cast<std::streamoff>(entry.offset));
+        region->file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        // The encoding is written before the table points at it
+        const size_t index = getChunkIndex(coords);
+        region->file.seekp(static_cast<std::streamoff>(sizeof(Header) + index * sizeof(TableEntry)));
+        region->file.write(reinterpret_cast<const char*>(&entry), sizeof(TableEntry));
+        if (!region->file) {
+            region->file.close();
+            region->fingerprint.reset();
+            return false;
+        }
+
+        const TableEntry& previous = region->table[index];
+        region->live -= previous.offset != 0 && previous.offset + previous.size <= region->end ? previous.size : 0;
+        region->live += bytes.size();
+        region->table[index] = entry;
+        region->end += bytes.size();
+    }
+
+    std::scoped_lock lock(mutex);
+    ++stats.stores;
+    stats.resets += wasReset;
+    stats.bytes += bytes.size();
+    return true;
+}
+
+RegionCacheStats RegionCache::getStats() const {
+    std::scoped_lock lock(mutex);
+    return stats;
+}
+
+uint64_t RegionCache::fingerprint(const GeneratorPipeline& generator) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    hashValue(hash, Version);
+    hashValue(hash, TerrainSeed);
+    hashValue(hash, ChunkSizeShift);
+    hashValue(hash, ChunkHeightShift);
+    hashValue(hash, SectionHeightShift);
+    hashValue(hash, sizeof(Voxel));
+
+    // Sections are encoded in layout order, so a different layout reads back scrambled
+    hashValue(hash, SectionLayout::index(1, 0, 0));
+    hashValue(hash, SectionLayout::index(0, 1, 0));
+    hashValue(hash, SectionLayout::index(0, 0, 1));
+
+    const std::string stages = generator.toJson().dump();
+    hashBytes(hash, stages.data(), stages.size());
+    return hash;
+}
+
+std::shared_ptr<RegionCache::Region> RegionCache::region(const int rx, const int rz) {
+    std::scoped_lock lock(mutex);
+    std::shared_ptr<Region>& region = regions[tileKey(rx, rz)];
+    if (!region) {
+        region = std::make_shared<Region>();
+    }
+    region->lastUse = ++uses;
+    std::shared_ptr<Region> used = region;
+
+    // References are only handed out under the lock, so a region no thread holds can't be picked up while it's closed
+    while (regions.size() > MaxOpenRegions) {
+        auto oldest = regions.end();
+        for (auto it = regions.begin(); it != regions.end(); ++it) {
+            const bool idle = it->second.use_count() == 1;
+            if (idle && (oldest == regions.end() || it->second->lastUse < oldest->second->lastUse)) {
+                oldest = it;
+            }
+        }
+        if (oldest == regions.end()) {
+            break;
+        }
+        regions.erase(oldest);
+    }
+    return used;
+}
+
+void RegionCache::open(Region& region, const int rx, const int rz) const {
+    if (region.opened) {
+        return;
+    }
+    region.opened = true;
+
+    region.file.open(regionPath(rx, rz), std::ios::in | std::ios::out | std::ios::binary);
+    if (!region.file.is_open()) {
+        return;
+    }
+
+    Header header{};
+    region.table.resize(ChunksPerRegion);
+    region.file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+    region.file.read(reinterpret_cast<char*>(region.table.data()),
+                     static_cast<std::streamsize>(region.table.size() * sizeof(TableEntry)));
+    if (!region.file || header.magic != Magic || header.version != Version) {
+        // Not a region file, or a truncated one, so it's replaced on the first store
+        region.file.close();
+        return;
+    }
+
+    region.file.seekg(0, std::ios::end);
+    region.end = static_cast<uint64_t>(region.file.tellg());
+    region.live = 0;
+    for (const TableEntry& entry : region.table) {
+        region.live += entry.offset != 0 && entry.offset + entry.size <= region.end ? entry.size : 0;
+    }
+    region.fingerprint = header.fingerprint;
+}
+
+bool RegionCache::reset(Region& region, const int rx, const int rz, const uint64_t fingerprint) const {
+    region.file.close();
+    region.fingerprint.reset();
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    region.file.open(regionPath(rx, rz), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!region.file.is_open()) {
+        return false;
+    }
+
+    const Header header{Magic, Version, fingerprint};
+    region.table.assign(ChunksPerRegion, TableEntry{});
+    region.file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    region.file.write(reinterpret_cast<const char*>(region.table.data()),
+                      static_cast<std::streamsize>(region.table.size() * sizeof(TableEntry)));
+    if (!region.file) {
+        region.file.close();
+        return false;
+    }
+
+    region.end = tableEnd();
+    region.live = 0;
+    region.fingerprint = fingerprint;
+    return true;
+}
+
+bool RegionCache::compact(Region& region, const int rx, const int rz) const {
+    ZoneScoped;
+
+    // The chunks the table points at, packed one after another. Any that run past the end of the file are dropped.
+    std::vector<TableEntry> table(region.table.size());
+    std::vector<std::byte> encodings;
+    encodings.reserve(region.live);
+    for (size_t i = 0; i < table.size(); ++i) {
+        const TableEntry& entry = region.table[i];
+        if (entry.offset == 0 || entry.offset + entry.size > region.end) {
+            continue;
+        }
+        const size_t at = encodings.size();
+        encodings.resize(at + entry.size);
+        region.file.seekg(static_cast<std::streamoff>(entry.offset));
+        region.file.read(reinterpret_cast<char*>(encodings.data() + at), entry.size);
+        table[i] = {tableEnd() + at, entry.size, entry.minY, entry.maxY};
+    }
+    if (!region.file) {
+        region.file.close();
+        region.fingerprint.reset();
+        return false;
+    }
+
+    // Written beside the region file and then moved over it, so the region is never left half rewritten
+    const std::filesystem::path path = regionPath(rx, rz);
+    std::filesystem::path compacted = path;
+    compacted += ".compact";
+    {
+        std::ofstream file(compacted, std::ios::binary | std::ios::trunc);
+        const Header header{Magic, Version, *region.fingerprint};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.write(reinterpret_cast<const char*>(table.data()),
+                   static_cast<std::streamsize>(table.size() * sizeof(TableEntry)));
+        file.write(reinterpret_cast<const char*>(encodings.data()), static_cast<std::streamsize>(encodings.size()));
+        if (!file) {
+            std::error_code error;
+            std::filesystem::remove(compacted, error);
+            return false;
+        }
+    }
+
+    region.file.close();
+    std::error_code error;
+    std::filesystem::rename(compacted, path, error);
+    region.file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (error || !region.file.is_open()) {
+        region.file.close();
+        region.fingerprint.reset();
+        return false;
+    }
+
+    region.table = std::move(table);
+    region.end = tableEnd() + encodings.size();
+    region.live = encodings.size();
+    return true;
+}
+
+std::filesystem::path RegionCache::regionPath(const int rx, const int rz) const {
+    return directory / ("r." + std::to_string(rx) + "." + std::to_string(rz) + ".region");
+}
+
+uint64_t RegionCache::tableEnd() {
+    return sizeof(Header) + ChunksPerRegion * sizeof(TableEntry);
+}
+
+size_t RegionCache::getChunkIndex(const glm::ivec3& coords) {
+    const size_t x = coords.x & (RegionSize - 1);
+    const size_t z = coords.z & (RegionSize - 1);
+    return (static_cast<size_t>(coords.y) * RegionSize + z) * RegionSize + x;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Chunk.hpp"
+#include "Generator.hpp"
+
+struct RegionCacheStats {
+    size_t hits = 0;     // Chunks read back instead of generated
+    size_t misses = 0;   // Chunks that weren't cached, so had to be generated
+    size_t stores = 0;   // Chunks written out
+    size_t resets = 0;   // Region files discarded because a different generator wrote them
+    size_t bytes = 0;    // Encoded size of the chunks written or read this session
+};
+
+// Generated voxels of the terrain rows, before any edits, persisted across sessions so that revisiting ground (or
+// starting the game again) reads chunks back instead of generating them. Chunks are grouped into region files of
+// RegionSize x RegionSize chunk columns, each starting with a table of where in the file every chunk's encoding is.
+// Every file is stamped with the fingerprint of the generator that wrote it: a region written by any other generator,
+// seed or chunk shape is discarded the first time it's written to, and never read from. A chunk written again is
+// appended, and its old encoding compacted away later, so a file stays within twice the size of its chunks plus
+// StaleSlack. Thread-safe, since chunks are generated on the thread pool; threads only wait for each other when they
+// use the same region.
+class RegionCache {
+public:
+    static constexpr int RegionSizeShift = 5;
+    static constexpr int RegionSize = 1 << RegionSizeShift;
+
+    explicit RegionCache(std::filesystem::path directory);
+
+    RegionCache(const RegionCache&) = delete;
+    RegionCache& operator=(const RegionCache&) = delete;
+
+    // The chunk at coords as generated by the generator with the given fingerprint, if it's been written before
+    [[nodiscard]] std::optional<Chunk::GenerationResult> load(const glm::ivec3& coords, uint64_t fingerprint);
+
+    // Writes out the chunk at coords, unless it's outside the terrain rows. Returns false if the file isn't writable.
+    bool store(const glm::ivec3& coords, const Chunk::GenerationResult& result, uint64_t fingerprint);
+
+    [[nodiscard]] const std::filesystem::path& getDirectory() const { return directory; }
+    [[nodiscard]] RegionCacheStats getStats() const;
+
+    // Identifies what a generator produces: its stages, the terrain seed, the chunk shape and the voxel encoding
+    static uint64_t fingerprint(const GeneratorPipeline& generator);
+
+private:
+    static constexpr int ChunksPerRegion = RegionSize * RegionSize * TerrainChunkRows;
+    static constexpr size_t MaxOpenRegions = 16;
+    static constexpr uint64_t StaleSlack = uint64_t{1} << 20;  // Bytes of old encodings a file may hold regardless
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+    };
+
+    // Where a chunk's encoding is in its region file. An offset of 0 means the chunk hasn't been written.
+    struct TableEntry {
+        uint64_t offset;
+        uint32_t size;
+        int16_t minY;
+        int16_t maxY;
+    };
+
+    struct Region {
+        std::mutex mutex;
+        std::fstream file;
+        bool opened = false;
+        std::optional<uint64_t> fingerprint;  // Unset if the file doesn't exist or isn't a region file
+        std::vector<TableEntry> table;
+        uint64_t end = 0;  // Where the next chunk is appended
+        uint64_t live = 0;  // Bytes of the encodings the table points at, the rest past the table being stale
+        uint64_t lastUse = 0;  // Guarded by the cache's mutex rather than the region's
+    };
+
+    std::filesystem::path directory;
+
+    mutable std::mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<Region>> regions;
+    uint64_t uses = 0;
+    RegionCacheStats stats;
+
+    // The region's file stays open until it's one of the least recently used regions no thread is using, and there are
+    // more than MaxOpenRegions open
+    std::shared_ptr<Region> region(int rx, int rz);
+    void open(Region& region, int rx, int rz) const;
+    bool reset(Region& region, int rx, int rz, uint64_t fingerprint) const;
+    bool compact(Region& region, int rx, int rz) const;
+    [[nodiscard]] std::filesystem::path regionPath(int rx, int rz) const;
+
+    static uint64_t tableEnd();  // Where the first chunk's encoding starts
+    static size_t getChunkIndex(const glm::ivec3& coords);
+};
@@ -12,10 +12,19 @@ constexpr int TopNormal = 5;
 RunMesher::MeshResult RunMesher::meshChunk() {
     // Y-axis - start from the bottom and search up
     for (size_t j = chunk->minY; j < chunk->maxY; ++j) {  // y
+        if (const size_t section = j >> SectionHeightShift; voxels.centre().isSectionEmpty(section)) {
+            j = ((section + 1) << SectionHeightShift) - 1;
+            continue;
+        }
+
+        if (voxels.isLayerEnclosed(static_cast<int>(j))) {
+            continue;
+        }
+
         for (size_t k = 1; k < ChunkSize + 1; ++k) {      // z
             for (size_t i = 1; i < ChunkSize + 1; ++i) {  // x
-                const size_t access = Chunk::getVoxelIndex(i, j, k);
-                const int voxel = chunk->voxels[access];
+                const size_t access = getPaddedIndex(i, j, k);
+                const Voxel voxel = load(i, j, k);
 
                 if (voxel == 0 || (generationType == GenerationType::Perlin2D && voxel == 3)) {
                     continue;
@@ -32,13 +41,13 @@ RunMesher::MeshResult RunMesher::meshChunk() {
     };
 }
 
-void RunMesher::createRun(const int voxel, const size_t i, const size_t j, const size_t k, const size_t access) {
+void RunMesher::createRun(const Voxel voxel, const size_t i, const size_t j, const size_t k, const size_t access) {
     // Left face (-X)
     if (!visitedXN[access] && shouldMeshFace(i - 1, j, k)) {
         int length = 0;
 
         for (int q = j; q < ChunkHeight; ++q) {
-            const size_t chunkAccess = Chunk::getVoxelIndex(i, q, k);
+            const size_t chunkAccess = getPaddedIndex(i, q, k);
 
             // If we reach a different block or an empty block, end the run
             if (differentBlock(chunkAccess, voxel)) {
@@ -66,7 +75,7 @@ void RunMesher::createRun(const int voxel, const size_t i, const size_t j, const
     if (!visitedXP[access] && shouldMeshFace(i + 1, j, k)) {
         int length = 0;
         for (int q = j; q < ChunkHeight; ++q) {
-            const size_t chunkAccess = Chunk::getVoxelIndex(i, q, k);
+            const size_t chunkAccess = getPaddedIndex(i, q, k);
 
             if (differentBlock(chunkAccess, voxel)) {
                 break;
@@ -93,7 +102,7 @@ void RunMesher::createRun(const int voxel, const size_t i, const size_t j, const
     if (!visitedZN[access] && shouldMeshFace(i, j, k - 1)) {
         int length = 0;
         for (int q = j; q < ChunkHeight; ++q) {
-            const size_t chunkAccess = Chunk::getVoxelIndex(i, q, k);
+            const size_t chunkAccess = getPaddedIndex(i, q, k);
 
             if (differentBlock(chunkAccess, voxel)) {
                 break;
@@ -120,7 +129,7 @@ void RunMesher::createRun(const int voxel, const size_t i, const size_t j, const
     if (!visitedZP[access] && shouldMeshFace(i, j, k + 1)) {
         int length = 0;
         for (int q = j; q < ChunkHeight; ++q) {
-            const size_t chunkAccess = Chunk::getVoxelIndex(i, q, k);
+            const size_t chunkAccess = getPaddedIndex(i, q, k);
 
             if (differentBlock(chunkAccess, voxel)) {
                 break;
@@ -147,7 +156,7 @@ void RunMesher::createRun(const int voxel, const size_t i, const size_t j, const
     if (!visitedYN[access] && shouldMeshFace(i, j - 1, k)) {
         int length = 0;
         for (int q = i; q < ChunkSize + 1; ++q) {
-            const size_t chunkAccess = Chunk::getVoxelIndex(q, j, k);
+            const size_t chunkAccess = getPaddedIndex(q, j, k);
 
             if (differentBlock(chunkAccess, voxel)) {
                 break;
@@ -174,7 +183,7 @@ void RunMesher::createRun(const int voxel, const size_t i, const size_t j, const
     if (!visitedYP[access] && shouldMeshFace(i, j + 1, k)) {
         int length = 0;
         for (int q = i; q < ChunkSize + 1; ++q) {
-            const size_t chunkAccess = Chunk::getVoxelIndex(q, j, k);
+            const size_t chunkAccess = getPaddedIndex(q, j, k);
 
             if (differentBlock(chunkAccess, voxel)) {
                 break;
@@ -199,22 +208,20 @@ void RunMesher::createRun(const int voxel, const size_t i, const size_t j, const
 }
 
 bool RunMesher::shouldMeshFace(const int i, const int j, const int k) const {
-    const bool adjInBounds = j >= 0 && j < ChunkHeight + 1;
-
-    bool isAdjVoxelEmpty = true;
-    if (adjInBounds) {
-        isAdjVoxelEmpty = chunk->voxels[Chunk::getVoxelIndex(i, j, k)] == 0;
-    }
-
-    return adjInBounds && isAdjVoxelEmpty;
+    return !voxels.isSolid(static_cast<int>(i) - 1, j, static_cast<int>(k) - 1);
 }
 
-bool RunMesher::differentBlock(size_t access, int voxel) const {
-    if (access >= chunk->voxels.size()) {
+bool RunMesher::differentBlock(size_t access, Voxel voxel) const {
+    if (access >= PaddedVolume) {
         return true;
     }
 
-    const int otherVoxel = chunk->voxels[access];
+    // access is a padded index from getPaddedIndex, so recover the coordinates from it
+    constexpr size_t layerSize = (ChunkSize + 2) * (ChunkSize + 2);
+    const size_t y = access / layerSize;
+    const size_t z = access % layerSize / (ChunkSize + 2);
+    const size_t x = access % (ChunkSize + 2);
+    const int otherVoxel = load(x, y, z);
     return otherVoxel != voxel || otherVoxel == 0 || (generationType == GenerationType::Perlin2D && otherVoxel == 3);
 }
 
@@ -224,7 +231,7 @@ void RunMesher::appendQuad(
     const glm::ivec3& bl,
     const glm::ivec3& br,
     const int normal,
-    const int voxel
+    const Voxel voxel
 ) {
     // Each vertex in a quad shares the same colour and normal
     const uint32_t shared = static_cast<uint32_t>(normal) << VertexFormat::NormalShift
@@ -3,11 +3,12 @@
 #include <glm/glm.hpp>
 
 #include "Chunk.hpp"
+#include "ChunkNeighbourhood.hpp"
 
 class RunMesher {
 public:
-    RunMesher(Chunk* chunk, GenerationType generationType)
-        : chunk(chunk), generationType(generationType) {}
+    RunMesher(Chunk* chunk, const ChunkNeighbourhood& voxels, GenerationType generationType)
+        : chunk(chunk), voxels(voxels), generationType(generationType) {}
 
     struct MeshResult {
         Chunk* chunk;
@@ -17,29 +18,42 @@ public:
     MeshResult meshChunk();
 
 private:
-    void createRun(int voxel, size_t i, size_t j, size_t k, size_t access);
+    // Runs are tracked in a padded index space with a one voxel border around the chunk, so i and k are in
+    // [0, ChunkSize + 1] and map to chunk x and z in [-1, ChunkSize]
+    static constexpr size_t PaddedVolume = (ChunkSize + 2) * (ChunkSize + 2) * ChunkHeight;
+
+    static size_t getPaddedIndex(const size_t i, const size_t j, const size_t k) {
+        return j * (ChunkSize + 2) * (ChunkSize + 2) + k * (ChunkSize + 2) + i;
+    }
+
+    Voxel load(const size_t i, const size_t j, const size_t k) const {
+        return voxels.load(static_cast<int>(i) - 1, static_cast<int>(j), static_cast<int>(k) - 1);
+    }
+
+    void createRun(Voxel voxel, size_t i, size_t j, size_t k, size_t access);
     bool shouldMeshFace(int i, int j, int k) const;
-    bool differentBlock(size_t access, int voxel) const;
+    bool differentBlock(size_t access, Voxel voxel) const;
     void appendQuad(
         const glm::ivec3& tl,
         const glm::ivec3& tr,
         const glm::ivec3& bl,
         const glm::ivec3& br,
         int normal,
-        int voxel
+        Voxel voxel
     );
 
     static uint32_t combinePosition(const glm::ivec3& pos, uint32_t shared);
 
     Chunk* chunk;
+    const ChunkNeighbourhood& voxels;
     GenerationType generationType;
 
-    std::vector<bool> visitedXN = std::vector(VoxelsSize, false);
-    std::vector<bool> visitedXP = std::vector(VoxelsSize, false);
-    std::vector<bool> visitedZN = std::vector(VoxelsSize, false);
-    std::vector<bool> visitedZP = std::vector(VoxelsSize, false);
-    std::vector<bool> visitedYN = std::vector(VoxelsSize, false);
-    std::vector<bool> visitedYP = std::vector(VoxelsSize, false);
+    std::vector<bool> visitedXN = std::vector(PaddedVolume, false);
+    std::vector<bool> visitedXP = std::vector(PaddedVolume, false);
+    std::vector<bool> visitedZN = std::vector(PaddedVolume, false);
+    std::vector<bool> visitedZP = std::vector(PaddedVolume, false);
+    std::vector<bool> visitedYN = std::vector(PaddedVolume, false);
+    std::vector<bool> visitedYP = std::vector(PaddedVolume, false);
 
     std::vector<uint32_t> vertices;
 };
@@ -0,0 +1,61 @@
+#include "SharedVoxels.hpp"
+
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+    std::atomic<uint64_t> copies = 0;
+
+    // Main thread only, like the rest of SharedVoxels
+    std::unordered_map<Voxel, std::shared_ptr<VoxelStorage>> uniformStorages;
+}
+
+SharedVoxels::SharedVoxels()
+    : storage(std::make_shared<VoxelStorage>())
+{}
+
+SharedVoxels::SharedVoxels(VoxelStorage voxels)
+    : storage(std::make_shared<VoxelStorage>(std::move(voxels)))
+{}
+
+SharedVoxels& SharedVoxels::operator=(VoxelStorage voxels) {
+    storage = std::make_shared<VoxelStorage>(std::move(voxels));
+    return *this;
+}
+
+SharedVoxels& SharedVoxels::operator=(Snapshot voxels) {
+    storage = std::const_pointer_cast<VoxelStorage>(std::move(voxels));
+    return *this;
+}
+
+SharedVoxels& SharedVoxels::fill(const Voxel v) {
+    std::shared_ptr<VoxelStorage>& uniform = uniformStorages[v];
+    if (!uniform) {
+        uniform = std::make_shared<VoxelStorage>();
+        for (size_t section = 0; section < SectionCount; ++section) {
+            uniform->fillSection(section, v);
+        }
+    }
+
+    storage = uniform;
+    return *this;
+}
+
+VoxelStorage& SharedVoxels::write() {
+    // Snapshots are only taken on this thread, so a count of 1 can't go up behind our back. It can go down as workers
+    // drop their snapshots, in which case at worst we copy when we didn't need to.
+    if (storage.use_count() > 1) {
+        storage = std::make_shared<VoxelStorage>(*storage);
+        copies.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // Pairs with the release in the workers' reference count decrement, so their reads happen before our writes
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    return *storage;
+}
+
+uint64_t SharedVoxels::copyCount() {
+    return copies.load(std::memory_order_relaxed);
+}
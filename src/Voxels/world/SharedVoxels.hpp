@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "VoxelStorage.hpp"
+
+// A chunk's voxels, shared with worker threads as immutable snapshots. Taking a snapshot only bumps a reference count;
+// the first write after that copies the voxels (copy-on-write), so a burst of edits between two snapshots copies at
+// most once. Not thread-safe itself: only the owning (main) thread may take snapshots or write.
+class SharedVoxels {
+public:
+    using Snapshot = std::shared_ptr<const VoxelStorage>;
+
+    SharedVoxels();
+    explicit SharedVoxels(VoxelStorage voxels);
+
+    // Replaces the voxels outright; existing snapshots keep the old ones
+    SharedVoxels& operator=(VoxelStorage voxels);
+
+    // Adopts voxels from an earlier snapshot without copying them. The snapshot stays immutable: the first write copies
+    // unless this is the only reference left.
+    SharedVoxels& operator=(Snapshot voxels);
+
+    [[nodiscard]] const VoxelStorage& operator*() const { return *storage; }
+    [[nodiscard]] const VoxelStorage* operator->() const { return storage.get(); }
+
+    // Replaces the voxels with a chunk made entirely of v. Every such chunk shares the same voxels until it is written
+    // to, so chunks of solid rock or empty sky cost nothing.
+    SharedVoxels& fill(Voxel v);
+
+    // Voxels that are safe to modify, copying them first if a snapshot still refers to them
+    [[nodiscard]] VoxelStorage& write();
+
+    [[nodiscard]] Snapshot snapshot() const { return storage; }
+
+    // Number of times write had to copy, over all instances
+    static uint64_t copyCount();
+
+private:
+    std::shared_ptr<VoxelStorage> storage;
+};
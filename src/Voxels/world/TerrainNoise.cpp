@@ -0,0 +1,61 @@
+#include "TerrainNoise.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+    // Points converted to float at a time, so the simplex batches need no allocation
+    constexpr size_t Block = 256;
+}
+
+TerrainNoise::TerrainNoise(const NoiseBackend backend, const unsigned int seed)
+    : backend(backend), perlin(seed), simplex(seed)
+{}
+
+const TerrainNoise& TerrainNoise::terrain(const NoiseBackend backend) {
+    static const TerrainNoise perlinTerrain(NoiseBackend::Perlin, TerrainSeed);
+    static const TerrainNoise simplexTerrain(NoiseBackend::Simplex, TerrainSeed);
+    return backend == NoiseBackend::Simplex ? simplexTerrain : perlinTerrain;
+}
+
+void TerrainNoise::octave2D_01(const std::span<const double> x, const std::span<const double> y,
+                               const std::span<double> out, const int octaves) const {
+    if (backend == NoiseBackend::Perlin) {
+        perlin.octave2D_01(x, y, out, octaves);
+        return;
+    }
+
+    std::array<float, Block> xs;
+    std::array<float, Block> ys;
+    std::array<float, Block> noise;
+    for (size_t i = 0; i < out.size(); i += Block) {
+        const size_t count = std::min(Block, out.size() - i);
+        std::copy_n(x.begin() + i, count, xs.begin());
+        std::copy_n(y.begin() + i, count, ys.begin());
+        simplex.octave2D_01(std::span(xs).first(count), std::span(ys).first(count), std::span(noise).first(count),
+                            octaves);
+        std::copy_n(noise.begin(), count, out.begin() + i);
+    }
+}
+
+void TerrainNoise::octave3D_01(const std::span<const double> x, const std::span<const double> y,
+                               const std::span<const double> z, const std::span<double> out, const int octaves) const {
+    if (backend == NoiseBackend::Perlin) {
+        perlin.octave3D_01(x, y, z, out, octaves);
+        return;
+    }
+
+    std::array<float, Block> xs;
+    std::array<float, Block> ys;
+    std::array<float, Block> zs;
+    std::array<float, Block> noise;
+    for (size_t i = 0; i < out.size(); i += Block) {
+        const size_t count = std::min(Block, out.size() - i);
+        std::copy_n(x.begin() + i, count, xs.begin());
+        std::copy_n(y.begin() + i, count, ys.begin());
+        std::copy_n(z.begin() + i, count, zs.begin());
+        simplex.octave3D_01(std::span(xs).first(count), std::span(ys).first(count), std::span(zs).first(count),
+                            std::span(noise).first(count), octaves);
+        std::copy_n(noise.begin(), count, out.begin() + i);
+    }
+}
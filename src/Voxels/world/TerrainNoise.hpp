@@ -0,0 +1,29 @@
+#pragma once
+
+#include <span>
+
+#include "Chunk.hpp"
+#include "../util/PerlinNoise.hpp"
+#include "../util/SimplexNoise.hpp"
+
+// Octave noise in [0, 1] from either backend, sampled in batches as the terrain generators sample it. Simplex noise is
+// evaluated in float, so its coordinates are rounded to float first; at the frequencies terrain is sampled at, that
+// moves them by less than a tenth of a voxel out to a million voxels from the origin.
+class TerrainNoise {
+public:
+    TerrainNoise(NoiseBackend backend, unsigned int seed);
+
+    // Seeded with TerrainSeed, shared by every generation thread
+    static const TerrainNoise& terrain(NoiseBackend backend);
+
+    void octave2D_01(std::span<const double> x, std::span<const double> y, std::span<double> out, int octaves) const;
+    void octave3D_01(std::span<const double> x, std::span<const double> y, std::span<const double> z,
+                     std::span<double> out, int octaves) const;
+
+    [[nodiscard]] NoiseBackend getBackend() const { return backend; }
+
+private:
+    NoiseBackend backend;
+    siv::PerlinNoise perlin;
+    SimplexNoise simplex;
+};
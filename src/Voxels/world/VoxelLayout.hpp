@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ChunkConstants.hpp"
+
+// Policies for where voxel (x, y, z) of a Width x Height x Width box lives in a flat array. Each provides
+// index(x, y, z), a bijection onto [0, Volume), and forEach(f), which calls f(x, y, z) for every voxel in index order so
+// that loops over a whole box touch memory sequentially whatever the layout.
+
+// y outermost and x innermost, so each horizontal layer is contiguous
+template<size_t Width, size_t Height>
+struct LinearLayout {
+    static constexpr size_t Volume = Width * Width * Height;
+
+    static constexpr size_t index(const size_t x, const size_t y, const size_t z) {
+        return (y * Width + z) * Width + x;
+    }
+
+    template<typename F>
+    static void forEach(F&& f) {
+        for (size_t y = 0; y < Height; ++y) {
+            for (size_t z = 0; z < Width; ++z) {
+                for (size_t x = 0; x < Width; ++x) {
+                    f(x, y, z);
+                }
+            }
+        }
+    }
+};
+
+// y innermost, so each vertical column is contiguous
+template<size_t Width, size_t Height>
+struct ColumnLayout {
+    static constexpr size_t Volume = Width * Width * Height;
+
+    static constexpr size_t index(const size_t x, const size_t y, const size_t z) {
+        return (z * Width + x) * Height + y;
+    }
+
+    template<typename F>
+    static void forEach(F&& f) {
+        for (size_t z = 0; z < Width; ++z) {
+            for (size_t x = 0; x < Width; ++x) {
+                for (size_t y = 0; y < Height; ++y) {
+                    f(x, y, z);
+                }
+            }
+        }
+    }
+};
+
+// 4x4x4 bricks stored one after the other in linear order, with the 64 voxels of a brick in Morton (Z-) order, so a
+// voxel's 3x3x3 neighbourhood mostly falls within one or two 64-voxel bricks
+template<size_t Width, size_t Height>
+struct MortonLayout {
+    static constexpr size_t BrickSize = 4;
+    static constexpr size_t BrickVolume = BrickSize * BrickSize * BrickSize;
+    static constexpr size_t Bricks = Width / BrickSize;  // Along x and z
+    static_assert(Width % BrickSize == 0 && Height % BrickSize == 0, "MortonLayout needs whole bricks");
+
+    static constexpr size_t Volume = Width * Width * Height;
+
+    static constexpr size_t index(const size_t x, const size_t y, const size_t z) {
+        const size_t brick = (y / BrickSize * Bricks + z / BrickSize) * Bricks + x / BrickSize;
+        return brick * BrickVolume + interleave(x % BrickSize, y % BrickSize, z % BrickSize);
+    }
+
+    template<typename F>
+    static void forEach(F&& f) {
+        for (size_t by = 0; by < Height; by += BrickSize) {
+            for (size_t bz = 0; bz < Width; bz += BrickSize) {
+                for (size_t bx = 0; bx < Width; bx += BrickSize) {
+                    for (size_t i = 0; i < BrickVolume; ++i) {
+                        f(bx + compact(i), by + compact(i >> 1), bz + compact(i >> 2));
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    // Bits of two-bit coordinates as z1 y1 x1 z0 y0 x0
+    static constexpr size_t interleave(const size_t x, const size_t y, const size_t z) {
+        return (x & 1) | (y & 1) << 1 | (z & 1) << 2 | (x & 2) << 2 | (y & 2) << 3 | (z & 2) << 4;
+    }
+
+    // Inverse of interleave for the coordinate in bits 0 and 3
+    static constexpr size_t compact(const size_t i) {
+        return (i & 1) | (i >> 2 & 2);
+    }
+};
+
+// Layout of the voxels in each chunk section, selected with the VOXELS_VOXEL_LAYOUT build option
+#ifndef VOXELS_VOXEL_LAYOUT
+#define VOXELS_VOXEL_LAYOUT LinearLayout
+#endif
+
+using SectionLayout = VOXELS_VOXEL_LAYOUT<ChunkSize, SectionHeight>;
+static_assert(SectionLayout::Volume == SectionVolume);
@@ -0,0 +1,166 @@
+#include "VoxelStorage.hpp"
+
+#include <algorithm>
+
+namespace {
+    // (x, y, z) within a section of each index in SectionLayout order
+    const std::array<std::array<uint8_t, 3>, SectionVolume>& sectionCoords() {
+        static const auto coords = [] {
+            std::array<std::array<uint8_t, 3>, SectionVolume> coords{};
+            SectionLayout::forEach([&](const size_t x, const size_t y, const size_t z) {
+                coords[SectionLayout::index(x, y, z)] = {
+                    static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z)
+                };
+            });
+            return coords;
+        }();
+        return coords;
+    }
+}
+
+VoxelStorage::VoxelStorage(const Representation representation)
+    : representation(representation)
+{
+    sections.fill(PaletteStorage(SectionVolume, EmptyVoxel));
+}
+
+void VoxelStorage::setColumn(const size_t x, const size_t z, const std::span<const ColumnStorage::Span> spans) {
+    columnStorage.setColumn(x, z, spans);
+
+    OccupancyMask::Column column;
+    size_t y = 0;
+    size_t height = 0;
+    for (const auto& [type, length] : spans) {
+        y += length;
+        if (type != EmptyVoxel) {
+            column |= OccupancyMask::span(y - length, length);
+            height = y;
+        }
+    }
+    occupancyMask.setColumn(x, z, column, static_cast<int>(height));
+}
+
+void VoxelStorage::densify() {
+    if (representation == Representation::Sections) {
+        return;
+    }
+
+    representation = Representation::Sections;
+    for (size_t z = 0; z < ChunkSize; ++z) {
+        for (size_t x = 0; x < ChunkSize; ++x) {
+            size_t y = 0;
+            for (const auto& [type, length] : columnStorage.column(x, z)) {
+                fillColumn(x, z, y, y + length, type);
+                y += length;
+            }
+        }
+    }
+
+    columnStorage = ColumnStorage();
+    compact();
+}
+
+void VoxelStorage::storeColumn(const size_t x, const size_t y, const size_t z, const Voxel v) {
+    if (columnStorage.store(x, y, z, v) > ColumnStorage::MaxSpans) {
+        densify();
+    }
+}
+
+void VoxelStorage::fillColumn(const size_t x, const size_t z, const size_t yBegin, const size_t yEnd, const Voxel v) {
+    if (yBegin >= yEnd) {
+        return;
+    }
+
+    occupancyMask.fillColumn(x, z, yBegin, yEnd, v != EmptyVoxel);
+    if (representation == Representation::Columns) {
+        if (columnStorage.fill(x, z, yBegin, yEnd, v) > ColumnStorage::MaxSpans) {
+            densify();
+        }
+        return;
+    }
+
+    for (size_t y = yBegin; y < yEnd;) {
+        const size_t section = y >> SectionHeightShift;
+        const size_t sectionBase = section << SectionHeightShift;
+        const size_t end = std::min(yEnd, sectionBase + SectionHeight);
+
+        // Layouts with y innermost hold the column contiguously, so it can be filled a word at a time
+        if constexpr (SectionLayout::index(0, 1, 0) == 1) {
+            const size_t first = getSectionIndex(x, y - sectionBase, z);
+            sections[section].fill(first, first + (end - y), v);
+        } else {
+            std::array<size_t, SectionHeight> indices;
+            for (size_t i = y; i < end; ++i) {
+                indices[i - y] = getSectionIndex(x, i - sectionBase, z);
+            }
+            sections[section].store(std::span(indices).first(end - y), v);
+        }
+        y = end;
+    }
+}
+
+void VoxelStorage::fillSection(const size_t section, const Voxel v) {
+    densify();
+    sections[section].fill(v);
+    occupancyMask.fillLayers(section << SectionHeightShift, (section + 1) << SectionHeightShift, v != EmptyVoxel);
+}
+
+void VoxelStorage::fillSectionRange(const size_t section, const size_t begin, const size_t end, const Voxel v) {
+    densify();
+    sections[section].fill(begin, end, v);
+
+    const size_t sectionBase = section << SectionHeightShift;
+    const std::array<std::array<uint8_t, 3>, SectionVolume>& coords = sectionCoords();
+    for (size_t i = begin; i < end; ++i) {
+        occupancyMask.set(coords[i][0], sectionBase + coords[i][1], coords[i][2], v != EmptyVoxel);
+    }
+}
+
+void VoxelStorage::compact() {
+    if (representation == Representation::Columns) {
+        return;
+    }
+
+    for (PaletteStorage& section : sections) {
+        section.compact();
+    }
+}
+
+auto VoxelStorage::sectionState(const size_t section) const -> SectionState {
+    if (representation == Representation::Columns) {
+        return isSectionEmpty(section) ? SectionState::Empty : SectionState::Dense;
+    }
+
+    if (!sections[section].isUniform()) {
+        return SectionState::Dense;
+    }
+    return sections[section].uniformValue() == EmptyVoxel ? SectionState::Empty : SectionState::Uniform;
+}
+
+std::optional<Voxel> VoxelStorage::uniformValue() const {
+    if (representation == Representation::Columns) {
+        return columnStorage.top() == 0 ? std::optional(EmptyVoxel) : std::nullopt;
+    }
+
+    for (const PaletteStorage& section : sections) {
+        if (!section.isUniform() || section.uniformValue() != sections[0].uniformValue()) {
+            return std::nullopt;
+        }
+    }
+    return sections[0].uniformValue();
+}
+
+size_t VoxelStorage::memoryUsage() const {
+    size_t total = sizeof(OccupancyMask) + columnStorage.memoryUsage();
+    for (const PaletteStorage& section : sections) {
+        total += section.memoryUsage();
+    }
+    return total;
+}
+
+BufferPoolStats VoxelStorage::poolStats() {
+    BufferPoolStats stats = PaletteStorage::wordPool().getStats();
+    stats += PaletteStorage::palettePool().getStats();
+    stats += ColumnStorage::spanPool().getStats();
+    return stats;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+
+#include "ChunkConstants.hpp"
+#include "ColumnStorage.hpp"
+#include "OccupancyMask.hpp"
+#include "PaletteStorage.hpp"
+#include "VoxelLayout.hpp"
+
+// Voxels of a single chunk, split into SectionCount vertical sections.
+// Each section is a PaletteStorage, so a section made of a single voxel type (e.g. all air above the terrain or all
+// stone below it) is uniform and allocates no index storage; only dense sections hold packed indices.
+//
+// Heightmap terrain can instead be stored as run-length encoded columns (see ColumnStorage). A columnar storage is
+// converted to sections the first time one of its columns is edited heavily.
+//
+// Either way, an OccupancyMask of which voxels are solid is kept alongside, for code that only cares about solidity.
+class VoxelStorage {
+public:
+    enum class Representation {
+        Sections,
+        Columns
+    };
+
+    enum class SectionState {
+        Empty,
+        Uniform,
+        Dense
+    };
+
+    explicit VoxelStorage(Representation representation = Representation::Sections);
+
+    // x and z are in [0, ChunkSize)
+    [[nodiscard]] Voxel load(const size_t x, const size_t y, const size_t z) const {
+        if (representation == Representation::Columns) {
+            return columnStorage.load(x, y, z);
+        }
+
+        const PaletteStorage& section = sections[y >> SectionHeightShift];
+        if (section.isUniform()) {
+            return section.uniformValue();
+        }
+        return section.load(getSectionIndex(x, y & (SectionHeight - 1), z));
+    }
+
+    void store(const size_t x, const size_t y, const size_t z, const Voxel v) {
+        occupancyMask.set(x, y, z, v != EmptyVoxel);
+        if (representation == Representation::Columns) {
+            storeColumn(x, y, z, v);
+            return;
+        }
+
+        sections[y >> SectionHeightShift].store(getSectionIndex(x, y & (SectionHeight - 1), z), v);
+    }
+
+    // Sets [yBegin, yEnd) of column (x, z) to v, writing each section's part of the column in one go
+    void fillColumn(size_t x, size_t z, size_t yBegin, size_t yEnd, Voxel v);
+
+    [[nodiscard]] bool isSolid(const size_t x, const size_t y, const size_t z) const {
+        return occupancyMask.isSolid(x, y, z);
+    }
+    [[nodiscard]] const OccupancyMask& occupancy() const { return occupancyMask; }
+    [[nodiscard]] int height(const size_t x, const size_t z) const { return occupancyMask.height(x, z); }
+
+    // Only valid for columnar storage
+    void setColumn(size_t x, size_t z, std::span<const ColumnStorage::Span> spans);
+    [[nodiscard]] const ColumnStorage& columns() const { return columnStorage; }
+
+    [[nodiscard]] Representation getRepresentation() const { return representation; }
+
+    // Convert columnar storage to sections
+    void densify();
+
+    void fillSection(size_t section, Voxel v);
+
+    // Sets voxels [begin, end) of a section, counted in SectionLayout order, a word at a time
+    void fillSectionRange(size_t section, size_t begin, size_t end, Voxel v);
+
+    // Collapse sections that have become uniform (or use fewer types than their palette holds)
+    void compact();
+
+    // Columnar storage only knows which sections are empty, and reports every other section as dense
+    [[nodiscard]] SectionState sectionState(size_t section) const;
+    [[nodiscard]] bool isSectionEmpty(const size_t section) const {
+        if (representation == Representation::Columns) {
+            return static_cast<int>(section << SectionHeightShift) >= columnStorage.top();
+        }
+        return sections[section].isUniform() && sections[section].uniformValue() == EmptyVoxel;
+    }
+
+    // True if every voxel in layer y is solid. Only detected for layers inside uniform sections, which is where the
+    // bulk of solid layers are.
+    [[nodiscard]] bool isLayerSolid(const int y) const {
+        return sectionState(y >> SectionHeightShift) == SectionState::Uniform;
+    }
+
+    // The voxel type filling the whole chunk, if there is only one. Columnar storage only detects empty chunks.
+    [[nodiscard]] std::optional<Voxel> uniformValue() const;
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+    // Combined statistics of the buffer pools behind every VoxelStorage
+    static BufferPoolStats poolStats();
+
+    // y is within the section
+    static size_t getSectionIndex(const size_t x, const size_t y, const size_t z) {
+        return SectionLayout::index(x, y, z);
+    }
+
+private:
+    Representation representation;
+    std::array<PaletteStorage, SectionCount> sections;
+    ColumnStorage columnStorage;
+    OccupancyMask occupancyMask;
+
+    void storeColumn(size_t x, size_t y, size_t z, Voxel v);
+};
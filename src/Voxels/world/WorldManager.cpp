@@ -5,6 +5,7 @@
 #include <fstream>
 #include <iostream>
 #include <ranges>
+#include <tuple>
 #include <utility>
 
 #include <nlohmann/json.hpp>
@@ -20,7 +21,11 @@ WorldManager::WorldManager(
     const GenerationType generationType,
     std::filesystem::path levelFile)
     : generationType(generationType),
+      generator(std::make_shared<const GeneratorPipeline>(GeneratorPipeline::fromType(generationType))),
+      generatorFingerprint(RegionCache::fingerprint(*generator)),
       levelFile(std::move(levelFile)),
+      chunkSwap(std::filesystem::temp_directory_path() / (this->levelFile.stem().string() + ".swap")),
+      regionCache(std::filesystem::path(this->levelFile).replace_extension(".regions")),
       allocator(FreeListAllocator(
           InitialVertexBufferSize,
           4096,
@@ -44,18 +49,29 @@ WorldManager::WorldManager(
     threadPool.start();
 }
 
+namespace {
+    // Offsets to the chunks sharing a face with a chunk
+    constexpr std::array<std::array<int, 3>, 6> FaceNeighbours{{
+        {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+    }};
+
+    glm::ivec3 chunkCoords(const glm::ivec3& pos) {
+        return {pos.x >> ChunkSizeShift, pos.y >> ChunkHeightShift, pos.z >> ChunkSizeShift};
+    }
+}
+
 bool WorldManager::updateFrontierChunks(glm::vec3 position) {
     ZoneScoped;
 
     destroyFrontierChunks(position);
-    return createNewFrontierChunks(position);
+    return createNewFrontierChunks(position) || createEditedChunks(position);
 }
 
 bool WorldManager::createNewFrontierChunks(glm::vec3 position) {
     ZoneScoped;
 
     std::ranges::sort(frontierChunks, [this, &position](const std::shared_ptr<Chunk> &a, const std::shared_ptr<Chunk>& b) {
-        return squaredDistanceToChunk(position, a->cx, a->cz) < squaredDistanceToChunk(position, b->cx, b->cz);
+        return streamingPriority(position, a->cx, a->cy, a->cz) < streamingPriority(position, b->cx, b->cy, b->cz);
     });
 
     for (size_t i = 0, s = frontierChunks.size(); i < s; i++) {
@@ -65,10 +81,26 @@ bool WorldManager::createNewFrontierChunks(glm::vec3 position) {
             break;
         }
 
-        if (ensureChunkIfVisible(position, chunk->cx - 1, chunk->cz) ||
-            ensureChunkIfVisible(position, chunk->cx + 1, chunk->cz) ||
-            ensureChunkIfVisible(position, chunk->cx, chunk->cz - 1) ||
-            ensureChunkIfVisible(position, chunk->cx, chunk->cz + 1)) {
+        for (const auto& [dx, dy, dz] : FaceNeighbours) {
+            if (ensureChunkIfVisible(position, chunk->cx + dx, chunk->cy + dy, chunk->cz + dz)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool WorldManager::createEditedChunks(glm::vec3 position) {
+    ZoneScoped;
+
+    // Edited chunks in the sky may not touch any other chunk, so the frontier never reaches them
+    for (const glm::ivec3& coords : editedChunks) {
+        if (chunkTasksCount >= MaxChunkTasks) {
+            break;
+        }
+
+        if (ensureChunkIfVisible(position, coords.x, coords.y, coords.z)) {
             return true;
         }
     }
@@ -85,14 +117,14 @@ void WorldManager::destroyFrontierChunks(glm::vec3 position) {
             std::shared_ptr<Chunk> chunk = frontierChunks[i];
             // If the chunk's still being initialised, don't destroy it yet since this will invalidate references
             // It will be destroyed later on anyway
-            if (chunkInRenderDistance(position, chunk->cx, chunk->cz)) {
+            if (chunkInRenderDistance(position, chunk->cx, chunk->cy, chunk->cz)) {
                 continue;
             }
 
             // Promote neighbours to frontier if necessary and destroy chunk
             const int numPromoted = onFrontierChunkRemoved(position, chunk);
             frontierChunks.erase(frontierChunks.begin() + i);
-            chunkByCoords.erase(key(chunk->cx, chunk->cz));
+            chunkByCoords.erase(key(chunk->cx, chunk->cy, chunk->cz));
 
             // This should only happen if the chunk has already had its region allocated
             if (chunk->bufferRegionAllocated) {
@@ -101,6 +133,9 @@ void WorldManager::destroyFrontierChunks(glm::vec3 position) {
                 chunk->bufferRegionAllocated = false;
             }
 
+            // Keep its voxels in case the player comes back
+            stashChunk(*chunk);
+
             chunk->destroyed = true;
             chunkData[chunk->index].numVertices = 0;  // Don't render the chunk any more
             s += numPromoted - 1;
@@ -109,25 +144,25 @@ void WorldManager::destroyFrontierChunks(glm::vec3 position) {
     }
 }
 
-bool WorldManager::ensureChunkIfVisible(glm::vec3 position, const int cx, const int cz) {
-    if (!chunkInRenderDistance(position, cx, cz) || (levelChunkBounds.has_value() &&
+bool WorldManager::ensureChunkIfVisible(glm::vec3 position, const int cx, const int cy, const int cz) {
+    if (!isChunkPopulated(cx, cy, cz) || !chunkInRenderDistance(position, cx, cy, cz) || (levelChunkBounds.has_value() &&
         (cx < levelChunkBounds->first.x || cx > levelChunkBounds->second.x ||
          cz < levelChunkBounds->first.y || cz > levelChunkBounds->second.y))) {
         return false;
     }
 
-    return ensureChunk(cx, cz) != nullptr;
+    return ensureChunk(cx, cy, cz, lodAt(std::sqrt(squaredDistanceToPath(position, cx, cy, cz)))) != nullptr;
 }
 
-std::shared_ptr<Chunk> WorldManager::ensureChunk(const int cx, const int cz) {
-    if (chunkByCoords.contains(key(cx, cz))) {
+std::shared_ptr<Chunk> WorldManager::ensureChunk(const int cx, const int cy, const int cz, const int lod) {
+    if (chunkByCoords.contains(key(cx, cy, cz))) {
         return nullptr;
     }
 
-    return createChunk(cx, cz);
+    return createChunk(cx, cy, cz, lod);
 }
 
-std::shared_ptr<Chunk> WorldManager::createChunk(const int cx, const int cz) {
+std::shared_ptr<Chunk> WorldManager::createChunk(const int cx, const int cy, const int cz, const int lod) {
     ZoneScoped;
 
     // Find the first free slot in the chunks vector TODO: use find_if instead
@@ -136,7 +171,7 @@ std::shared_ptr<Chunk> WorldManager::createChunk(const int cx, const int cz) {
         ++index;
     }
 
-    auto chunk = std::make_shared<Chunk>(cx, cz);
+    auto chunk = std::make_shared<Chunk>(cx, cy, cz);
 
     if (index < chunks.size()) {
         chunks[index] = chunk;
@@ -145,19 +180,24 @@ std::shared_ptr<Chunk> WorldManager::createChunk(const int cx, const int cz) {
     }
 
     chunk->index = index;
-    chunkByCoords[key(cx, cz)] = chunk;
+    chunkByCoords[key(cx, cy, cz)] = chunk;
     addFrontier(chunk);
     chunkData[index] = {
         .cx = cx,
+        .cy = cy,
         .cz = cz,
         .minY = ChunkHeight,
         .maxY = 0,
         .numVertices = 0,
         .firstIndex = 0,
-        ._pad0 = 0,
-        ._pad1 = 0,
+        .lod = 0,
     };
 
+    chunk->targetLod = lod;
+    if (lod == 0 && restoreChunk(chunk)) {
+        return chunk;
+    }
+
     ++chunkTasksCount;
 
     queueGenerateChunk(chunk);
@@ -165,27 +205,106 @@ std::shared_ptr<Chunk> WorldManager::createChunk(const int cx, const int cz) {
     return chunk;
 }
 
-void WorldManager::applyEditsToChunk(const std::shared_ptr<Chunk>& chunk) {
-    const int chunkMinX = chunk->cx * ChunkSize - 1;
-    const int chunkMinZ = chunk->cz * ChunkSize - 1;
-    const int chunkMaxX = (chunk->cx + 1) * ChunkSize;
-    const int chunkMaxZ = (chunk->cz + 1) * ChunkSize;
+void WorldManager::updateChunkLods(const glm::vec3 position) {
+    ZoneScoped;
 
-    // User edits
-    for (const auto& [pos, voxelType] : userEdits) {
-        if (pos.x < chunkMinX || pos.x > chunkMaxX ||
-            pos.z < chunkMinZ || pos.z > chunkMaxZ ||
-            pos.y < 0 || pos.y > ChunkHeight - 1) {
+    // Within the hysteresis either side of the distances levels change at, chunks keep the level they have. Distances
+    // are from the predicted path, so chunks the player is heading for get their detail back before they arrive.
+    thread_local std::vector<std::tuple<double, int, std::shared_ptr<Chunk>>> changes;
+    changes.clear();
+    for (const std::shared_ptr<Chunk>& chunk : chunks) {
+        if (chunk->destroyed) {
             continue;
         }
 
-        const int lx = pos.x - (chunk->cx << ChunkSizeShift);
-        const int lz = pos.z - (chunk->cz << ChunkSizeShift);
+        const double distance = std::sqrt(squaredDistanceToPath(position, chunk->cx, chunk->cy, chunk->cz));
+        const int lod = std::clamp(chunk->targetLod, lodAt(distance - LodHysteresisMetres),
+                                   lodAt(distance + LodHysteresisMetres));
+        if (lod != chunk->targetLod) {
+            changes.emplace_back(streamingPriority(position, chunk->cx, chunk->cy, chunk->cz), lod, chunk);
+        }
+    }
 
-        if (voxelType == 0) {
-            chunk->store(lx, pos.y, lz, EmptyVoxel);
-        } else {
-            chunk->store(lx, pos.y, lz, voxelType);
+    // Nearest first, so the ground the player is heading for gets its detail back before the horizon loses any
+    std::ranges::sort(changes, {}, [](const auto& change) { return std::get<0>(change); });
+    for (const auto& [distance, lod, chunk] : changes) {
+        if (chunkTasksCount >= MaxChunkTasks) {
+            break;
+        }
+        setChunkLod(chunk, lod);
+    }
+    changes.clear();
+}
+
+void WorldManager::setChunkLod(const std::shared_ptr<Chunk>& chunk, const int lod) {
+    // The chunk keeps drawing its current voxels until those at the new level arrive. Any still on their way for the
+    // level it had before are dropped by updateGeneratedChunks.
+    chunk->targetLod = lod;
+    if (chunk->generated && chunk->lod == lod) {
+        return;
+    }
+
+    if (chunk->generated && chunk->lod == 0) {
+        stashChunk(*chunk);
+    }
+    if (lod == 0 && restoreChunk(chunk)) {
+        return;
+    }
+
+    ++chunkTasksCount;
+    queueGenerateChunk(chunk);
+}
+
+void WorldManager::stashChunk(const Chunk& chunk) {
+    // Chunks still generating have no voxels worth keeping, and coarser ones are cheap to generate again
+    if (!chunk.generated || chunk.lod != 0) {
+        return;
+    }
+
+    const glm::ivec3 coords(chunk.cx, chunk.cy, chunk.cz);
+    if (!editedChunks.contains(coords) || !chunkSwap.store(coords, *chunk.voxels, chunk.minY, chunk.maxY)) {
+        chunkCache.insert(coords, {chunk.voxels.snapshot(), chunk.minY, chunk.maxY});
+    }
+}
+
+bool WorldManager::restoreChunk(const std::shared_ptr<Chunk>& chunk) {
+    // A chunk that was unloaded recently still has its voxels, edits included, in the cache, and an edited one in the
+    // swap. It's meshed along with the generated chunks in updateGeneratedChunks, once its neighbours have had a chance
+    // to be restored too.
+    std::optional<ChunkCache::Entry> cached = chunkCache.take({chunk->cx, chunk->cy, chunk->cz});
+    if (!cached) {
+        cached = chunkSwap.take({chunk->cx, chunk->cy, chunk->cz});
+    }
+    if (!cached) {
+        return false;
+    }
+
+    chunk->voxels = std::move(cached->voxels);
+    chunk->minY = cached->minY;
+    chunk->maxY = cached->maxY;
+    chunk->lod = 0;
+    chunk->generated = true;
+    restoredChunks.push_back(chunk);
+    return true;
+}
+
+void WorldManager::applyEditsToChunk(const std::shared_ptr<Chunk>& chunk) {
+    const glm::ivec3 chunkMin(chunk->cx << ChunkSizeShift, chunk->cy << ChunkHeightShift, chunk->cz << ChunkSizeShift);
+    const glm::ivec3 chunkMax = chunkMin + glm::ivec3(ChunkSize - 1, ChunkHeight - 1, ChunkSize - 1);
+
+    // A coarser chunk only holds the voxels sampled at every scale-th position, so only the edits there show in it
+    const int lod = chunk->lod;
+    const int scale = 1 << lod;
+    const auto firstSample = [scale](const int v) { return (v + scale - 1) & -scale; };
+
+    // User edits
+    if (const auto chunkEdits = userEdits.find({chunk->cx, chunk->cy, chunk->cz}); chunkEdits != userEdits.end()) {
+        for (const auto& [pos, voxelType] : chunkEdits->second) {
+            const glm::ivec3 local = pos - chunkMin;
+            if (((local.x | local.y | local.z) & (scale - 1)) != 0) {
+                continue;
+            }
+            chunk->store(local.x >> lod, local.y >> lod, local.z >> lod, voxelType);
         }
     }
 
@@ -200,37 +319,37 @@ void WorldManager::applyEditsToChunk(const std::shared_ptr<Chunk>& chunk) {
         const glm::ivec3 primMin = primitive->start + primitive->origin;
         const glm::ivec3 primMax = primitive->end + primitive->origin;
 
-        if (primMax.x < chunkMinX || primMin.x > chunkMaxX ||
-            primMax.z < chunkMinZ || primMin.z > chunkMaxZ ||
-            primMax.y < 0 || primMin.y > ChunkHeight - 1) {
+        if (glm::any(glm::lessThan(primMax, chunkMin)) || glm::any(glm::greaterThan(primMin, chunkMax))) {
             continue;
         }
 
         // Find intersection AABB
-        const int minX = std::max(chunkMinX, primMin.x);
-        const int maxX = std::min(chunkMaxX, primMax.x);
-        const int minY = std::max(0, primMin.y);
-        const int maxY = std::min(ChunkHeight - 1, primMax.y);
-        const int minZ = std::max(chunkMinZ, primMin.z);
-        const int maxZ = std::min(chunkMaxZ, primMax.z);
-
-        // Loop over intersection AABB and apply edits (the chunk will be meshed afterwards by createChunk)
-        for (int x = minX; x <= maxX; ++x) {
-            for (int y = minY; y <= maxY; ++y) {
-                for (int z = minZ; z <= maxZ; ++z) {
-                    const auto it = primitive->edits.find({x, y, z});
-                    if (it != primitive->edits.end()) {
-                        const std::optional<Edit>& editOpt = it->second;
-
-                        const int lx = x - (chunk->cx << ChunkSizeShift);
-                        const int lz = z - (chunk->cz << ChunkSizeShift);
-
-                        if (editOpt.has_value()) {
-                            chunk->store(lx, y, lz, editOpt->voxelType);
-                        } else {
-                            chunk->store(lx, y, lz, EmptyVoxel);
+        const glm::ivec3 min = glm::max(chunkMin, primMin);
+        const glm::ivec3 max = glm::min(chunkMax, primMax);
+
+        // Loop over intersection AABB and apply edits (the chunk is meshed afterwards by updateGeneratedChunks). Each
+        // column is walked upwards and written as runs of the same voxel type.
+        for (int x = firstSample(min.x); x <= max.x; x += scale) {
+            for (int z = firstSample(min.z); z <= max.z; z += scale) {
+                const glm::ivec3 local((x - chunkMin.x) >> lod, 0, (z - chunkMin.z) >> lod);
+                std::optional<Voxel> run;
+                int runBegin = 0;
+                for (int y = firstSample(min.y); y <= max.y + scale; y += scale) {
+                    std::optional<Voxel> voxelType;
+                    if (y <= max.y) {
+                        if (const auto it = primitive->edits.find({x, y, z}); it != primitive->edits.end()) {
+                            voxelType = it->second.has_value() ? it->second->voxelType : EmptyVoxel;
                         }
                     }
+
+                    if (voxelType != run) {
+                        if (run.has_value()) {
+                            chunk->fill(local.x, local.z, (runBegin - chunkMin.y) >> lod, (y - chunkMin.y) >> lod,
+                                        *run);
+                        }
+                        run = voxelType;
+                        runBegin = y;
+                    }
                 }
             }
         }
@@ -239,66 +358,143 @@ void WorldManager::applyEditsToChunk(const std::shared_ptr<Chunk>& chunk) {
 
 void WorldManager::addFrontier(const std::shared_ptr<Chunk>& chunk) {
     frontierChunks.push_back(chunk);
-    const int cx = chunk->cx;
-    const int cz = chunk->cz;
 
-    updateFrontierNeighbour(chunk, cx - 1, cz);
-    updateFrontierNeighbour(chunk, cx + 1, cz);
-    updateFrontierNeighbour(chunk, cx, cz - 1);
-    updateFrontierNeighbour(chunk, cx, cz + 1);
+    for (const auto& [dx, dy, dz] : FaceNeighbours) {
+        updateFrontierNeighbour(chunk, chunk->cx + dx, chunk->cy + dy, chunk->cz + dz);
+    }
 }
 
-void WorldManager::updateFrontierNeighbour(const std::shared_ptr<Chunk>& frontier, const int cx, const int cz) {
-    if (!chunkByCoords.contains(key(cx, cz))) {
+void WorldManager::updateFrontierNeighbour(const std::shared_ptr<Chunk>& frontier, const int cx, const int cy, const int cz) {
+    if (!chunkByCoords.contains(key(cx, cy, cz))) {
         return;
     }
 
-    std::shared_ptr<Chunk> neighbour = chunkByCoords[key(cx, cz)];
+    std::shared_ptr<Chunk> neighbour = chunkByCoords[key(cx, cy, cz)];
     ++neighbour->neighbours;
     ++frontier->neighbours;
-    if (neighbour->neighbours == 4) {
+    if (neighbour->neighbours == countPopulatedNeighbours(*neighbour)) {
         std::erase(frontierChunks, neighbour);
     }
 }
 
 int WorldManager::onFrontierChunkRemoved(glm::vec3 position, const std::shared_ptr<Chunk>& frontierChunk) {
-    const int cx = frontierChunk->cx;
-    const int cz = frontierChunk->cz;
-    const double d = squaredDistanceToChunk(position, cx, cz);
-    return onFrontierChunkRemoved(position, cx - 1, cz, d) +
-           onFrontierChunkRemoved(position, cx + 1, cz, d) +
-           onFrontierChunkRemoved(position, cx, cz - 1, d) +
-           onFrontierChunkRemoved(position, cx, cz + 1, d);
+    const double d = squaredDistanceToChunk(position, frontierChunk->cx, frontierChunk->cy, frontierChunk->cz);
+    int numPromoted = 0;
+    for (const auto& [dx, dy, dz] : FaceNeighbours) {
+        numPromoted += onFrontierChunkRemoved(position, frontierChunk->cx + dx, frontierChunk->cy + dy,
+                                              frontierChunk->cz + dz, d);
+    }
+    return numPromoted;
 }
 
-int WorldManager::onFrontierChunkRemoved(glm::vec3 position, const int cx, const int cz, const double distance) {
-    if (!chunkByCoords.contains(key(cx, cz))) {
+int WorldManager::onFrontierChunkRemoved(glm::vec3 position, const int cx, const int cy, const int cz, const double distance) {
+    if (!chunkByCoords.contains(key(cx, cy, cz))) {
         return 0;
     }
 
-    std::shared_ptr<Chunk> chunk = chunkByCoords[key(cx, cz)];
+    std::shared_ptr<Chunk> chunk = chunkByCoords[key(cx, cy, cz)];
     chunk->neighbours--;
     if (std::ranges::find(frontierChunks, chunk) == frontierChunks.end() &&
-        (chunkInRenderDistance(position, cx, cz) ||
-         squaredDistanceToChunk(position, cx, cz) < distance)) {
+        (chunkInRenderDistance(position, cx, cy, cz) ||
+         squaredDistanceToChunk(position, cx, cy, cz) < distance)) {
         frontierChunks.push_back(chunk);
         return 1;
     }
     return 0;
 }
 
-bool WorldManager::chunkInRenderDistance(glm::vec3 position, const int cx, const int cz) const {
-    return squaredDistanceToChunk(position, cx, cz) < MaxRenderDistanceMetres * MaxRenderDistanceMetres;
+bool WorldManager::chunkInRenderDistance(glm::vec3 position, const int cx, const int cy, const int cz) const {
+    return squaredDistanceToChunk(position, cx, cy, cz) < MaxRenderDistanceMetres * MaxRenderDistanceMetres;
 }
 
-double WorldManager::squaredDistanceToChunk(glm::vec3 position, const int cx, const int cz) const {
+double WorldManager::squaredDistanceToChunk(glm::vec3 position, const int cx, const int cy, const int cz) const {
     const double dx = position.x - (cx + 0.5) * ChunkSize;
     const double dz = position.z - (cz + 0.5) * ChunkSize;
-    return dx * dx + dz * dz;
+
+    // Vertically, measure to the nearest point of the chunk, so that tall chunks are loaded from anywhere alongside them
+    const double dy = std::max(0.0, std::abs(position.y - (cy + 0.5) * ChunkHeight) - ChunkHeight / 2.0) *
+                      VerticalDistanceWeight;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+double WorldManager::squaredDistanceToPath(const glm::vec3 position, const int cx, const int cy, const int cz) const {
+    const glm::vec3 centre((cx + 0.5f) * ChunkSize, (cy + 0.5f) * ChunkHeight, (cz + 0.5f) * ChunkSize);
+    return squaredDistanceToChunk(motion.nearestPoint(position, centre), cx, cy, cz);
+}
+
+double WorldManager::streamingPriority(const glm::vec3 position, const int cx, const int cy, const int cz) const {
+    const glm::vec3 centre((cx + 0.5f) * ChunkSize, (cy + 0.5f) * ChunkHeight, (cz + 0.5f) * ChunkSize);
+    const double distance = squaredDistanceToPath(position, cx, cy, cz);
+    return motion.isBehind(position, centre, ChunkSize) ? distance * BehindStreamingWeight : distance;
+}
+
+void WorldManager::predictMotion(const glm::vec3 velocity, const glm::vec3 lookDirection) {
+    motion = MotionPrediction::fromVelocity(velocity, lookDirection, prefetchSeconds, MaxRenderDistanceMetres);
+}
+
+void WorldManager::updateVisibility(const Frustum& frustum) {
+    ZoneScoped;
+
+    // Chunks the frontier hasn't reached yet aren't counted, though they're as late
+    streamingStats.unmeshedInView = 0;
+    for (const std::shared_ptr<Chunk>& chunk : chunks) {
+        if (chunk->destroyed) {
+            continue;
+        }
+
+        const glm::vec3 min(chunk->cx * ChunkSize, chunk->cy * ChunkHeight, chunk->cz * ChunkSize);
+        const bool inView = frustum.isBoxVisible(min, min + glm::vec3(ChunkSize, ChunkHeight, ChunkSize));
+
+        // Empty chunks are never meshed, as there's nothing to draw
+        const bool meshed = chunk->generated &&
+                            (chunk->meshedRequest != 0 || chunk->voxels->uniformValue() == EmptyVoxel);
+        if (inView && !meshed) {
+            ++streamingStats.unmeshedInView;
+        }
+        if (inView && !chunk->inView) {
+            ++streamingStats.viewEntries;
+            streamingStats.unmeshedEntries += !meshed;
+        }
+        chunk->inView = inView;
+    }
+}
+
+int WorldManager::lodAt(const double distance) {
+    int lod = 0;
+    for (double boundary = LodDistanceMetres; distance >= boundary && lod < MaxLod; boundary *= 2) {
+        ++lod;
+    }
+    return lod;
+}
+
+size_t WorldManager::key(const int i, const int j, const int k) {
+    // 24 bits for each of x and z, and 16 for y
+    static_assert(WorldChunkRows <= 1 << 16);
+    return (static_cast<size_t>(i) & 0xFFFFFF) << 40 |
+           (static_cast<size_t>(j) & 0xFFFF) << 24 |
+           (static_cast<size_t>(k) & 0xFFFFFF);
+}
+
+bool WorldManager::isChunkPopulated(const int cx, const int cy, const int cz) const {
+    if (cy < 0 || cy >= WorldChunkRows) {
+        return false;
+    }
+    return cy < TerrainChunkRows || editedChunks.contains({cx, cy, cz});
+}
+
+int WorldManager::countPopulatedNeighbours(const Chunk& chunk) const {
+    int count = 0;
+    for (const auto& [dx, dy, dz] : FaceNeighbours) {
+        count += isChunkPopulated(chunk.cx + dx, chunk.cy + dy, chunk.cz + dz);
+    }
+    return count;
 }
 
-size_t WorldManager::key(const int i, const int j) {
-    return static_cast<size_t>(i) << 32 | static_cast<unsigned int>(j);
+void WorldManager::markEdited(const glm::ivec3& pos) {
+    editedChunks.insert(chunkCoords(pos));
+    // The cached or swapped voxels predate the edit, so the chunk has to be generated again when it's next loaded
+    chunkCache.erase(chunkCoords(pos));
+    chunkSwap.erase(chunkCoords(pos));
 }
 
 void WorldManager::updateGeneratedChunks() {
@@ -309,14 +505,57 @@ void WorldManager::updateGeneratedChunks() {
     {
         ZoneScoped;
 
-        for (auto& [chunk, voxelField, minY, maxY] : pendingGenerationResults) {
-            chunk->voxels = std::move(voxelField);
+        // Results for a level of detail the chunk has since moved away from are dropped, since newer ones are coming
+        std::erase_if(pendingGenerationResults, [](const Chunk::GenerationResult& result) {
+            return result.lod != result.chunk->targetLod;
+        });
+
+        for (auto& [chunk, voxelField, minY, maxY, lod] : pendingGenerationResults) {
+            // Chunks of a single voxel type (all sky or all rock) share their voxels rather than allocating their own
+            if (const std::optional<Voxel> uniform = voxelField.uniformValue()) {
+                chunk->voxels.fill(*uniform);
+            } else {
+                chunk->voxels = std::move(voxelField);
+            }
             chunk->minY = minY;
             chunk->maxY = maxY;
+            chunk->lod = lod;
+            chunk->generated = true;
 
-            // Only once the generation has finished, can we call this function
-            {
-                ZoneScoped;
+            if (editedChunks.contains({chunk->cx, chunk->cy, chunk->cz})) {
+                applyEditsToChunk(chunk);
+            }
+        }
+
+        // Only once the generation has finished can the chunk be meshed. Its generated neighbours were meshed while
+        // it read as empty, so they need remeshing too.
+        // The same goes for chunks restored from the cache.
+        std::unordered_set<std::shared_ptr<Chunk>> chunksToMesh;
+        const auto addNeighbours = [&](const Chunk& centre) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        std::shared_ptr<Chunk> chunk = getChunk(centre.cx + dx, centre.cy + dy, centre.cz + dz);
+                        if (chunk && chunk->generated) {
+                            chunksToMesh.insert(chunk);
+                        }
+                    }
+                }
+            }
+        };
+        for (const Chunk::GenerationResult& result : pendingGenerationResults) {
+            addNeighbours(*result.chunk);
+        }
+        for (const std::shared_ptr<Chunk>& chunk : restoredChunks) {
+            if (!chunk->destroyed) {
+                addNeighbours(*chunk);
+            }
+        }
+        restoredChunks.clear();
+
+        {
+            ZoneScoped;
+            for (const std::shared_ptr<Chunk>& chunk : chunksToMesh) {
                 queueMeshChunk(chunk);
             }
         }
@@ -325,7 +564,8 @@ void WorldManager::updateGeneratedChunks() {
     }
 }
 
-void WorldManager::updateVerticesBuffer(const GLuint& verticesBuffer, const GLuint& chunkDataBuffer) {
+void WorldManager::updateVerticesBuffer(const GLuint& verticesBuffer, const GLuint& chunkDataBuffer,
+                                        const GLuint& chunkSectionBuffer) {
     ZoneScoped;
 
     {
@@ -340,6 +580,14 @@ void WorldManager::updateVerticesBuffer(const GLuint& verticesBuffer, const GLui
                 continue;
             }
 
+            // Mesh jobs can finish out of order, so never replace a mesh with one queued before it. Jobs are numbered
+            // rather than compared by the chunk's voxels version, since a later job may only differ in the snapshots of
+            // its neighbours.
+            if (meshResult.request < chunk->meshedRequest) {
+                continue;
+            }
+            chunk->meshedRequest = meshResult.request;
+
             // First, free up the chunk's old region in the vertex buffer (if it exists)
             if (chunk->bufferRegionAllocated) {
                 allocator.deallocate(chunk->firstIndex, chunk->numVertices);
@@ -366,16 +614,22 @@ void WorldManager::updateVerticesBuffer(const GLuint& verticesBuffer, const GLui
             // Update chunk data
             const ChunkData cd = {
                     .cx = chunk->cx,
+                    .cy = chunk->cy,
                     .cz = chunk->cz,
                     .minY = chunk->minY,
                     .maxY = chunk->maxY,
                     .numVertices = chunk->numVertices,
                     .firstIndex = chunk->firstIndex,
-                    ._pad0 = 0,
-                    ._pad1 = 0,
+                    .lod = meshResult.lod,
             };
             chunkData[chunk->index] = cd;
 
+            // Removed chunks leave their sections stale, which is fine as chunks without vertices are skipped before
+            // their sections are read
+            constexpr size_t SectionsSize = sizeof(ChunkSection) * SectionCount;
+            glNamedBufferSubData(chunkSectionBuffer, chunk->index * SectionsSize, SectionsSize,
+                                 static_cast<const void*>(meshResult.sections.data()));
+
             if (chunk->numVertices == 0) {
                 std::cerr << "Chunk has no vertices!" << std::endl;
             }
@@ -383,17 +637,17 @@ void WorldManager::updateVerticesBuffer(const GLuint& verticesBuffer, const GLui
             chunk->debug = 3;
         }
 
-        // Update chunk data buffer
-        glNamedBufferData(chunkDataBuffer, sizeof(ChunkData) * chunkData.size(),
-                          static_cast<const void*>(chunkData.data()), GL_DYNAMIC_DRAW);
+        // Update chunk data buffer. Slots past the last chunk have never been used, so they're still as first uploaded.
+        glNamedBufferSubData(chunkDataBuffer, 0, sizeof(ChunkData) * chunks.size(),
+                             static_cast<const void*>(chunkData.data()));
 
         // Reset vector ready for next update
         pendingMeshResults.clear();
     }
 }
 
-std::shared_ptr<Chunk> WorldManager::getChunk(const int cx, const int cz) {
-    if (const auto it = chunkByCoords.find(key(cx, cz)); it != chunkByCoords.end()) {
+std::shared_ptr<Chunk> WorldManager::getChunk(const int cx, const int cy, const int cz) {
+    if (const auto it = chunkByCoords.find(key(cx, cy, cz)); it != chunkByCoords.end()) {
         return it->second;
     }
     return nullptr;
@@ -401,36 +655,30 @@ std::shared_ptr<Chunk> WorldManager::getChunk(const int cx, const int cz) {
 
 void WorldManager::queueGenerateChunk(std::shared_ptr<Chunk> chunk) {
     const int cx = chunk->cx;
+    const int cy = chunk->cy;
     const int cz = chunk->cz;
+    const int lod = chunk->targetLod;
 
-    threadPool.queueTask([cx, cz, chunk, this] {
+    threadPool.queueTask([cx, cy, cz, lod, chunk, generator = generator, fingerprint = generatorFingerprint,
+                          cacheRegions = cacheRegions && lod == 0, this] {
         if (chunk->destroyed) return;
 
-        Chunk::GenerationResult result;
-
-        switch (generationType) {
-            case GenerationType::None:
-                break;
-            case GenerationType::Flat:
-                result = Chunk::generateFlat();
-                break;
-            case GenerationType::Perlin2D:
-                result = Chunk::generateVoxels2D(cx, cz);
-                break;
-            case GenerationType::Perlin3D:
-                result = Chunk::generateVoxels3D(cx, cz);
-                break;
+        // The fingerprint is the one of the generator the task started with, so a level loaded meanwhile doesn't mix
+        // the old generator's chunks into the new one's regions. Coarser chunks are quicker to generate than to read.
+        std::optional<Chunk::GenerationResult> cached;
+        if (cacheRegions) {
+            cached = regionCache.load({cx, cy, cz}, fingerprint);
+        }
+        Chunk::GenerationResult result = cached ? std::move(*cached) : generator->generate(cx, cy, cz, lod);
+        if (cacheRegions && !cached) {
+            regionCache.store({cx, cy, cz}, result, fingerprint);
         }
-
         result.chunk = chunk;
 
-        // Handle primitives
-        applyEditsToChunk(chunk);  // TODO: wrong, since chunk->voxels is not yet populated
-
-        // Update the chunk itself on the main thread
+        // Update the chunk itself on the main thread, which also applies any edits to it
         {
             std::scoped_lock lock(pendingGenerationResultsMutex);
-            pendingGenerationResults.push_back(result);
+            pendingGenerationResults.push_back(std::move(result));
         }
 
         // TODO: queueMeshChunk here maybe but using result->voxelField? Guess it doesn't matter too much
@@ -440,20 +688,46 @@ void WorldManager::queueGenerateChunk(std::shared_ptr<Chunk> chunk) {
 void WorldManager::queueMeshChunk(std::shared_ptr<Chunk> chunk) {
     ZoneScoped;
 
-    // Need the voxels vector, the minY and maxY
-    // const std::vector<int>& voxels = chunk->voxels;
-    std::vector<int> voxels;
-    {
-        ZoneScoped;
-        voxels = chunk->voxels;  // have to copy: we can't move because otherwise we will try to read while chunk->voxels is in unspecified state (with player controllers upon editing)
+    // An empty chunk has nothing to mesh, unless it has just been emptied and its old mesh needs replacing
+    if (chunk->numVertices == 0 && chunk->voxels->uniformValue() == EmptyVoxel) {
+        return;
     }
-    const int minY = chunk->minY;
+
+    // Snapshots only share the voxels, and the next edit to any of these chunks copies them before writing
+    ChunkNeighbourhood voxels(chunk->voxels.snapshot(), chunk->cy == 0);
+    const uint64_t request = ++chunk->meshRequests;
+    const int lod = chunk->lod;
+    int minY = chunk->minY;
     const int maxY = chunk->maxY;
 
-    threadPool.queueTask([chunk, voxels, minY, maxY, this] {
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                const std::shared_ptr<Chunk> neighbour = getChunk(chunk->cx + dx, chunk->cy + dy, chunk->cz + dz);
+                if ((dx == 0 && dy == 0 && dz == 0) || !neighbour || !neighbour->generated) {
+                    continue;
+                }
+
+                // Coarser chunks don't line up voxel for voxel with their neighbours, so they're meshed as if alone.
+                // The faces on their borders close the gaps where the terrain either side doesn't quite meet.
+                if (lod == 0 && neighbour->lod == 0) {
+                    voxels.setNeighbour(dx, dy, dz, neighbour->voxels.snapshot());
+                }
+
+                // Voxels below the chunk's own minY can still be exposed by a lower side neighbour
+                if (dy == 0 && (dx == 0 || dz == 0)) {
+                    minY = std::min(minY, neighbour->minY << neighbour->lod >> lod);
+                }
+            }
+        }
+    }
+
+    threadPool.queueTask([chunk, voxels = std::move(voxels), request, lod, minY, maxY, this] {
         if (chunk->destroyed) return;
 
         Mesher::MeshResult meshResult = Mesher::meshChunk(chunk, voxels, minY, maxY);
+        meshResult.request = request;
+        meshResult.lod = lod;
         // If newMeshResults is currently being iterated through, we need to wait
         {
             std::scoped_lock lock(pendingMeshResultsMutex);
@@ -480,6 +754,9 @@ void WorldManager::saveLevel() {
             levelJson["generationType"] = "Perlin3D";
             break;
     }
+    levelJson["noiseLattice"] = {noiseLattice.horizontal, noiseLattice.vertical};
+    levelJson["generator"] = generator->toJson();
+    levelJson["regionCache"] = cacheRegions;
 
     // Palette
     json paletteJson = json::array();
@@ -550,11 +827,13 @@ void WorldManager::saveLevel() {
 
     // User edits
     json userEditsJson;
-    for (const auto& [pos, voxelType] : userEdits) {
-        userEditsJson.push_back({
-            {"pos", {pos.x, pos.y, pos.z}},
-            {"voxelType", voxelType}
-        });
+    for (const Primitive::UserEditMap& chunkEdits : userEdits | std::views::values) {
+        for (const auto& [pos, voxelType] : chunkEdits) {
+            userEditsJson.push_back({
+                {"pos", {pos.x, pos.y, pos.z}},
+                {"voxelType", voxelType}
+            });
+        }
     }
     levelJson["userEdits"] = userEditsJson;
 
@@ -598,6 +877,34 @@ void WorldManager::loadLevel() {
         generationType = GenerationType::Flat;
     }
 
+    // Noise lattice steps, horizontal then vertical
+    noiseLattice = NoiseLattice{};
+    json latticeJson = levelJson.value("noiseLattice", json::array());
+    if (latticeJson.is_array() && latticeJson.size() == 2) {
+        const NoiseLattice lattice{latticeJson[0], latticeJson[1]};
+        if (lattice.isValid()) {
+            noiseLattice = lattice;
+        } else {
+            std::cerr << "Invalid noise lattice: " << latticeJson << ", defaulting to " << noiseLattice.horizontal
+                      << "x" << noiseLattice.vertical << std::endl;
+        }
+    }
+
+    // Generator stages, or the stages equivalent to the generation type for levels without any
+    std::optional<GeneratorPipeline> pipeline;
+    if (levelJson.contains("generator")) {
+        pipeline = GeneratorPipeline::fromJson(levelJson["generator"]);
+        if (!pipeline) {
+            std::cerr << "Invalid generator, defaulting to the generation type's" << std::endl;
+        }
+    }
+    if (!pipeline) {
+        pipeline = GeneratorPipeline::fromType(generationType, noiseLattice);
+    }
+    generator = std::make_shared<const GeneratorPipeline>(std::move(*pipeline));
+    generatorFingerprint = RegionCache::fingerprint(*generator);
+    cacheRegions = levelJson.value("regionCache", true);
+
     // Palette
     palette.fill(glm::vec3());
     json paletteJson = levelJson.value("palette", json::array());
@@ -613,7 +920,7 @@ void WorldManager::loadLevel() {
     json primitivesJson = levelJson.value("primitives", json::array());
     for (const auto& primitiveJson : primitivesJson) {
         // Common data
-        const int voxelType = primitiveJson.value("voxelType", 1);
+        const Voxel voxelType = primitiveJson.value("voxelType", Voxel{1});
         const auto originArray = primitiveJson.value("origin", json::array({0, 0, 0}));
         const auto startArray = primitiveJson.value("start", json::array({0, 0, 0}));
         const auto endArray = primitiveJson.value("end", json::array({0, 0, 0}));
@@ -627,7 +934,7 @@ void WorldManager::loadLevel() {
         for (const auto& editJson : userEditsJson) {
             const auto posArray = editJson.value("pos", json::array({0, 0, 0}));
             glm::ivec3 pos = glm::ivec3(posArray[0], posArray[1], posArray[2]);
-            const int editVoxelType = editJson.value("voxelType", 1);
+            const Voxel editVoxelType = editJson.value("voxelType", Voxel{1});
             primitiveUserEdits[pos] = editVoxelType;
         }
 
@@ -667,8 +974,8 @@ void WorldManager::loadLevel() {
     for (const auto& editJson : userEditsJson) {
         const auto posArray = editJson.value("pos", json::array({0, 0, 0}));
         glm::ivec3 pos = glm::ivec3(posArray[0], posArray[1], posArray[2]);
-        const int editVoxelType = editJson.value("voxelType", 1);
-        userEdits[pos] = editVoxelType;
+        const Voxel editVoxelType = editJson.value("voxelType", Voxel{1});
+        userEdits[chunkCoords(pos)][pos] = editVoxelType;
     }
 
     // Reload the world
@@ -677,30 +984,77 @@ void WorldManager::loadLevel() {
     chunkByCoords.clear();
     chunkData.clear();
     chunkData.resize(MaxChunks);
+    chunkCache.clear();
+    chunkSwap.clear();
+    restoredChunks.clear();
 
+    editedChunks.clear();
+    for (const Primitive::UserEditMap& chunkEdits : userEdits | std::views::values) {
+        markEdited(chunkEdits.begin()->first);  // Any of the chunk's edits marks it
+    }
     for (const auto& primitive : primitives) {
         placePrimitive(*primitive);
     }
 
-    createChunk(0, 0);
+    createChunk(0, 0, 0);
 
     std::cout << "Level loaded from " << levelFile << std::endl;
 }
 
-int WorldManager::load(const int x, const int y, const int z) {
-    const int cx = x >> ChunkSizeShift;
-    const int cz = z >> ChunkSizeShift;
+Voxel WorldManager::load(const int x, const int y, const int z) {
+    if (y < 0 || y >= WorldHeight) {
+        return 0;
+    }
 
-    const auto it = chunkByCoords.find(key(cx, cz));
+    const auto it = chunkByCoords.find(key(x >> ChunkSizeShift, y >> ChunkHeightShift, z >> ChunkSizeShift));
     if (it == chunkByCoords.end() || !it->second || !it->second->bufferRegionAllocated) {
         return 0;
     }
-    const std::shared_ptr<Chunk> chunk = it->second;
 
-    const int lx = x - (cx << ChunkSizeShift);
-    const int lz = z - (cz << ChunkSizeShift);
+    return it->second->load(x & (ChunkSize - 1), y & (ChunkHeight - 1), z & (ChunkSize - 1));
+}
 
-    return chunk->load(lx, y, lz);
+bool WorldManager::isSolid(const int x, const int y, const int z) {
+    if (y < 0 || y >= WorldHeight) {
+        return false;
+    }
+
+    const auto it = chunkByCoords.find(key(x >> ChunkSizeShift, y >> ChunkHeightShift, z >> ChunkSizeShift));
+    if (it == chunkByCoords.end() || !it->second || !it->second->bufferRegionAllocated) {
+        return false;
+    }
+
+    return it->second->isSolid(x & (ChunkSize - 1), y & (ChunkHeight - 1), z & (ChunkSize - 1));
+}
+
+std::optional<int> WorldManager::surfaceHeight(const int x, const int z) {
+    const int cx = x >> ChunkSizeShift;
+    const int cz = z >> ChunkSizeShift;
+    for (int cy = WorldChunkRows - 1; cy >= 0; --cy) {
+        const auto it = chunkByCoords.find(key(cx, cy, cz));
+        if (it == chunkByCoords.end() || !it->second || !it->second->bufferRegionAllocated) {
+            continue;
+        }
+
+        const Chunk& chunk = *it->second;
+        const int height = chunk.voxels->height((x & (ChunkSize - 1)) >> chunk.lod, (z & (ChunkSize - 1)) >> chunk.lod);
+        if (height > 0) {
+            return cy * ChunkHeight + (height << chunk.lod);
+        }
+    }
+    return std::nullopt;
+}
+
+size_t WorldManager::voxelMemoryUsage() const {
+    // Uniform chunks share their voxels, so only count each storage once
+    std::unordered_set<const VoxelStorage*> counted;
+    size_t total = 0;
+    for (const std::shared_ptr<Chunk>& chunk : chunks) {
+        if (!chunk->destroyed && counted.insert(&*chunk->voxels).second) {
+            total += chunk->voxels->memoryUsage();
+        }
+    }
+    return total;
 }
 
 std::optional<RaycastResult> WorldManager::raycast(glm::vec3 origin, glm::vec3 direction, int maxSteps) {
@@ -743,26 +1097,31 @@ std::optional<RaycastResult> WorldManager::raycast(glm::vec3 origin, glm::vec3 d
     };
 
     for (int i = 0; i < maxSteps && py >= 0; i++) {
-        if (i > 0 && py < ChunkHeight) {
-            const int cx = std::floor(static_cast<float>(px) / ChunkSize);
-            const int cz = std::floor(static_cast<float>(pz) / ChunkSize);
-
-            const int localX = (px % ChunkSize + ChunkSize) % ChunkSize;
-            const int localZ = (pz % ChunkSize + ChunkSize) % ChunkSize;
-
-            const std::shared_ptr<Chunk> chunk = getChunk(cx, cz);
-            if (!chunk || chunk->debug == 0) {
-                std::cout << "Chunk not found at (" << cx << ", " << cz << ")" << std::endl;
+        if (i > 0 && py < WorldHeight) {
+            const int cx = px >> ChunkSizeShift;
+            const int cy = py >> ChunkHeightShift;
+            const int cz = pz >> ChunkSizeShift;
+
+            const int localX = px & (ChunkSize - 1);
+            const int localY = py & (ChunkHeight - 1);
+            const int localZ = pz & (ChunkSize - 1);
+
+            // Chunks that were never created are empty sky, so the ray passes straight through them, as it does through
+            // generated chunks that are all air. One still being generated might hide what's behind it, so the ray
+            // stops there.
+            const std::shared_ptr<Chunk> chunk = getChunk(cx, cy, cz);
+            if (chunk && !chunk->generated) {
                 return std::nullopt;
             }
 
-            if (const int v = chunk->load(localX, py, localZ); v != 0) {
+            if (chunk && chunk->isSolid(localX, localY, localZ)) {
                 // std::cout << "Voxel hit at " << px << ", " << py << ", " << pz << ", face: " << faceHit << std::endl;
                 return RaycastResult {
                     .cx = cx,
+                    .cy = cy,
                     .cz = cz,
                     .x = localX,
-                    .y = py,
+                    .y = localY,
                     .z = localZ,
                     .face = faceHit
                 };
@@ -794,35 +1153,29 @@ std::optional<RaycastResult> WorldManager::raycast(glm::vec3 origin, glm::vec3 d
     return std::nullopt;
 }
 
-void WorldManager::tryStoreVoxel(const int cx, const int cz, const int x, const int y, const int z, const int voxelType, std::unordered_set<std::shared_ptr<Chunk>>& chunksToMesh) {
-    std::shared_ptr<Chunk> chunk = getChunk(cx, cz);
-    if (!chunk) {
-        return;
-    }
-
-    chunk->store(x, y, z, voxelType);
-    chunksToMesh.insert(chunk);
-}
-
 void WorldManager::updateVoxel(RaycastResult result, const bool place) {
-    auto [cx, cz, x, y, z, face] = result;
+    auto [cx, cy, cz, x, y, z, face] = result;
 
     if (place) {
         switch (face) {
-            case 0: x == ChunkSize - 1 ? (++cx, x = 0) : ++x; break;
-            case 1: x == 0             ? (--cx, x = ChunkSize - 1) : --x; break;
-            case 2: if (y < ChunkHeight - 2) ++y; break;
-            case 3: if (y > 0) --y; break;
-            case 4: z == ChunkSize - 1 ? (++cz, z = 0) : ++z; break;
-            case 5: z == 0             ? (--cz, z = ChunkSize - 1) : --z; break;
+            case 0: x == ChunkSize - 1   ? (++cx, x = 0) : ++x; break;
+            case 1: x == 0               ? (--cx, x = ChunkSize - 1) : --x; break;
+            case 2: y == ChunkHeight - 1 ? (++cy, y = 0) : ++y; break;
+            case 3: y == 0               ? (--cy, y = ChunkHeight - 1) : --y; break;
+            case 4: z == ChunkSize - 1   ? (++cz, z = 0) : ++z; break;
+            case 5: z == 0               ? (--cz, z = ChunkSize - 1) : --z; break;
             default:
                 std::cerr << "Invalid face: " << face << std::endl;
                 return;
         }
+
+        if (cy < 0 || cy >= WorldChunkRows) {
+            return;
+        }
     }
 
     // If the position is inside a primitive, update its edits so that the edit is preserved when moving it
-    const glm::ivec3 worldPos = glm::ivec3((cx << ChunkSizeShift) + x, y, (cz << ChunkSizeShift) + z);
+    const glm::ivec3 worldPos((cx << ChunkSizeShift) + x, (cy << ChunkHeightShift) + y, (cz << ChunkSizeShift) + z);
     for (const auto& primitive : primitives) {
         // Coarse search; can produce false positives but not false negatives
         if (primitive->isPosInside(worldPos)) {
@@ -855,75 +1208,84 @@ void WorldManager::updateVoxel(RaycastResult result, const bool place) {
                     // No edit at this position
                     // We know that we are placing here, because if we were removing, there would be an edit there
                     assert(place);
-                    editOpt = {static_cast<int>(paletteIndex + 1), 0};
-                    primitive->userEdits[localPos] = static_cast<int>(paletteIndex + 1);
+                    editOpt = {static_cast<Voxel>(paletteIndex + 1), 0};
+                    primitive->userEdits[localPos] = static_cast<Voxel>(paletteIndex + 1);
                     break;
                 }
             }
         }
     }
 
-    userEdits[{(cx << ChunkSizeShift) + x, y, (cz << ChunkSizeShift) + z}] = place ? static_cast<int>(paletteIndex + 1) : 0;
+    userEdits[chunkCoords(worldPos)][worldPos] = place ? static_cast<Voxel>(paletteIndex + 1) : EmptyVoxel;
 
     Primitive::EditMap edits;
-    edits[{(cx << ChunkSizeShift) + x, y, (cz << ChunkSizeShift) + z}] = {place ? static_cast<int>(paletteIndex + 1) : 0, 0};
+    edits[worldPos] = {place ? static_cast<Voxel>(paletteIndex + 1) : EmptyVoxel, 0};
     updateVoxels(edits);
 }
 
 void WorldManager::updateVoxels(Primitive::EditMap& edits) {
     std::unordered_set<std::shared_ptr<Chunk>> chunksToMeshSet;
+    std::unordered_set<std::shared_ptr<Chunk>> chunksToGenerate;
 
     for (auto& [pos, editOpt] : edits) {
         if (!editOpt.has_value()) continue;
 
+        if (pos.y >= WorldHeight || pos.y < 0) {
+            continue;
+        }
+
         const int cx = pos.x >> ChunkSizeShift;
+        const int cy = pos.y >> ChunkHeightShift;
         const int cz = pos.z >> ChunkSizeShift;
-        const int x = pos.x - (cx << ChunkSizeShift);
-        const int y = pos.y;
-        const int z = pos.z - (cz << ChunkSizeShift);
+        const int x = pos.x & (ChunkSize - 1);
+        const int y = pos.y & (ChunkHeight - 1);
+        const int z = pos.z & (ChunkSize - 1);
 
-        const int voxelType = editOpt->voxelType;
+        const Voxel voxelType = editOpt->voxelType;
 
-        if (y >= ChunkHeight || y < 0) {
+        // Chunks that aren't loaded (including sky that was never created) pick the edit up when they are generated
+        markEdited(pos);
+        std::shared_ptr<Chunk> chunk = getChunk(cx, cy, cz);
+        if (!chunk || !chunk->generated) {
             continue;
         }
 
-        std::shared_ptr<Chunk> chunk = getChunk(cx, cz);
-        if (!chunk) {
+        editOpt->oldVoxelType = chunk->load(x, y, z);
+
+        // Coarser chunks are generated again instead, and applyEditsToChunk keeps the edits that land on their samples.
+        // One still on its way to another level picks the edit up when it arrives.
+        if (chunk->lod != 0) {
+            if (chunk->lod == chunk->targetLod) {
+                chunksToGenerate.insert(chunk);
+            }
             continue;
         }
 
-        editOpt->oldVoxelType = chunk->load(x, y, z);
         chunk->store(x, y, z, voxelType);
 
         chunksToMeshSet.insert(chunk);
 
-        // If the voxel is on a chunk boundary, update the neighboring chunk(s)
-        if (x == 0) {
-            tryStoreVoxel(cx - 1, cz, ChunkSize, y, z, voxelType, chunksToMeshSet);
-            if (z == 0) {
-                tryStoreVoxel(cx - 1, cz - 1, ChunkSize, y, ChunkSize, voxelType, chunksToMeshSet);
-            } else if (z == ChunkSize - 1) {
-                tryStoreVoxel(cx - 1, cz + 1, ChunkSize, y, -1, voxelType, chunksToMeshSet);
-            }
-        } else if (x == ChunkSize - 1) {
-            tryStoreVoxel(cx + 1, cz, -1, y, z, voxelType, chunksToMeshSet);
-            if (z == 0) {
-                tryStoreVoxel(cx + 1, cz - 1, -1, y, ChunkSize, voxelType, chunksToMeshSet);
-            } else if (z == ChunkSize - 1) {
-                tryStoreVoxel(cx + 1, cz + 1, -1, y, -1, voxelType, chunksToMeshSet);
+        // If the voxel is on a chunk boundary, the neighbouring chunk(s) read it when meshing, so remesh them too
+        const int dx = (x == ChunkSize - 1) - (x == 0);
+        const int dy = (y == ChunkHeight - 1) - (y == 0);
+        const int dz = (z == ChunkSize - 1) - (z == 0);
+        for (const int ox : {0, dx}) {
+            for (const int oy : {0, dy}) {
+                for (const int oz : {0, dz}) {
+                    if (std::shared_ptr<Chunk> neighbour = getChunk(cx + ox, cy + oy, cz + oz)) {
+                        chunksToMeshSet.insert(neighbour);
+                    }
+                }
             }
         }
-        if (z == 0) {
-            tryStoreVoxel(cx, cz - 1, x, y, ChunkSize, voxelType, chunksToMeshSet);
-        } else if (z == ChunkSize - 1) {
-            tryStoreVoxel(cx, cz + 1, x, y, -1, voxelType, chunksToMeshSet);
-        }
     }
 
     for (std::shared_ptr<Chunk> chunk : chunksToMeshSet) {
         queueMeshChunk(chunk);
     }
+    for (const std::shared_ptr<Chunk>& chunk : chunksToGenerate) {
+        queueGenerateChunk(chunk);
+    }
 }
 
 void WorldManager::addPrimitive(std::unique_ptr<Primitive> primitive) {
@@ -983,12 +1345,12 @@ void WorldManager::removePrimitive(const size_t index) {
             if (!editOpt.has_value()) continue;
 
             int currentVoxelType = 0;
-            std::shared_ptr<Chunk> chunk = getChunk(pos.x >> ChunkSizeShift, pos.z >> ChunkSizeShift);
+            std::shared_ptr<Chunk> chunk = getChunk(pos.x >> ChunkSizeShift, pos.y >> ChunkHeightShift, pos.z >> ChunkSizeShift);
             if (!chunk) {
                 continue;
             }
 
-            currentVoxelType = chunk->load(pos.x & (ChunkSize - 1), pos.y, pos.z & (ChunkSize - 1));
+            currentVoxelType = chunk->load(pos.x & (ChunkSize - 1), pos.y & (ChunkHeight - 1), pos.z & (ChunkSize - 1));
 
             // If the voxel has been changed since we last edited it, don't change it
             if (currentVoxelType != editOpt->voxelType) {
@@ -1128,12 +1490,12 @@ void WorldManager::movePrimitive(const size_t index, const glm::ivec3& newOrigin
             if (!editOpt.has_value()) continue;
 
             int currentVoxelType = 0;
-            std::shared_ptr<Chunk> chunk = getChunk(pos.x >> ChunkSizeShift, pos.z >> ChunkSizeShift);
+            std::shared_ptr<Chunk> chunk = getChunk(pos.x >> ChunkSizeShift, pos.y >> ChunkHeightShift, pos.z >> ChunkSizeShift);
             if (!chunk) {
                 continue;
             }
 
-            currentVoxelType = chunk->load(pos.x & (ChunkSize - 1), pos.y, pos.z & (ChunkSize - 1));
+            currentVoxelType = chunk->load(pos.x & (ChunkSize - 1), pos.y & (ChunkHeight - 1), pos.z & (ChunkSize - 1));
 
             // If the voxel has been changed since we last edited it, don't change it
             if (currentVoxelType != editOpt->voxelType) {
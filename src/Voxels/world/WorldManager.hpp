@@ -1,7 +1,13 @@
 #pragma once
 
 #include "Chunk.hpp"
+#include "ChunkCache.hpp"
+#include "ChunkSwap.hpp"
+#include "Frustum.hpp"
+#include "Generator.hpp"
 #include "Mesher.hpp"
+#include "MotionPrediction.hpp"
+#include "RegionCache.hpp"
 #include "../core/FreeListAllocator.hpp"
 #include "../core/ThreadPool.hpp"
 #include "VertexFormat.hpp"
@@ -9,6 +15,7 @@
 
 #include <glad/glad.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <filesystem>
@@ -20,17 +27,25 @@
 
 struct ChunkData {
     int cx;
+    int cy;
     int cz;
     int minY;
     int maxY;
     unsigned int numVertices;
     unsigned int firstIndex;
-    unsigned int _pad0;
-    unsigned int _pad1;
+    int lod;  // Positions in the chunk's mesh are in units of 2^lod voxels
+};
+static_assert(sizeof(ChunkData) == 32, "ChunkData must match the std430 Chunk struct in the shaders");
+
+struct StreamingStats {
+    size_t viewEntries = 0;      // Times a chunk came into the view frustum
+    size_t unmeshedEntries = 0;  // Of those, the times it had no mesh yet, so popped in late
+    size_t unmeshedInView = 0;   // Chunks in the view frustum without a mesh, as of the last check
 };
 
 struct RaycastResult {
     int cx;
+    int cy;
     int cz;
     int x;
     int y;
@@ -41,9 +56,29 @@ struct RaycastResult {
 constexpr int InitialVertexBufferSize = 1 << 20;
 constexpr int MaxChunkTasks = 32;
 
-constexpr int MaxRenderDistanceChunks = 16;
-constexpr int MaxRenderDistanceMetres = MaxRenderDistanceChunks << ChunkSizeShift;
-constexpr int MaxChunks = (2 * MaxRenderDistanceChunks + 1) * (2 * MaxRenderDistanceChunks + 1);
+// The view distance is fixed in metres, so wider chunks mean fewer of them
+constexpr int MaxRenderDistanceMetres = 1024;
+constexpr int MaxRenderDistanceChunks = MaxRenderDistanceMetres >> ChunkSizeShift;
+
+// Chunks are generated at full resolution within LodDistanceMetres of the player, and a level of detail coarser for
+// every doubling of the distance past it, up to MaxLod. A chunk's level only changes once it's LodHysteresisMetres past
+// the distance its level changes at, so walking back and forth along the boundary doesn't regenerate chunks each step.
+constexpr int LodDistanceMetres = 128;
+constexpr int LodHysteresisMetres = ChunkSize;
+
+// Vertical distances count double when streaming, so the chunks around the player's own height are loaded first and
+// the interest volume is half as tall as it is wide
+constexpr int VerticalDistanceWeight = 2;
+constexpr int MaxRenderDistanceRows = (2 * MaxRenderDistanceMetres / VerticalDistanceWeight >> ChunkHeightShift) + 2;
+
+// Chunks behind the player are streamed in after those in front, as if they were twice as far away
+constexpr double BehindStreamingWeight = 4.0;  // Of squared distances
+
+constexpr int MaxChunks = (2 * MaxRenderDistanceChunks + 1) * (2 * MaxRenderDistanceChunks + 1) *
+                          std::min(MaxRenderDistanceRows, WorldChunkRows);
+
+// Every section of a chunk is culled and drawn separately, so there is a draw command per section
+constexpr int MaxChunkSections = MaxChunks * SectionCount;
 
 class WorldManager {
 public:
@@ -55,22 +90,47 @@ public:
 
     bool updateFrontierChunks(glm::vec3 position);
     void destroyFrontierChunks(glm::vec3 position);
-    bool ensureChunkIfVisible(glm::vec3 position, int cx, int cz);
-    std::shared_ptr<Chunk> ensureChunk(int cx, int cz);
-    std::shared_ptr<Chunk> createChunk(int cx, int cz);
+    bool ensureChunkIfVisible(glm::vec3 position, int cx, int cy, int cz);
+    std::shared_ptr<Chunk> ensureChunk(int cx, int cy, int cz, int lod = 0);
+    std::shared_ptr<Chunk> createChunk(int cx, int cy, int cz, int lod = 0);
+    // Moves chunks to the level of detail of their distance from position, nearest first, within the chunk task budget
+    void updateChunkLods(glm::vec3 position);
+    void setChunkLod(const std::shared_ptr<Chunk>& chunk, int lod);
+    // Keeps the full resolution voxels of a chunk being unloaded or made coarser, in case they're needed again
+    void stashChunk(const Chunk& chunk);
+    // Gives a chunk its stashed voxels back, returning false if there weren't any
+    bool restoreChunk(const std::shared_ptr<Chunk>& chunk);
     void applyEditsToChunk(const std::shared_ptr<Chunk>& chunk);
     void addFrontier(const std::shared_ptr<Chunk>& chunk);
-    void updateFrontierNeighbour(const std::shared_ptr<Chunk>& frontier, int cx, int cz);
+    void updateFrontierNeighbour(const std::shared_ptr<Chunk>& frontier, int cx, int cy, int cz);
     bool createNewFrontierChunks(glm::vec3 position);
+    bool createEditedChunks(glm::vec3 position);
     int onFrontierChunkRemoved(glm::vec3 position, const std::shared_ptr<Chunk>& frontierChunk);
-    int onFrontierChunkRemoved(glm::vec3 position, int cx, int cz, double distance);
-    bool chunkInRenderDistance(glm::vec3 position, int cx, int cz) const;
-    double squaredDistanceToChunk(glm::vec3 position, int cx, int cz) const;
-    static size_t key(int i, int j);
+    int onFrontierChunkRemoved(glm::vec3 position, int cx, int cy, int cz, double distance);
+    bool chunkInRenderDistance(glm::vec3 position, int cx, int cy, int cz) const;
+    double squaredDistanceToChunk(glm::vec3 position, int cx, int cy, int cz) const;
+    // squaredDistanceToChunk from the nearest point of the player's predicted path starting at position
+    double squaredDistanceToPath(glm::vec3 position, int cx, int cy, int cz) const;
+    // Chunks are streamed in and change level of detail in increasing order of priority
+    double streamingPriority(glm::vec3 position, int cx, int cy, int cz) const;
+    // Sets the predicted path from the player's velocity and look direction; call every frame before streaming
+    void predictMotion(glm::vec3 velocity, glm::vec3 lookDirection);
+    // Counts the chunks coming into view without a mesh, for getStreamingStats
+    void updateVisibility(const Frustum& frustum);
+    [[nodiscard]] const StreamingStats& getStreamingStats() const { return streamingStats; }
+    static int lodAt(double distance);
+    static size_t key(int i, int j, int k);
+
+    // Only chunks that can hold voxels are streamed in: the rows the terrain is generated in, plus any chunk with edits
+    bool isChunkPopulated(int cx, int cy, int cz) const;
+    int countPopulatedNeighbours(const Chunk& chunk) const;
+    void markEdited(const glm::ivec3& pos);
 
     void updateGeneratedChunks();
-    void updateVerticesBuffer(const GLuint& verticesBuffer, const GLuint& chunkDataBuffer);
-    std::shared_ptr<Chunk> getChunk(int cx, int cz);
+    // chunkSectionBuffer holds SectionCount ChunkSections per chunk, at SectionCount * chunk->index
+    void updateVerticesBuffer(const GLuint& verticesBuffer, const GLuint& chunkDataBuffer,
+                              const GLuint& chunkSectionBuffer);
+    std::shared_ptr<Chunk> getChunk(int cx, int cy, int cz);
 
     void queueGenerateChunk(std::shared_ptr<Chunk> chunk);
     void queueMeshChunk(std::shared_ptr<Chunk> chunk);
@@ -78,10 +138,13 @@ public:
     void saveLevel();
     void loadLevel();
 
-    int load(int x, int y, int z);
+    Voxel load(int x, int y, int z);
+    bool isSolid(int x, int y, int z);
+    // One above the highest solid voxel at (x, z) among the loaded chunks, read from their heightmaps
+    std::optional<int> surfaceHeight(int x, int z);
+    size_t voxelMemoryUsage() const;
 
     std::optional<RaycastResult> raycast(glm::vec3 origin, glm::vec3 direction, int maxSteps);
-    void tryStoreVoxel(int cx, int cz, int x, int y, int z, int place, std::unordered_set<std::shared_ptr<Chunk>>& chunksToMesh);
     void updateVoxel(RaycastResult result, bool place);
     void updateVoxels(Primitive::EditMap& edits);
     void addPrimitive(std::unique_ptr<Primitive> primitive);
@@ -92,6 +155,14 @@ public:
     void cleanup();
 
     GenerationType generationType;
+    NoiseLattice noiseLattice;  // Only used by GenerationType::Perlin3D
+
+    // Replaced rather than modified, so generation tasks already queued keep the pipeline they started with
+    std::shared_ptr<const GeneratorPipeline> generator;
+    uint64_t generatorFingerprint;  // RegionCache::fingerprint of the generator
+    bool cacheRegions = true;
+    float prefetchSeconds = 2.0f;  // How far ahead along the player's path chunks are prefetched
+    MotionPrediction motion;
     const std::filesystem::path levelFile;
     std::optional<std::pair<glm::ivec2, glm::ivec2>> levelChunkBounds;
 
@@ -99,13 +170,24 @@ public:
     size_t paletteIndex = 0;
 
     std::vector<std::unique_ptr<Primitive>> primitives;
-    Primitive::UserEditMap userEdits;  // global pos -> voxelType
+    // chunk coords -> global pos -> voxelType, so a chunk generated again only replays its own edits
+    std::unordered_map<glm::ivec3, Primitive::UserEditMap, IVec3Hash> userEdits;
+    std::unordered_set<glm::ivec3, IVec3Hash> editedChunks;  // chunk coords of every user or primitive edit
 
     std::vector<std::shared_ptr<Chunk>> chunks;
     std::vector<std::shared_ptr<Chunk>> frontierChunks;
     std::unordered_map<size_t, std::shared_ptr<Chunk>> chunkByCoords;
     std::vector<ChunkData> chunkData;
 
+    // Voxels of unloaded chunks, restored by createChunk instead of generating them again
+    ChunkCache chunkCache;
+    // Edited chunks are swapped out to disk instead, since they can't be generated again without replaying their edits
+    ChunkSwap chunkSwap;
+    // Generated voxels of the terrain, kept across sessions next to the level file so chunks are read back rather than
+    // generated again. Edits are applied on top, as they are to generated chunks.
+    RegionCache regionCache;
+    std::vector<std::shared_ptr<Chunk>> restoredChunks;  // Restored since the last updateGeneratedChunks, to be meshed
+
     std::vector<Chunk::GenerationResult> pendingGenerationResults;
     std::vector<Mesher::MeshResult> pendingMeshResults;
 
@@ -119,4 +201,5 @@ public:
 
 private:
     std::function<size_t(size_t)> outOfCapacityCallback;
+    StreamingStats streamingStats;
 };
@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+
+#include "Voxels/core/BufferPool.hpp"
+
+TEST(BufferPoolTest, ReleasedBuffersAreReused) {
+    BufferPool<uint64_t> pool;
+
+    std::vector<uint64_t> buffer = pool.acquire(100);
+    EXPECT_EQ(buffer.size(), 100);
+    buffer[0] = 42;
+    const uint64_t* data = buffer.data();
+    pool.release(std::move(buffer));
+
+    // Any size that fits gets the same allocation back, cleared
+    const std::vector<uint64_t> reused = pool.acquire(70);
+    EXPECT_EQ(reused.data(), data);
+    EXPECT_EQ(reused.size(), 70);
+    EXPECT_EQ(reused[0], 0);
+
+    const BufferPoolStats stats = pool.getStats();
+    EXPECT_EQ(stats.acquired, 2);
+    EXPECT_EQ(stats.reused, 1);
+    EXPECT_EQ(stats.released, 1);
+    EXPECT_EQ(stats.pooledBuffers, 0);
+}
+
+TEST(BufferPoolTest, AllocatesWhenPooledBufferIsTooSmall) {
+    BufferPool<uint64_t> pool;
+    pool.release(pool.acquire(70));
+
+    // Same bucket, but more than the pooled buffer can hold
+    const std::vector<uint64_t> buffer = pool.acquire(100);
+    EXPECT_EQ(buffer.size(), 100);
+    EXPECT_EQ(pool.getStats().reused, 0);
+    EXPECT_EQ(pool.getStats().pooledBuffers, 1);
+}
+
+TEST(BufferPoolTest, DropsBuffersBeyondLimit) {
+    BufferPool<uint64_t> pool(128 * sizeof(uint64_t));
+
+    pool.release(pool.acquire(128));
+    pool.release(pool.acquire(128));
+    pool.release(std::vector<uint64_t>(128));
+
+    const BufferPoolStats stats = pool.getStats();
+    EXPECT_EQ(stats.released, 3);
+    EXPECT_EQ(stats.pooledBuffers, 1);
+    EXPECT_EQ(stats.pooledBytes, 128 * sizeof(uint64_t));
+}
+
+TEST(BufferPoolTest, FindsBufferThatFitsBehindSmallerOne) {
+    BufferPool<uint64_t> pool;
+    std::vector<uint64_t> large = pool.acquire(100);
+    const uint64_t* data = large.data();
+    pool.release(std::move(large));
+    pool.release(std::vector<uint64_t>(70));
+
+    // The 70 element buffer was released last, but only the 100 element one holds 90
+    const std::vector<uint64_t> buffer = pool.acquire(90);
+    EXPECT_EQ(buffer.data(), data);
+    EXPECT_EQ(pool.getStats().reused, 1);
+    EXPECT_EQ(pool.getStats().pooledBuffers, 1);
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+#include "Voxels/util/PerlinNoise.hpp"
+
+namespace {
+
+using siv::perlin_detail::SimdLevel;
+
+const siv::PerlinNoise perlin{123456u};
+
+// Points on both sides of zero, an odd number of them so every vector width leaves a scalar tail
+struct Points {
+    std::vector<double> x, y, z;
+
+    Points() {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> coordinate(-300.0, 300.0);
+        for (int i = 0; i < 1001; ++i) {
+            x.push_back(coordinate(rng));
+            y.push_back(coordinate(rng));
+            z.push_back(coordinate(rng));
+        }
+    }
+};
+
+}
+
+TEST(PerlinNoiseTest, BatchesMatchTheScalarFunctionsAtEveryLevel) {
+    const Points points;
+    std::vector<double> out(points.x.size());
+    const std::uint8_t* permutation = perlin.serialize().data();
+
+    for (const SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2}) {
+        for (const int octaves : {1, 4}) {
+            const size_t done3D = siv::perlin_detail::OctaveBatch01<true>(
+                level, permutation, points.x.data(), points.y.data(), points.z.data(), out.data(), out.size(), octaves, 0.5);
+            for (size_t i = 0; i < done3D; ++i) {
+                ASSERT_NEAR(out[i], perlin.octave3D_01(points.x[i], points.y[i], points.z[i], octaves),
+                            siv::PerlinNoise::BatchTolerance);
+            }
+
+            const size_t done2D = siv::perlin_detail::OctaveBatch01<false>(
+                level, permutation, points.x.data(), points.y.data(), nullptr, out.data(), out.size(), octaves, 0.5);
+            for (size_t i = 0; i < done2D; ++i) {
+                ASSERT_NEAR(out[i], perlin.octave2D_01(points.x[i], points.y[i], octaves), siv::PerlinNoise::BatchTolerance);
+            }
+        }
+    }
+}
+
+TEST(PerlinNoiseTest, BatchedEntryPointsCoverEveryPoint) {
+    const Points points;
+    std::vector<double> out(points.x.size());
+
+    perlin.octave3D_01(points.x, points.y, points.z, out, 4);
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_NEAR(out[i], perlin.octave3D_01(points.x[i], points.y[i], points.z[i], 4), siv::PerlinNoise::BatchTolerance);
+    }
+
+    perlin.octave2D_01(points.x, points.z, out, 1);
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_NEAR(out[i], perlin.octave2D_01(points.x[i], points.z[i], 1), siv::PerlinNoise::BatchTolerance);
+    }
+}
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Voxels/util/SimplexNoise.hpp"
+
+namespace {
+
+const SimplexNoise simplex{123456u};
+
+// Points on both sides of zero, an odd number of them so the last block is padded
+struct Points {
+    std::vector<float> x, y, z;
+
+    Points() {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coordinate(-300.0f, 300.0f);
+        for (int i = 0; i < 1001; ++i) {
+            x.push_back(coordinate(rng));
+            y.push_back(coordinate(rng));
+            z.push_back(coordinate(rng));
+        }
+    }
+};
+
+}
+
+TEST(SimplexNoiseTest, NoiseCoversItsRange) {
+    const Points points;
+    float low2D = 1.0f;
+    float high2D = -1.0f;
+    float low3D = 1.0f;
+    float high3D = -1.0f;
+    for (size_t i = 0; i < points.x.size(); ++i) {
+        const float noise2D = simplex.noise2D(points.x[i], points.y[i]);
+        const float noise3D = simplex.noise3D(points.x[i], points.y[i], points.z[i]);
+        ASSERT_LE(std::abs(noise2D), 1.0f);
+        ASSERT_LE(std::abs(noise3D), 1.0f);
+        low2D = std::min(low2D, noise2D);
+        high2D = std::max(high2D, noise2D);
+        low3D = std::min(low3D, noise3D);
+        high3D = std::max(high3D, noise3D);
+
+        const float octaves = simplex.octave3D_01(points.x[i], points.y[i], points.z[i], 4);
+        ASSERT_GE(octaves, 0.0f);
+        ASSERT_LE(octaves, 1.0f);
+    }
+    EXPECT_LT(low2D, -0.5f);
+    EXPECT_GT(high2D, 0.5f);
+    EXPECT_LT(low3D, -0.5f);
+    EXPECT_GT(high3D, 0.5f);
+}
+
+TEST(SimplexNoiseTest, NoiseIsContinuous) {
+    const Points points;
+    constexpr float Step = 0.001f;
+    for (size_t i = 0; i < points.x.size(); ++i) {
+        const float x = points.x[i];
+        const float y = points.y[i];
+        const float z = points.z[i];
+        for (float t = 0.0f; t < 1.0f; t += 0.05f) {
+            // The kernels' slopes are bounded, so a small step never jumps, even across lattice cells
+            EXPECT_LT(std::abs(simplex.noise2D(x + t + Step, y) - simplex.noise2D(x + t, y)), 0.05f);
+            EXPECT_LT(std::abs(simplex.noise3D(x, y + t + Step, z) - simplex.noise3D(x, y + t, z)), 0.05f);
+        }
+    }
+}
+
+TEST(SimplexNoiseTest, BatchesMatchTheScalarFunctions) {
+    const Points points;
+    std::vector<float> out(points.x.size());
+
+    for (const int octaves : {1, 4}) {
+        simplex.octave3D_01(points.x, points.y, points.z, out, octaves);
+        for (size_t i = 0; i < out.size(); ++i) {
+            ASSERT_FLOAT_EQ(out[i], simplex.octave3D_01(points.x[i], points.y[i], points.z[i], octaves)) << i;
+        }
+
+        simplex.octave2D_01(points.x, points.z, out, octaves);
+        for (size_t i = 0; i < out.size(); ++i) {
+            ASSERT_FLOAT_EQ(out[i], simplex.octave2D_01(points.x[i], points.z[i], octaves)) << i;
+        }
+    }
+}
+
+TEST(SimplexNoiseTest, SeedsGiveDifferentNoise) {
+    const Points points;
+    const SimplexNoise same{123456u};
+    const SimplexNoise other{654321u};
+    size_t differences = 0;
+    for (size_t i = 0; i < points.x.size(); ++i) {
+        ASSERT_EQ(same.noise3D(points.x[i], points.y[i], points.z[i]),
+                  simplex.noise3D(points.x[i], points.y[i], points.z[i]));
+        differences += other.noise3D(points.x[i], points.y[i], points.z[i]) !=
+                       simplex.noise3D(points.x[i], points.y[i], points.z[i]);
+    }
+    EXPECT_GT(differences, points.x.size() / 2);
+}
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+
+#include "Voxels/world/ChunkCache.hpp"
+
+namespace {
+
+// A chunk with a few different voxels, so it takes real memory unlike a uniform one
+ChunkCache::Entry mixedChunk(const Voxel v) {
+    VoxelStorage voxels;
+    for (int x = 0; x < ChunkSize; ++x) {
+        voxels.store(x, 0, x, v);
+        voxels.store(x, 1, 0, static_cast<Voxel>(v + 1));
+    }
+    return {std::make_shared<const VoxelStorage>(std::move(voxels)), 0, 2};
+}
+
+}
+
+TEST(ChunkCacheTest, TakeReturnsTheChunkOnceAndCountsHitsAndMisses) {
+    ChunkCache cache;
+    cache.insert({1, 0, -2}, mixedChunk(3));
+
+    const std::optional<ChunkCache::Entry> entry = cache.take({1, 0, -2});
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->voxels->load(5, 0, 5), 3);
+    EXPECT_EQ(entry->maxY, 2);
+
+    EXPECT_FALSE(cache.take({1, 0, -2}).has_value());
+    EXPECT_FALSE(cache.take({0, 0, 0}).has_value());
+
+    const ChunkCacheStats& stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.entries, 0);
+    EXPECT_EQ(stats.bytes, 0);
+}
+
+TEST(ChunkCacheTest, EvictsTheLeastRecentlyInsertedChunksOverBudget) {
+    ChunkCache probe;
+    probe.insert({0, 0, 0}, mixedChunk(1));
+    const size_t chunkBytes = probe.getStats().bytes;
+
+    ChunkCache cache(3 * chunkBytes);
+    for (int i = 0; i < 5; ++i) {
+        cache.insert({i, 0, 0}, mixedChunk(1));
+    }
+
+    EXPECT_EQ(cache.getStats().entries, 3);
+    EXPECT_EQ(cache.getStats().evictions, 2);
+    EXPECT_LE(cache.getStats().bytes, 3 * chunkBytes);
+    EXPECT_FALSE(cache.take({0, 0, 0}).has_value());
+    EXPECT_FALSE(cache.take({1, 0, 0}).has_value());
+    EXPECT_TRUE(cache.take({4, 0, 0}).has_value());
+}
+
+TEST(ChunkCacheTest, UniformChunksCostAlmostNothing) {
+    ChunkCache cache;
+    VoxelStorage sky;
+    cache.insert({0, 0, 0}, {std::make_shared<const VoxelStorage>(std::move(sky)), ChunkHeight, 0});
+    const size_t uniformBytes = cache.getStats().bytes;
+
+    cache.insert({1, 0, 0}, mixedChunk(1));
+    EXPECT_LT(uniformBytes, cache.getStats().bytes - uniformBytes);
+}
+
+TEST(ChunkCacheTest, ErasedAndReplacedChunksAreNotReturnedStale) {
+    ChunkCache cache;
+    cache.insert({0, 0, 0}, mixedChunk(1));
+    cache.insert({0, 0, 0}, mixedChunk(4));
+    EXPECT_EQ(cache.getStats().entries, 1);
+    EXPECT_EQ(cache.take({0, 0, 0})->voxels->load(0, 0, 0), 4);
+
+    cache.insert({0, 1, 0}, mixedChunk(1));
+    cache.erase({0, 1, 0});
+    EXPECT_FALSE(cache.take({0, 1, 0}).has_value());
+}
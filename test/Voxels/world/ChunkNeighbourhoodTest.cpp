@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+
+#include "Voxels/world/ChunkNeighbourhood.hpp"
+
+namespace {
+
+ChunkNeighbourhood::Snapshot solidStorage(const int sections) {
+    auto storage = std::make_shared<VoxelStorage>();
+    for (int s = 0; s < sections; ++s) {
+        storage->fillSection(s, 2);
+    }
+    return storage;
+}
+
+}
+
+TEST(ChunkNeighbourhoodTest, LoadsAcrossBorders) {
+    auto centre = std::make_shared<VoxelStorage>();
+    auto east = std::make_shared<VoxelStorage>();
+    auto northWest = std::make_shared<VoxelStorage>();
+    centre->store(ChunkSize - 1, 3, 4, 1);
+    east->store(0, 3, 4, 2);
+    northWest->store(ChunkSize - 1, 5, ChunkSize - 1, 3);
+
+    ChunkNeighbourhood voxels(centre);
+    voxels.setNeighbour(1, 0, 0, east);
+    voxels.setNeighbour(-1, 0, -1, northWest);
+
+    EXPECT_EQ(voxels.load(ChunkSize - 1, 3, 4), 1);
+    EXPECT_EQ(voxels.load(ChunkSize, 3, 4), 2);
+    EXPECT_EQ(voxels.load(-1, 5, -1), 3);
+    EXPECT_EQ(voxels.neighbour(1, 0, 0), east.get());
+}
+
+TEST(ChunkNeighbourhoodTest, MissingNeighboursReadAsEmpty) {
+    const ChunkNeighbourhood voxels(solidStorage(SectionCount));
+
+    EXPECT_EQ(voxels.load(0, 0, 0), 2);
+    EXPECT_EQ(voxels.load(-1, 0, 0), EmptyVoxel);
+    EXPECT_EQ(voxels.load(3, 0, ChunkSize), EmptyVoxel);
+    EXPECT_EQ(voxels.load(0, ChunkHeight, 0), EmptyVoxel);
+    EXPECT_EQ(voxels.neighbour(0, 0, 1), nullptr);
+}
+
+TEST(ChunkNeighbourhoodTest, LayerEnclosedNeedsSolidSideNeighbours) {
+    if (SectionCount < 3) {
+        GTEST_SKIP() << "Needs chunks at least three sections tall";
+    }
+    ChunkNeighbourhood voxels(solidStorage(2), true);
+    EXPECT_FALSE(voxels.isLayerEnclosed(SectionHeight));
+
+    for (const auto& [dx, dz] : {std::pair{-1, 0}, {1, 0}, {0, -1}, {0, 1}}) {
+        voxels.setNeighbour(dx, 0, dz, solidStorage(2));
+    }
+    EXPECT_TRUE(voxels.isLayerEnclosed(0));
+    EXPECT_TRUE(voxels.isLayerEnclosed(SectionHeight));
+    // Top layer of section 1 is next to the empty section 2
+    EXPECT_FALSE(voxels.isLayerEnclosed(2 * SectionHeight - 1));
+
+    voxels.setNeighbour(0, 0, 1, solidStorage(1));
+    EXPECT_FALSE(voxels.isLayerEnclosed(SectionHeight));
+}
+
+TEST(ChunkNeighbourhoodTest, ReadsChunksAboveAndBelow) {
+    auto above = std::make_shared<VoxelStorage>();
+    above->store(2, 0, 3, 4);
+
+    ChunkNeighbourhood voxels(std::make_shared<VoxelStorage>());
+    voxels.setNeighbour(0, 1, 0, above);
+    voxels.setNeighbour(1, -1, 0, solidStorage(SectionCount));
+
+    EXPECT_EQ(voxels.load(2, ChunkHeight, 3), 4);
+    EXPECT_TRUE(voxels.isSolid(2, ChunkHeight, 3));
+    EXPECT_TRUE(voxels.isSolid(ChunkSize, -1, 0));
+    EXPECT_FALSE(voxels.isSolid(0, -1, 0));
+}
+
+TEST(ChunkNeighbourhoodTest, FloorOfTheWorldIsSolid) {
+    ChunkNeighbourhood floored(solidStorage(1), true);
+    ChunkNeighbourhood floating(solidStorage(1));
+    for (const auto& [dx, dz] : {std::pair{-1, 0}, {1, 0}, {0, -1}, {0, 1}}) {
+        floored.setNeighbour(dx, 0, dz, solidStorage(1));
+        floating.setNeighbour(dx, 0, dz, solidStorage(1));
+    }
+
+    EXPECT_TRUE(floored.isSolid(0, -1, 0));
+    EXPECT_EQ(floored.load(0, -1, 0), EmptyVoxel);
+    EXPECT_TRUE(floored.isLayerEnclosed(0));
+
+    EXPECT_FALSE(floating.isSolid(0, -1, 0));
+    EXPECT_FALSE(floating.isLayerEnclosed(0));
+}
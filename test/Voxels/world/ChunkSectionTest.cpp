@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+
+#include "Voxels/world/Frustum.hpp"
+#include "Voxels/world/Mesher.hpp"
+#include "Voxels/world/VertexFormat.hpp"
+
+namespace {
+
+// Heightmap terrain whose surface rises well into the upper sections of the chunk
+Mesher::MeshResult meshHills() {
+    Chunk::GenerationResult result = Chunk::generateVoxels2D(-5, 0, 7);
+    const ChunkNeighbourhood voxels(std::make_shared<const VoxelStorage>(std::move(result.voxelField)), true);
+    return Mesher::meshChunk(std::make_shared<Chunk>(-5, 0, 7), voxels, result.minY, result.maxY);
+}
+
+glm::ivec3 vertexPosition(const uint32_t vertex) {
+    return {
+        static_cast<int>(vertex >> VertexFormat::XShift & VertexFormat::XMask),
+        static_cast<int>(vertex >> VertexFormat::YShift & VertexFormat::YMask),
+        static_cast<int>(vertex >> VertexFormat::ZShift & VertexFormat::ZMask),
+    };
+}
+
+glm::vec3 unpackBounds(const uint32_t bounds) {
+    return {ChunkSection::boundsX(bounds), ChunkSection::boundsY(bounds), ChunkSection::boundsZ(bounds)};
+}
+
+// Everything at or above y is visible
+Frustum above(const float y) {
+    constexpr glm::vec4 Everything(0.0f, 0.0f, 0.0f, 1.0f);
+    return {{glm::vec4(0.0f, 1.0f, 0.0f, -y), Everything, Everything, Everything, Everything, Everything}};
+}
+
+}
+
+TEST(ChunkSectionTest, SectionsPartitionTheMesh) {
+    const Mesher::MeshResult mesh = meshHills();
+
+    uint32_t next = 0;
+    for (const ChunkSection& section : mesh.sections) {
+        EXPECT_EQ(section.firstVertex, next);
+        next += section.numVertices;
+    }
+    EXPECT_EQ(next, mesh.vertices.size());
+}
+
+TEST(ChunkSectionTest, VerticesLieWithinTheirSectionBounds) {
+    const Mesher::MeshResult mesh = meshHills();
+
+    for (const ChunkSection& section : mesh.sections) {
+        const glm::vec3 min = unpackBounds(section.boundsMin);
+        const glm::vec3 max = unpackBounds(section.boundsMax);
+        for (uint32_t i = section.firstVertex; i < section.firstVertex + section.numVertices; ++i) {
+            const glm::ivec3 p = vertexPosition(mesh.vertices[i]);
+            ASSERT_TRUE(min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y && min.z <= p.z && p.z <= max.z);
+        }
+    }
+}
+
+// The sections drawn must include every vertex in view, and should be fewer than the whole chunk's column
+TEST(ChunkSectionTest, SectionCullingKeepsVisibleVerticesAndDrawsFewer) {
+    if (SectionCount < 4) {
+        GTEST_SKIP() << "Needs chunks at least four sections tall";
+    }
+    const Mesher::MeshResult mesh = meshHills();
+    const Frustum frustum = above(ChunkHeight / 2.0f);
+
+    size_t drawn = 0;
+    for (const ChunkSection& section : mesh.sections) {
+        const bool visible = section.numVertices > 0 &&
+                             frustum.isBoxVisible(unpackBounds(section.boundsMin), unpackBounds(section.boundsMax));
+        if (visible) {
+            drawn += section.numVertices;
+            continue;
+        }
+
+        for (uint32_t i = section.firstVertex; i < section.firstVertex + section.numVertices; ++i) {
+            ASSERT_LT(vertexPosition(mesh.vertices[i]).y, ChunkHeight / 2);
+        }
+    }
+
+    EXPECT_GT(drawn, 0);
+    EXPECT_LT(drawn, mesh.vertices.size());
+}
@@ -0,0 +1,206 @@
+#include "gtest/gtest.h"
+
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "Voxels/world/ChunkSwap.hpp"
+
+namespace {
+
+std::filesystem::path swapPath() {
+    return std::filesystem::temp_directory_path() / "ChunkSwapTest.swap";
+}
+
+// Terrain in the lower half, a scattering of edits and a section of a single voxel type
+VoxelStorage editedChunk() {
+    VoxelStorage voxels;
+    for (int z = 0; z < ChunkSize; ++z) {
+        for (int x = 0; x < ChunkSize; ++x) {
+            for (int y = 0; y < ChunkHeight / 2; ++y) {
+                voxels.store(x, y, z, static_cast<Voxel>(1 + (x * 7 + y * 3 + z) % 5));
+            }
+        }
+    }
+    voxels.store(3, ChunkHeight - 1, 4, 2);
+    voxels.fillSection(0, 6);
+    return voxels;
+}
+
+template<typename T>
+void append(std::vector<std::byte>& bytes, const T& value) {
+    const size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+void expectSameVoxels(const VoxelStorage& a, const VoxelStorage& b) {
+    for (int y = 0; y < ChunkHeight; ++y) {
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                ASSERT_EQ(a.load(x, y, z), b.load(x, y, z)) << x << ", " << y << ", " << z;
+            }
+        }
+        ASSERT_EQ(a.isSolid(0, y, 0), b.isSolid(0, y, 0));
+    }
+    for (int z = 0; z < ChunkSize; ++z) {
+        for (int x = 0; x < ChunkSize; ++x) {
+            ASSERT_EQ(a.height(x, z), b.height(x, z));
+        }
+    }
+}
+
+}
+
+TEST(ChunkSwapTest, EncodingRoundTripsSections) {
+    const VoxelStorage voxels = editedChunk();
+    std::vector<std::byte> bytes;
+    ChunkSwap::encode(voxels, bytes);
+
+    const std::optional<VoxelStorage> decoded = ChunkSwap::decode(bytes);
+    ASSERT_TRUE(decoded.has_value());
+    expectSameVoxels(*decoded, voxels);
+}
+
+TEST(ChunkSwapTest, EncodingRoundTripsColumns) {
+    VoxelStorage voxels(VoxelStorage::Representation::Columns);
+    for (int z = 0; z < ChunkSize; ++z) {
+        for (int x = 0; x < ChunkSize; ++x) {
+            const auto height = static_cast<uint16_t>((x + z) % (ChunkHeight - 3) + 1);
+            const ColumnStorage::Span column[] = {{1, height}, {EmptyVoxel, 2}, {3, 1}};
+            voxels.setColumn(x, z, column);
+        }
+    }
+    std::vector<std::byte> bytes;
+    ChunkSwap::encode(voxels, bytes);
+
+    const std::optional<VoxelStorage> decoded = ChunkSwap::decode(bytes);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->getRepresentation(), VoxelStorage::Representation::Columns);
+    expectSameVoxels(*decoded, voxels);
+}
+
+// Region files persist between runs, so may be cut short or overwritten
+TEST(ChunkSwapTest, DecodingRejectsInvalidBytes) {
+    std::vector<std::byte> bytes;
+    ChunkSwap::encode(editedChunk(), bytes);
+    EXPECT_FALSE(ChunkSwap::decode(std::span(bytes).first(bytes.size() - 1)).has_value());
+    bytes.push_back(std::byte{0});
+    EXPECT_FALSE(ChunkSwap::decode(bytes).has_value());
+    EXPECT_FALSE(ChunkSwap::decode({}).has_value());
+
+    // Runs that would never finish the section, or would run past its end
+    for (const uint32_t length : {uint32_t{0}, static_cast<uint32_t>(SectionVolume + 1)}) {
+        bytes.clear();
+        append(bytes, VoxelStorage::Representation::Sections);
+        append(bytes, uint8_t{1});
+        append(bytes, Voxel{2});
+        append(bytes, length);
+        EXPECT_FALSE(ChunkSwap::decode(bytes).has_value()) << length;
+    }
+
+    // A column taller than the chunk
+    bytes.clear();
+    append(bytes, VoxelStorage::Representation::Columns);
+    append(bytes, uint16_t{1});
+    append(bytes, Voxel{2});
+    append(bytes, static_cast<uint16_t>(ChunkHeight + 1));
+    EXPECT_FALSE(ChunkSwap::decode(bytes).has_value());
+}
+
+TEST(ChunkSwapTest, TakeReadsBackWhatWasStoredOnce) {
+    ChunkSwap swap(swapPath());
+    const VoxelStorage voxels = editedChunk();
+    ASSERT_TRUE(swap.store({2, 0, -1}, voxels, 0, ChunkHeight));
+    ASSERT_TRUE(swap.store({3, 0, -1}, VoxelStorage(), ChunkHeight, 0));
+    EXPECT_TRUE(std::filesystem::exists(swapPath()));
+
+    const std::optional<ChunkCache::Entry> entry = swap.take({2, 0, -1});
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->maxY, ChunkHeight);
+    expectSameVoxels(*entry->voxels, voxels);
+    EXPECT_FALSE(swap.take({2, 0, -1}).has_value());
+
+    swap.erase({3, 0, -1});
+    EXPECT_FALSE(swap.contains({3, 0, -1}));
+    EXPECT_EQ(swap.getStats().entries, 0);
+    EXPECT_EQ(swap.getStats().bytes, 0);
+
+    swap.clear();
+    EXPECT_FALSE(std::filesystem::exists(swapPath()));
+}
+
+#ifndef _WIN32
+namespace {
+
+// Lowers the process's file size limit, ignoring the signal sent when a write goes past it, until destroyed
+class FileSizeLimit {
+public:
+    explicit FileSizeLimit(const rlim_t bytes) {
+        active = getrlimit(RLIMIT_FSIZE, &original) == 0;
+        rlimit limited = original;
+        limited.rlim_cur = bytes;
+        active = active && setrlimit(RLIMIT_FSIZE, &limited) == 0;
+        handler = std::signal(SIGXFSZ, SIG_IGN);
+    }
+
+    FileSizeLimit(const FileSizeLimit&) = delete;
+    FileSizeLimit& operator=(const FileSizeLimit&) = delete;
+
+    ~FileSizeLimit() {
+        if (active) {
+            setrlimit(RLIMIT_FSIZE, &original);
+        }
+        std::signal(SIGXFSZ, handler);
+    }
+
+    [[nodiscard]] bool isActive() const { return active; }
+
+private:
+    rlimit original{};
+    bool active;
+    void (*handler)(int);
+};
+
+}
+
+// Growing the file fails past the process's file size limit, which unmaps it. Every chunk in it is dropped rather than
+// read back from a file that's been truncated, so they're generated again instead.
+TEST(ChunkSwapTest, FailingToGrowDropsEveryChunk) {
+    constexpr size_t Limit = size_t{16} << 20;
+    ChunkSwap swap(swapPath());
+    const VoxelStorage voxels = editedChunk();
+
+    // Each chunk takes at least the size of its encoding, so no more than this many fit under the limit
+    std::vector<std::byte> bytes;
+    ChunkSwap::encode(voxels, bytes);
+    const int bound = static_cast<int>(Limit / bytes.size()) + 1;
+
+    int stored = 0;
+    {
+        const FileSizeLimit limit(Limit);
+        ASSERT_TRUE(limit.isActive());
+        while (stored < bound && swap.store({stored, 0, 0}, voxels, 0, ChunkHeight)) {
+            ++stored;
+        }
+    }
+    ASSERT_GT(stored, 0);
+    ASSERT_LT(stored, bound);
+
+    EXPECT_FALSE(swap.contains({0, 0, 0}));
+    EXPECT_FALSE(swap.take({0, 0, 0}).has_value());
+    EXPECT_EQ(swap.getStats().entries, 0);
+    EXPECT_EQ(swap.getStats().bytes, 0);
+
+    // The swap starts over with a new file
+    ASSERT_TRUE(swap.store({1, 0, 0}, voxels, 0, ChunkHeight));
+    const std::optional<ChunkCache::Entry> entry = swap.take({1, 0, 0});
+    ASSERT_TRUE(entry.has_value());
+    expectSameVoxels(*entry->voxels, voxels);
+    swap.clear();
+}
+#endif
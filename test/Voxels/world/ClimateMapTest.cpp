@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <set>
+#include <string>
+
+#include "Voxels/world/ClimateMap.hpp"
+
+TEST(ClimateMapTest, ClimateIsContinuousAcrossRegions) {
+    ClimateMap climate(NoiseBackend::Perlin, 99u);
+    for (int z = -ClimateMap::RegionSize - 40; z < ClimateMap::RegionSize + 40; z += 7) {
+        for (int x = -ClimateMap::RegionSize - 3; x < ClimateMap::RegionSize + 3; ++x) {
+            const ClimateMap::Sample here = climate.at(x, z);
+            const ClimateMap::Sample next = climate.at(x + 1, z);
+            const ClimateMap::Sample below = climate.at(x, z + 1);
+            ASSERT_GE(here.climate.temperature, 0.0f);
+            ASSERT_LE(here.climate.temperature, 1.0f);
+            ASSERT_GE(here.climate.humidity, 0.0f);
+            ASSERT_LE(here.climate.humidity, 1.0f);
+            ASSERT_NEAR(here.climate.temperature, next.climate.temperature, 0.02f) << x << ", " << z;
+            ASSERT_NEAR(here.climate.humidity, below.climate.humidity, 0.02f) << x << ", " << z;
+            ASSERT_NEAR(here.shape.height, next.shape.height, 0.05f) << x << ", " << z;
+        }
+    }
+
+    const ClimateMapStats stats = climate.getStats();
+    EXPECT_EQ(stats.misses, 16);
+    EXPECT_EQ(stats.tiles, 16);
+}
+
+TEST(ClimateMapTest, EvictsTheLeastRecentlyUsedRegions) {
+    ClimateMap climate(NoiseBackend::Simplex, 7u, 2);
+    const auto kept = climate.regionAt(0, 0);
+    const ClimateMap::Sample sample = kept->at(100, 200);
+    (void)climate.regionAt(ClimateMap::RegionSize, 0);
+    (void)climate.regionAt(0, 0);
+    (void)climate.regionAt(0, ClimateMap::RegionSize);
+
+    const ClimateMapStats stats = climate.getStats();
+    EXPECT_EQ(stats.misses, 3);
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(stats.tiles, 2);
+
+    // Regions are sampled the same way each time
+    EXPECT_EQ(ClimateMap(NoiseBackend::Simplex, 7u).at(100, 200).climate.humidity, sample.climate.humidity);
+}
+
+TEST(ClimateMapTest, BiomesAreMostPronouncedAtTheirOwnClimate) {
+    for (const Biome& biome : Biome::all()) {
+        EXPECT_EQ(&Biome::nearest(biome.climate), &biome) << biome.name;
+        const TerrainShape shape = Biome::blend(biome.climate);
+        EXPECT_NEAR(shape.height, biome.shape.height, 0.01f) << biome.name;
+        EXPECT_NEAR(shape.relief, biome.shape.relief, 0.01f) << biome.name;
+    }
+}
+
+TEST(ClimateMapTest, TheTerrainHasSeveralBiomes) {
+    std::set<std::string> found;
+    for (int rz = -8; rz < 8; ++rz) {
+        for (int rx = -8; rx < 8; ++rx) {
+            const int x = rx * ClimateMap::RegionSize + ClimateMap::RegionSize / 2;
+            const int z = rz * ClimateMap::RegionSize + ClimateMap::RegionSize / 2;
+            found.insert(Biome::nearest(ClimateMap::climate(NoiseBackend::Perlin).at(x, z).climate).name);
+        }
+    }
+    EXPECT_GE(found.size(), 4) << found.size();
+}
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+
+#include <array>
+
+#include "Voxels/world/ColumnStorage.hpp"
+#include "Voxels/world/VoxelStorage.hpp"
+
+TEST(ColumnStorageTest, LoadFollowsSpans) {
+    ColumnStorage storage;
+    const std::array<ColumnStorage::Span, 2> spans{{{.type = 2, .length = 10}, {.type = 1, .length = 1}}};
+    storage.setColumn(3, 4, spans);
+
+    EXPECT_EQ(storage.load(3, 0, 4), 2);
+    EXPECT_EQ(storage.load(3, 9, 4), 2);
+    EXPECT_EQ(storage.load(3, 10, 4), 1);
+    EXPECT_EQ(storage.load(3, 11, 4), EmptyVoxel);
+    EXPECT_EQ(storage.load(4, 0, 4), EmptyVoxel);
+    EXPECT_EQ(storage.top(), 11);
+}
+
+TEST(ColumnStorageTest, StoreMergesAndSplitsSpans) {
+    ColumnStorage storage;
+    const std::array<ColumnStorage::Span, 1> spans{{{.type = 2, .length = 10}}};
+    storage.setColumn(0, 0, spans);
+    storage.setColumn(1, 0, spans);
+
+    // Splitting a span in the middle of the column
+    EXPECT_EQ(storage.store(0, 5, 0, 3), 3u);
+    EXPECT_EQ(storage.load(0, 4, 0), 2);
+    EXPECT_EQ(storage.load(0, 5, 0), 3);
+    EXPECT_EQ(storage.load(0, 6, 0), 2);
+
+    // Restoring the original type merges the spans again
+    EXPECT_EQ(storage.store(0, 5, 0, 2), 1u);
+
+    // Removing the top voxel lowers the column, but another column still holds the overall top
+    storage.store(0, 9, 0, EmptyVoxel);
+    EXPECT_EQ(storage.column(0, 0).back().length, 9);
+    EXPECT_EQ(storage.top(), 10);
+    EXPECT_EQ(storage.load(1, 9, 0), 2);
+}
+
+TEST(ColumnStorageTest, HeavilyEditedColumnDensifies) {
+    if (ChunkHeight <= 20) {
+        GTEST_SKIP() << "Needs chunks taller than the test column";
+    }
+    VoxelStorage storage(VoxelStorage::Representation::Columns);
+    const std::array<ColumnStorage::Span, 1> spans{{{.type = 2, .length = 20}}};
+    storage.setColumn(1, 1, spans);
+
+    // Each hole punched into the column adds two spans
+    int y = 1;
+    for (size_t count = 1; count + 2 <= ColumnStorage::MaxSpans; count += 2, y += 2) {
+        storage.store(1, y, 1, EmptyVoxel);
+    }
+    EXPECT_EQ(storage.getRepresentation(), VoxelStorage::Representation::Columns);
+
+    storage.store(1, y, 1, EmptyVoxel);
+    EXPECT_EQ(storage.getRepresentation(), VoxelStorage::Representation::Sections);
+    EXPECT_EQ(storage.load(1, 0, 1), 2);
+    EXPECT_EQ(storage.load(1, 1, 1), EmptyVoxel);
+    EXPECT_EQ(storage.load(1, 19, 1), 2);
+    EXPECT_EQ(storage.load(1, 20, 1), EmptyVoxel);
+}
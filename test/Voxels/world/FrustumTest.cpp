@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+
+#include <random>
+
+#include "Voxels/world/Frustum.hpp"
+
+TEST(FrustumTest, BoxesAreCulledOnlyWhenEveryCornerIsBehindAPlane) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> coordinate(-400.0f, 400.0f);
+    std::uniform_real_distribution<float> size(1.0f, 64.0f);
+
+    int visible = 0;
+    constexpr int Boxes = 10000;
+    for (int i = 0; i < Boxes; ++i) {
+        // A fresh set of planes every few boxes, at any angle and within reach of the boxes
+        static Frustum frustum;
+        if (i % 100 == 0) {
+            for (glm::vec4& plane : frustum.planes) {
+                plane = glm::vec4(unit(random), unit(random), unit(random), 200.0f * unit(random));
+            }
+        }
+
+        const glm::vec3 min(coordinate(random), coordinate(random), coordinate(random));
+        const glm::vec3 max = min + glm::vec3(size(random), size(random), size(random));
+
+        bool expected = true;
+        for (const glm::vec4& plane : frustum.planes) {
+            int outside = 0;
+            for (int corner = 0; corner < 8; ++corner) {
+                const glm::vec4 point(corner & 1 ? max.x : min.x, corner & 2 ? max.y : min.y,
+                                      corner & 4 ? max.z : min.z, 1.0f);
+                outside += glm::dot(plane, point) < 0.0f;
+            }
+            expected = expected && outside < 8;
+        }
+        ASSERT_EQ(frustum.isBoxVisible(min, max), expected) << i;
+        visible += expected;
+    }
+    EXPECT_GT(visible, 0);
+    EXPECT_LT(visible, Boxes);
+}
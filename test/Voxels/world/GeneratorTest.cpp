@@ -0,0 +1,303 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <set>
+
+#include "Voxels/world/ClimateMap.hpp"
+#include "Voxels/world/Generator.hpp"
+#include "Voxels/world/HeightmapCache.hpp"
+#include "Voxels/world/RegionCache.hpp"
+
+namespace {
+
+using json = nlohmann::json;
+
+constexpr Voxel Trunk = 4;
+constexpr Voxel Leaves = 5;
+
+void expectSameVoxels(const VoxelStorage& a, const VoxelStorage& b) {
+    for (int y = 0; y < ChunkHeight; ++y) {
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                ASSERT_EQ(a.load(x, y, z), b.load(x, y, z)) << x << ", " << y << ", " << z;
+            }
+        }
+    }
+}
+
+// Voxel at world position (x, y, z) of a pipeline's terrain, generating the chunk containing it
+Voxel worldVoxel(const GeneratorPipeline& pipeline, const int x, const int y, const int z) {
+    const int cx = x >> ChunkSizeShift;
+    const int cy = y >> ChunkHeightShift;
+    const int cz = z >> ChunkSizeShift;
+    return pipeline.generate(cx, cy, cz).voxelField.load(x & (ChunkSize - 1), y & (ChunkHeight - 1),
+                                                         z & (ChunkSize - 1));
+}
+
+}
+
+TEST(GeneratorTest, TypesMatchChunkGeneration) {
+    for (const GenerationType type : {GenerationType::Flat, GenerationType::Perlin2D, GenerationType::Perlin3D}) {
+        const Chunk::GenerationResult expected = Chunk::generate(type, 3, 0, -2);
+        const Chunk::GenerationResult result = GeneratorPipeline::fromType(type).generate(3, 0, -2);
+        EXPECT_EQ(result.minY, expected.minY);
+        EXPECT_EQ(result.maxY, expected.maxY);
+        expectSameVoxels(result.voxelField, expected.voxelField);
+    }
+}
+
+TEST(GeneratorTest, StagesRoundTripThroughJson) {
+    const json stages = json::parse(R"([
+        {"stage": "heightmap"},
+        {"stage": "caves", "threshold": 0.65, "lattice": [2, 4]},
+        {"stage": "trees", "chance": 0.05, "trunk": 4, "leaves": 5}
+    ])");
+    const std::optional<GeneratorPipeline> pipeline = GeneratorPipeline::fromJson(stages);
+    ASSERT_TRUE(pipeline.has_value());
+    EXPECT_EQ(pipeline->stageCount(), 3);
+    EXPECT_EQ(pipeline->footprint().radius, 2);
+    EXPECT_TRUE(pipeline->footprint().heights);
+
+    const std::optional<GeneratorPipeline> reloaded = GeneratorPipeline::fromJson(pipeline->toJson());
+    ASSERT_TRUE(reloaded.has_value());
+    EXPECT_EQ(reloaded->toJson(), pipeline->toJson());
+    expectSameVoxels(reloaded->generate(1, 0, 1).voxelField, pipeline->generate(1, 0, 1).voxelField);
+
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"([{"stage": "volcanoes"}])")).has_value());
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"([{"stage": "density", "lattice": [3, 8]}])"))
+                     .has_value());
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"({"stage": "flat"})")).has_value());
+}
+
+TEST(GeneratorTest, StagesSampleTheirOwnNoise) {
+    const std::optional<GeneratorPipeline> pipeline = GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "heightmap", "noise": "simplex"}
+    ])"));
+    ASSERT_TRUE(pipeline.has_value());
+    EXPECT_EQ(pipeline->toJson()[0]["noise"], "simplex");
+
+    // Regions cached from the Perlin terrain aren't read back for it
+    const GeneratorPipeline perlinPipeline = GeneratorPipeline::fromType(GenerationType::Perlin2D);
+    EXPECT_NE(RegionCache::fingerprint(*pipeline), RegionCache::fingerprint(perlinPipeline));
+
+    // Defaults are left out, so levels from before there was a choice keep their region caches
+    EXPECT_EQ(perlinPipeline.toJson(), json::parse(R"([{"stage": "heightmap"}])"));
+    const std::optional<GeneratorPipeline> defaults = GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "heightmap", "noise": "perlin", "biomes": false}
+    ])"));
+    ASSERT_TRUE(defaults.has_value());
+    EXPECT_EQ(RegionCache::fingerprint(*defaults), RegionCache::fingerprint(perlinPipeline));
+
+    // Heightmap terrain from the other noise's heights
+    size_t differences = 0;
+    for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+        const Chunk::GenerationResult perlin = Chunk::generateVoxels2D(4, cy, -4);
+        const Chunk::GenerationResult simplex = Chunk::generateVoxels2D(4, cy, -4, NoiseBackend::Simplex);
+        expectSameVoxels(pipeline->generate(4, cy, -4).voxelField, simplex.voxelField);
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                differences += perlin.voxelField.height(x, z) != simplex.voxelField.height(x, z);
+            }
+        }
+    }
+    EXPECT_GT(differences, 0);
+
+    const Chunk::GenerationResult density = Chunk::generateVoxels3D(0, 0, 0, {}, NoiseBackend::Simplex);
+    EXPECT_LT(density.minY, density.maxY);
+
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"([{"stage": "heightmap", "noise": "value"}])"))
+                     .has_value());
+}
+
+TEST(GeneratorTest, BiomesShapeTheTerrainAndPickItsVoxels) {
+    const std::optional<GeneratorPipeline> pipeline = GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "heightmap", "biomes": true}
+    ])"));
+    ASSERT_TRUE(pipeline.has_value());
+    EXPECT_EQ(pipeline->toJson()[0]["biomes"], true);
+    EXPECT_NE(RegionCache::fingerprint(*pipeline),
+              RegionCache::fingerprint(GeneratorPipeline::fromType(GenerationType::Perlin2D)));
+
+    // Chunks far enough apart to lie in different biomes
+    std::set<Voxel> surfaces;
+    size_t differences = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int cx = i * 37;
+        const int cz = -i * 23;
+        for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+            const Chunk::GenerationResult plain = Chunk::generateVoxels2D(cx, cy, cz);
+            const Chunk::GenerationResult biomes = Chunk::generateVoxels2D(cx, cy, cz, NoiseBackend::Perlin, true);
+            expectSameVoxels(pipeline->generate(cx, cy, cz).voxelField, biomes.voxelField);
+            for (int z = 0; z < ChunkSize; ++z) {
+                for (int x = 0; x < ChunkSize; ++x) {
+                    const int height = biomes.voxelField.height(x, z);
+                    differences += height != plain.voxelField.height(x, z);
+                    if (height > 0) {
+                        surfaces.insert(biomes.voxelField.load(x, height - 1, z));
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_GT(differences, 0);
+    EXPECT_GE(surfaces.size(), 3);
+
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"([{"stage": "heightmap", "biomes": "yes"}])"))
+                     .has_value());
+}
+
+TEST(GeneratorTest, CavesOnlyCarveSolidVoxels) {
+    const std::optional<GeneratorPipeline> pipeline = GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "heightmap"},
+        {"stage": "caves", "threshold": 0.6}
+    ])"));
+    ASSERT_TRUE(pipeline.has_value());
+
+    size_t carved = 0;
+    for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+        const Chunk::GenerationResult terrain = Chunk::generateVoxels2D(0, cy, 0);
+        const Chunk::GenerationResult caves = pipeline->generate(0, cy, 0);
+        EXPECT_LE(caves.minY, terrain.minY);
+        for (int y = 0; y < ChunkHeight; ++y) {
+            for (int z = 0; z < ChunkSize; ++z) {
+                for (int x = 0; x < ChunkSize; ++x) {
+                    const Voxel v = caves.voxelField.load(x, y, z);
+                    ASSERT_TRUE(v == terrain.voxelField.load(x, y, z) || v == EmptyVoxel);
+                    carved += v != terrain.voxelField.load(x, y, z);
+                }
+            }
+        }
+    }
+    EXPECT_GT(carved, 0);
+}
+
+// Each chunk places the leaves of trees standing in its neighbours, so canopies continue across chunk borders
+TEST(GeneratorTest, TreesOverhangChunkBorders) {
+    const std::optional<GeneratorPipeline> pipeline = GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "heightmap"},
+        {"stage": "trees", "chance": 0.02, "height": 5, "trunk": 4, "leaves": 5}
+    ])"));
+    ASSERT_TRUE(pipeline.has_value());
+
+    size_t bordering = 0;
+    for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+        for (int cz = 0; cz < 2; ++cz) {
+            for (int cx = 0; cx < 2; ++cx) {
+                const Chunk::GenerationResult result = pipeline->generate(cx, cy, cz);
+                for (int z = 0; z < ChunkSize; ++z) {
+                    for (int x = 0; x < ChunkSize; ++x) {
+                        for (int y = 0; y + 1 < ChunkHeight; ++y) {
+                            // The top of a trunk, under the narrow top layer of leaves
+                            if (result.voxelField.load(x, y, z) != Trunk ||
+                                result.voxelField.load(x, y + 1, z) != Leaves) {
+                                continue;
+                            }
+
+                            // The wide layers two below reach two columns out in every direction
+                            const int wx = cx * ChunkSize + x;
+                            const int wy = cy * ChunkHeight + y - 1;
+                            const int wz = cz * ChunkSize + z;
+                            for (const auto [dx, dz] : {std::pair{2, 0}, std::pair{-2, 0}, std::pair{0, 2},
+                                                        std::pair{0, -2}}) {
+                                const Voxel v = worldVoxel(*pipeline, wx + dx, wy, wz + dz);
+                                EXPECT_TRUE(v == Leaves || v == Trunk) << wx + dx << ", " << wy << ", " << wz + dz;
+                                bordering += (x + dx) >> ChunkSizeShift != 0 || (z + dz) >> ChunkSizeShift != 0;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_GT(bordering, 0);
+}
+
+TEST(GeneratorTest, TreesFollowTheBiomes) {
+    // Trees take the heightmap's biomes. Desert sand is the usual trunk voxel, so these trunks are another.
+    constexpr Voxel BiomeTrunk = 7;
+    const std::optional<GeneratorPipeline> pipeline = GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "heightmap", "biomes": true},
+        {"stage": "trees", "chance": 0.05, "trunk": 7}
+    ])"));
+    ASSERT_TRUE(pipeline.has_value());
+    EXPECT_EQ(pipeline->toJson()[1]["biomes"], true);
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "heightmap", "biomes": true}, {"stage": "trees", "biomes": false}
+    ])")).has_value());
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "heightmap"}, {"stage": "trees", "noise": "simplex"}
+    ])")).has_value());
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"([{"stage": "trees"}])")).has_value());
+    EXPECT_FALSE(GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "trees"}, {"stage": "heightmap"}
+    ])")).has_value());
+
+    // A chunk in the middle of a desert, with next to no chance of trees, and one in a forest or jungle
+    ClimateMap& climate = ClimateMap::climate(NoiseBackend::Perlin);
+    std::optional<glm::ivec2> desert;
+    std::optional<glm::ivec2> forest;
+    for (int z = -4096; z < 4096 && (!desert || !forest); z += 256) {
+        for (int x = -4096; x < 4096; x += 256) {
+            const ClimateMap::Sample sample = climate.at(x, z);
+            const std::string name = Biome::nearest(sample.climate).name;
+            if (name == "desert" && sample.shape.trees < 1e-4f) {
+                desert = glm::ivec2(x >> ChunkSizeShift, z >> ChunkSizeShift);
+            } else if ((name == "forest" || name == "jungle") && sample.shape.trees > 2.0f) {
+                forest = glm::ivec2(x >> ChunkSizeShift, z >> ChunkSizeShift);
+            }
+        }
+    }
+    ASSERT_TRUE(desert && forest);
+
+    HeightmapCache& heights = Chunk::heightmapCache(NoiseBackend::Perlin, true);
+    const auto countTrees = [&](const glm::ivec2 chunk) {
+        size_t trees = 0;
+        for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+            const Chunk::GenerationResult result = pipeline->generate(chunk.x, cy, chunk.y);
+            for (int z = 0; z < ChunkSize; ++z) {
+                for (int x = 0; x < ChunkSize; ++x) {
+                    const int wx = chunk.x * ChunkSize + x;
+                    const int wz = chunk.y * ChunkSize + z;
+                    const int ground = (*heights.tileAt(wx, wz))[HeightmapCache::getColumnIndex(wx, wz)];
+                    for (int y = 0; y < ChunkHeight; ++y) {
+                        if (result.voxelField.load(x, y, z) != BiomeTrunk) {
+                            continue;
+                        }
+                        const int wy = cy * ChunkHeight + y;
+                        const Voxel below = y > 0 ? result.voxelField.load(x, y - 1, z)
+                                                  : worldVoxel(*pipeline, wx, wy - 1, wz);
+                        if (below != BiomeTrunk) {
+                            // Standing on the ground of the biome's terrain
+                            EXPECT_EQ(wy, ground) << wx << ", " << wz;
+                            EXPECT_NE(below, EmptyVoxel) << wx << ", " << wz;
+                            ++trees;
+                        }
+                    }
+                }
+            }
+        }
+        return trees;
+    };
+    EXPECT_EQ(countTrees(*desert), 0);
+    EXPECT_GT(countTrees(*forest), 0);
+}
+
+TEST(GeneratorTest, RegisteredStagesCanBeDeclared) {
+    class FillStage final : public GeneratorStage {
+    public:
+        void apply(int, int, int, Chunk::GenerationResult& result) const override {
+            result.voxelField.fillSection(0, 7);
+            result.maxY = SectionHeight;
+        }
+
+        [[nodiscard]] json toJson() const override { return {{"stage", "test-fill"}}; }
+    };
+    GeneratorPipeline::registerStage("test-fill", [](const json&) { return std::make_unique<FillStage>(); });
+
+    const std::optional<GeneratorPipeline> pipeline = GeneratorPipeline::fromJson(json::parse(R"([
+        {"stage": "test-fill"}
+    ])"));
+    ASSERT_TRUE(pipeline.has_value());
+    EXPECT_EQ(pipeline->generate(0, 0, 0).voxelField.load(3, 2, 1), 7);
+    EXPECT_EQ(pipeline->toJson(), json::parse(R"([{"stage": "test-fill"}])"));
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Voxels/world/Chunk.hpp"
+#include "Voxels/world/HeightmapCache.hpp"
+
+namespace {
+
+// Each column's height encodes its position, and every call is counted
+struct CountingGenerator {
+    std::atomic<int>* calls;
+
+    void operator()(const int x0, const int z0, HeightmapCache::Tile& heights) const {
+        ++*calls;
+        for (int z = 0; z < HeightmapCache::TileSize; ++z) {
+            for (int x = 0; x < HeightmapCache::TileSize; ++x) {
+                heights[HeightmapCache::getColumnIndex(x, z)] = static_cast<uint16_t>((x0 + x) * 3 + (z0 + z) * 5 + 1000);
+            }
+        }
+    }
+};
+
+}
+
+TEST(HeightmapCacheTest, ConcurrentLookupsComputeEachTileOnce) {
+    std::atomic<int> calls = 0;
+    HeightmapCache cache(CountingGenerator{&calls});
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&cache] {
+            for (int tz = -2; tz < 2; ++tz) {
+                for (int tx = -2; tx < 2; ++tx) {
+                    const int x = tx * HeightmapCache::TileSize + 7;
+                    const int z = tz * HeightmapCache::TileSize + 11;
+                    const auto tile = cache.tileAt(x, z);
+                    EXPECT_EQ((*tile)[HeightmapCache::getColumnIndex(x, z)], x * 3 + z * 5 + 1000);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const HeightmapCacheStats stats = cache.getStats();
+    EXPECT_EQ(calls, 16);
+    EXPECT_EQ(stats.misses, 16);
+    EXPECT_EQ(stats.hits, 7 * 16);
+    EXPECT_EQ(stats.tiles, 16);
+}
+
+TEST(HeightmapCacheTest, EvictsTheLeastRecentlyUsedTiles) {
+    std::atomic<int> calls = 0;
+    HeightmapCache cache(CountingGenerator{&calls}, 2);
+
+    const auto kept = cache.tileAt(0, 0);
+    const auto evicted = cache.tileAt(HeightmapCache::TileSize, 0);
+    EXPECT_EQ(cache.tileAt(0, 0), kept);
+
+    // Evicts the tile at x = TileSize, not the one just used
+    const auto third = cache.tileAt(2 * HeightmapCache::TileSize, 0);
+    EXPECT_NE(third, kept);
+
+    EXPECT_EQ(cache.tileAt(0, 0), kept);
+    EXPECT_EQ(calls, 3);
+    EXPECT_NE(cache.tileAt(HeightmapCache::TileSize, 0), evicted);
+    EXPECT_EQ(calls, 4);
+    EXPECT_EQ(cache.getStats().tiles, 2);
+    EXPECT_EQ(cache.getStats().evictions, 2);
+
+    // Evicted tiles stay valid for as long as they're held
+    cache.clear();
+    EXPECT_EQ((*kept)[HeightmapCache::getColumnIndex(1, 2)], 1 * 3 + 2 * 5 + 1000);
+}
+
+// Chunks stacked in the same column share a tile, as do chunks side by side within it
+TEST(HeightmapCacheTest, GenerationSharesTilesBetweenChunks) {
+    const HeightmapCacheStats before = Chunk::heightmapCache().getStats();
+    constexpr int ChunksPerTile = HeightmapCache::TileSize / ChunkSize;
+    for (int cz = 0; cz < ChunksPerTile; ++cz) {
+        for (int cx = 0; cx < ChunksPerTile; ++cx) {
+            for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+                (void)Chunk::generateVoxels2D(cx + 1000, cy, cz + 1000);
+            }
+        }
+    }
+    const HeightmapCacheStats after = Chunk::heightmapCache().getStats();
+
+    EXPECT_EQ(after.misses - before.misses, 1);
+    EXPECT_EQ(after.hits - before.hits, ChunksPerTile * ChunksPerTile * TerrainChunkRows - 1);
+}
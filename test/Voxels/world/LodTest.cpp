@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+#include "Voxels/world/Generator.hpp"
+
+namespace {
+
+using json = nlohmann::json;
+
+}
+
+TEST(LodTest, HeightmapLodColumnsCoverTheirSamples) {
+    for (int lod = 1; lod <= MaxLod; ++lod) {
+        const int scale = 1 << lod;
+        for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+            const Chunk::GenerationResult full = Chunk::generate(GenerationType::Perlin2D, -3, cy, 5);
+            const Chunk::GenerationResult coarse = Chunk::generateLod(GenerationType::Perlin2D, -3, cy, 5, lod);
+            EXPECT_EQ(coarse.lod, lod);
+            for (int z = 0; z < ChunkSize >> lod; ++z) {
+                for (int x = 0; x < ChunkSize >> lod; ++x) {
+                    // Every voxel whose sample is solid at full resolution is solid, and nothing above
+                    const int height = full.voxelField.height(x * scale, z * scale);
+                    ASSERT_EQ(coarse.voxelField.height(x, z), (height + scale - 1) >> lod)
+                        << lod << ": " << x << ", " << z;
+                    if (height > 0) {
+                        const Voxel top = full.voxelField.load(x * scale, height - 1, z * scale);
+                        EXPECT_EQ(coarse.voxelField.load(x, ((height + scale - 1) >> lod) - 1, z), top);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(LodTest, BiomeLodColumnsCoverTheirSamples) {
+    for (int lod = 1; lod <= MaxLod; ++lod) {
+        const int scale = 1 << lod;
+        for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+            const Chunk::GenerationResult full = Chunk::generateVoxels2D(-3, cy, 5, NoiseBackend::Perlin, true);
+            const Chunk::GenerationResult coarse =
+                Chunk::generateLod(GenerationType::Perlin2D, -3, cy, 5, lod, NoiseBackend::Perlin, true);
+            EXPECT_EQ(coarse.lod, lod);
+            for (int z = 0; z < ChunkSize >> lod; ++z) {
+                for (int x = 0; x < ChunkSize >> lod; ++x) {
+                    // The biomes pick the top voxel of each column, which the coarse column keeps
+                    const int height = full.voxelField.height(x * scale, z * scale);
+                    ASSERT_EQ(coarse.voxelField.height(x, z), (height + scale - 1) >> lod)
+                        << lod << ": " << x << ", " << z;
+                    if (height > 0) {
+                        const Voxel top = full.voxelField.load(x * scale, height - 1, z * scale);
+                        EXPECT_EQ(coarse.voxelField.load(x, ((height + scale - 1) >> lod) - 1, z), top);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(LodTest, DensityLodSamplesTheNoise) {
+    for (int lod = 1; lod <= MaxLod; ++lod) {
+        const int scale = 1 << lod;
+        for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+            const Chunk::GenerationResult full = Chunk::generate(GenerationType::Perlin3D, 2, cy, -1,
+                                                                 NoiseLattice::exact());
+            const Chunk::GenerationResult coarse = Chunk::generateLod(GenerationType::Perlin3D, 2, cy, -1, lod);
+            for (int y = 0; y < ChunkHeight >> lod; ++y) {
+                for (int z = 0; z < ChunkSize >> lod; ++z) {
+                    for (int x = 0; x < ChunkSize >> lod; ++x) {
+                        const Voxel sample = full.voxelField.load(x * scale, y * scale, z * scale);
+                        ASSERT_EQ(coarse.voxelField.load(x, y, z), sample)
+                            << lod << ": " << x << ", " << y << ", " << z;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(LodTest, VoxelsStayInTheLowCorner) {
+    constexpr int Lod = 1;
+    for (const GenerationType type : {GenerationType::Flat, GenerationType::Perlin2D, GenerationType::Perlin3D}) {
+        const Chunk::GenerationResult coarse = Chunk::generateLod(type, 0, 0, 0, Lod);
+        EXPECT_LE(coarse.maxY, ChunkHeight >> Lod);
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                if (x >= ChunkSize >> Lod || z >= ChunkSize >> Lod) {
+                    ASSERT_EQ(coarse.voxelField.height(x, z), 0) << x << ", " << z;
+                } else {
+                    ASSERT_LE(coarse.voxelField.height(x, z), ChunkHeight >> Lod) << x << ", " << z;
+                }
+            }
+        }
+    }
+
+    // Nothing is generated above the terrain at any level
+    EXPECT_EQ(Chunk::generateLod(GenerationType::Perlin3D, 0, TerrainChunkRows, 0, Lod).voxelField.uniformValue(),
+              EmptyVoxel);
+}
+
+TEST(LodTest, PipelinesSkipDetailStagesAtCoarserLevels) {
+    const std::optional<GeneratorPipeline> pipeline = GeneratorPipeline::fromJson(json::array({
+        {{"stage", "heightmap"}},
+        {{"stage", "caves"}},
+        {{"stage", "trees"}, {"chance", 0.5}},
+    }));
+    ASSERT_TRUE(pipeline.has_value());
+
+    const Chunk::GenerationResult expected = Chunk::generateLod(GenerationType::Perlin2D, 1, 0, 1, 2);
+    const Chunk::GenerationResult result = pipeline->generate(1, 0, 1, 2);
+    EXPECT_EQ(result.lod, 2);
+    EXPECT_EQ(result.minY, expected.minY);
+    EXPECT_EQ(result.maxY, expected.maxY);
+    for (int z = 0; z < ChunkSize; ++z) {
+        for (int x = 0; x < ChunkSize; ++x) {
+            ASSERT_EQ(result.voxelField.height(x, z), expected.voxelField.height(x, z)) << x << ", " << z;
+        }
+    }
+    EXPECT_EQ(pipeline->generate(1, 0, 1).lod, 0);
+}
@@ -0,0 +1,34 @@
+#include "gtest/gtest.h"
+
+#include "Voxels/world/MotionPrediction.hpp"
+
+TEST(MotionPredictionTest, PathFollowsTheVelocity) {
+    const MotionPrediction motion = MotionPrediction::fromVelocity({10, 0, 0}, {1, 0, 0}, 2.0f, 1000.0f);
+    EXPECT_EQ(motion.offset, glm::vec3(20, 0, 0));
+
+    const glm::vec3 position(100, 50, 100);
+    EXPECT_EQ(motion.nearestPoint(position, {110, 90, 130}), glm::vec3(110, 50, 100));
+    EXPECT_EQ(motion.nearestPoint(position, {500, 50, 100}), glm::vec3(120, 50, 100));  // Past the end of the path
+    EXPECT_EQ(motion.nearestPoint(position, {0, 50, 100}), position);                    // Behind its start
+}
+
+TEST(MotionPredictionTest, StandingStillPredictsNoPath) {
+    const MotionPrediction motion = MotionPrediction::fromVelocity({}, {}, 2.0f, 1000.0f);
+    EXPECT_EQ(motion.nearestPoint({1, 2, 3}, {40, 50, 60}), glm::vec3(1, 2, 3));
+
+    // Nothing is behind a player without a look direction
+    EXPECT_FALSE(motion.isBehind({0, 0, 0}, {-100, 0, 0}, 0.0f));
+}
+
+TEST(MotionPredictionTest, FastPathsAreCutOff) {
+    const MotionPrediction motion = MotionPrediction::fromVelocity({0, 0, -1000}, {0, 0, -1}, 2.0f, 256.0f);
+    EXPECT_FLOAT_EQ(glm::length(motion.offset), 256.0f);
+    EXPECT_LT(motion.offset.z, 0.0f);
+}
+
+TEST(MotionPredictionTest, PointsBehindTheLookDirection) {
+    const MotionPrediction motion = MotionPrediction::fromVelocity({}, {0, 0, -2}, 2.0f, 1000.0f);
+    EXPECT_FALSE(motion.isBehind({0, 0, 0}, {0, 0, -50}, 16.0f));
+    EXPECT_FALSE(motion.isBehind({0, 0, 0}, {50, 0, 10}, 16.0f));  // Beside, within the margin
+    EXPECT_TRUE(motion.isBehind({0, 0, 0}, {0, 0, 50}, 16.0f));
+}
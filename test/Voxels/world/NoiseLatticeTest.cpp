@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Voxels/world/Chunk.hpp"
+
+TEST(NoiseLatticeTest, ValidatesSteps) {
+    EXPECT_TRUE(NoiseLattice{}.isValid());
+    EXPECT_TRUE(NoiseLattice::exact().isValid());
+    EXPECT_TRUE((NoiseLattice{ChunkSize, SectionHeight}.isValid()));
+    EXPECT_FALSE((NoiseLattice{3, 8}.isValid()));
+    EXPECT_FALSE((NoiseLattice{4, 0}.isValid()));
+    EXPECT_FALSE((NoiseLattice{ChunkSize * 2, 8}.isValid()));
+    EXPECT_FALSE((NoiseLattice{4, SectionHeight * 2}.isValid()));
+}
+
+// The lattice is aligned to world coordinates, so at lattice points every chunk sees the exact noise
+TEST(NoiseLatticeTest, LatticePointsMatchTheExactPath) {
+    constexpr NoiseLattice Lattice{4, 8};
+    for (const auto [cx, cz] : {std::pair{0, 0}, std::pair{3, -2}, std::pair{-5, 7}}) {
+        // The whole height of the terrain, whatever the chunk height, so the surface makes up the same share of it
+        size_t differing = 0;
+        size_t total = 0;
+        for (int cy = 0; cy < TerrainChunkRows; ++cy) {
+            const Chunk::GenerationResult exact = Chunk::generateVoxels3D(cx, cy, cz, NoiseLattice::exact());
+            const Chunk::GenerationResult coarse = Chunk::generateVoxels3D(cx, cy, cz, Lattice);
+            for (int y = 0; y < std::min(ChunkHeight, TerrainHeight - cy * ChunkHeight); ++y) {
+                for (int z = 0; z < ChunkSize; ++z) {
+                    for (int x = 0; x < ChunkSize; ++x) {
+                        const bool solid = coarse.voxelField.isSolid(x, y, z);
+                        if (x % Lattice.horizontal == 0 && y % Lattice.vertical == 0 && z % Lattice.horizontal == 0) {
+                            ASSERT_EQ(solid, exact.voxelField.isSolid(x, y, z)) << x << ", " << y << ", " << z;
+                        }
+                        differing += solid != exact.voxelField.isSolid(x, y, z);
+                        ++total;
+                    }
+                }
+            }
+        }
+
+        // In between, the interpolated field only strays from the exact one near the surface
+        EXPECT_LT(static_cast<double>(differing) / static_cast<double>(total), 0.1);
+    }
+}
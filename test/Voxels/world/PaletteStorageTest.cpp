@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+#include "Voxels/world/PaletteStorage.hpp"
+
+TEST(PaletteStorageTest, UniformStorageAllocatesNoWords) {
+    const PaletteStorage storage(4096, 3);
+
+    EXPECT_EQ(storage.bitsPerIndex(), 0);
+    EXPECT_EQ(storage.paletteSize(), 1);
+    EXPECT_EQ(storage.load(0), 3);
+    EXPECT_EQ(storage.load(4095), 3);
+}
+
+TEST(PaletteStorageTest, StoreAndLoad) {
+    PaletteStorage storage(1000, 0);
+
+    storage.store(0, 1);
+    storage.store(999, 2);
+    storage.store(500, 1);
+
+    EXPECT_EQ(storage.load(0), 1);
+    EXPECT_EQ(storage.load(1), 0);
+    EXPECT_EQ(storage.load(500), 1);
+    EXPECT_EQ(storage.load(999), 2);
+    EXPECT_EQ(storage.bitsPerIndex(), 2);
+}
+
+TEST(PaletteStorageTest, WidensWhenNewTypesAppear) {
+    constexpr size_t Size = 18 * 18 * 128;
+    PaletteStorage storage(Size, 0);
+
+    // Write as many distinct types as Voxel can hold (up to 300), so that every width up to 8 or 16 bits is passed
+    // through
+    constexpr size_t TypeCount = std::min<size_t>(300, size_t{std::numeric_limits<Voxel>::max()} + 1);
+    for (size_t i = 0; i < Size; ++i) {
+        storage.store(i, static_cast<Voxel>(i % TypeCount));
+    }
+
+    EXPECT_EQ(storage.bitsPerIndex(), TypeCount > 256 ? 16 : 8);
+    EXPECT_EQ(storage.paletteSize(), TypeCount);
+    for (size_t i = 0; i < Size; ++i) {
+        ASSERT_EQ(storage.load(i), static_cast<Voxel>(i % TypeCount));
+    }
+}
+
+TEST(PaletteStorageTest, FillReturnsWordsToPool) {
+    PaletteStorage storage(1000, 0);
+    storage.store(3, 1);
+
+    const BufferPoolStats before = PaletteStorage::wordPool().getStats();
+    storage.fill(0);
+    const BufferPoolStats after = PaletteStorage::wordPool().getStats();
+    EXPECT_EQ(after.released, before.released + 1);
+    EXPECT_EQ(after.pooledBuffers, before.pooledBuffers + 1);
+
+    // The next storage to go dense picks the buffer up again
+    PaletteStorage other(1000, 0);
+    other.store(5, 1);
+    EXPECT_EQ(PaletteStorage::wordPool().getStats().reused, after.reused + 1);
+    EXPECT_EQ(other.load(5), 1);
+    EXPECT_EQ(other.load(3), 0);
+}
+
+TEST(PaletteStorageTest, RangeFillMatchesStores) {
+    PaletteStorage filled(1000, 0);
+    PaletteStorage stored(1000, 0);
+    for (size_t i = 0; i < 1000; i += 7) {
+        filled.store(i, static_cast<Voxel>(i % 3));
+        stored.store(i, static_cast<Voxel>(i % 3));
+    }
+
+    // Ranges starting and ending mid-word as well as covering whole words, at several widths
+    for (const auto [begin, end, v] : {std::tuple{5, 6, 1}, std::tuple{30, 300, 4}, std::tuple{64, 128, 2},
+                                       std::tuple{0, 999, 5}, std::tuple{700, 1000, 0}}) {
+        filled.fill(begin, end, static_cast<Voxel>(v));
+        for (int i = begin; i < end; ++i) {
+            stored.store(i, static_cast<Voxel>(v));
+        }
+        for (size_t i = 0; i < 1000; ++i) {
+            ASSERT_EQ(filled.load(i), stored.load(i)) << i;
+        }
+    }
+
+    filled.fill(0, 1000, 3);
+    EXPECT_TRUE(filled.isUniform());
+    EXPECT_EQ(filled.load(500), 3);
+}
@@ -0,0 +1,176 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include "Voxels/world/RegionCache.hpp"
+
+namespace {
+
+// A fresh directory per test, so regions written by earlier runs are never read back
+std::filesystem::path regionDirectory(const char* name) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "RegionCacheTest" / name;
+    std::filesystem::remove_all(directory);
+    return directory;
+}
+
+void expectSameChunk(const Chunk::GenerationResult& a, const Chunk::GenerationResult& b) {
+    EXPECT_EQ(a.minY, b.minY);
+    EXPECT_EQ(a.maxY, b.maxY);
+    for (int y = 0; y < ChunkHeight; ++y) {
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                ASSERT_EQ(a.voxelField.load(x, y, z), b.voxelField.load(x, y, z)) << x << ", " << y << ", " << z;
+            }
+        }
+    }
+}
+
+}
+
+TEST(RegionCacheTest, ChunksAreReadBackInLaterSessions) {
+    const std::filesystem::path directory = regionDirectory("Sessions");
+    const GeneratorPipeline generator = GeneratorPipeline::fromType(GenerationType::Perlin2D);
+    const uint64_t fingerprint = RegionCache::fingerprint(generator);
+
+    {
+        RegionCache cache(directory);
+        EXPECT_FALSE(cache.load({0, 0, 0}, fingerprint).has_value());
+        for (const glm::ivec3 coords : {glm::ivec3(0, 0, 0), glm::ivec3(-1, 0, 5), glm::ivec3(40, 0, -33)}) {
+            EXPECT_TRUE(cache.store(coords, generator.generate(coords.x, coords.y, coords.z), fingerprint));
+        }
+        EXPECT_EQ(cache.getStats().stores, 3);
+    }
+
+    RegionCache cache(directory);
+    for (const glm::ivec3 coords : {glm::ivec3(0, 0, 0), glm::ivec3(-1, 0, 5), glm::ivec3(40, 0, -33)}) {
+        const std::optional<Chunk::GenerationResult> cached = cache.load(coords, fingerprint);
+        ASSERT_TRUE(cached.has_value());
+        expectSameChunk(*cached, generator.generate(coords.x, coords.y, coords.z));
+    }
+    EXPECT_FALSE(cache.load({1, 0, 0}, fingerprint).has_value());
+    EXPECT_EQ(cache.getStats().hits, 3);
+    EXPECT_EQ(cache.getStats().misses, 1);
+}
+
+TEST(RegionCacheTest, OtherGeneratorsInvalidateRegions) {
+    const std::filesystem::path directory = regionDirectory("Generators");
+    const GeneratorPipeline flat = GeneratorPipeline::fromType(GenerationType::Flat);
+    const GeneratorPipeline hills = GeneratorPipeline::fromType(GenerationType::Perlin2D);
+    const uint64_t flatFingerprint = RegionCache::fingerprint(flat);
+    const uint64_t hillsFingerprint = RegionCache::fingerprint(hills);
+    EXPECT_NE(flatFingerprint, hillsFingerprint);
+    EXPECT_EQ(flatFingerprint, RegionCache::fingerprint(GeneratorPipeline::fromType(GenerationType::Flat)));
+
+    RegionCache cache(directory);
+    ASSERT_TRUE(cache.store({0, 0, 0}, flat.generate(0, 0, 0), flatFingerprint));
+    EXPECT_FALSE(cache.load({0, 0, 0}, hillsFingerprint).has_value());
+
+    // Writing the region for the new generator discards the old generator's chunks
+    ASSERT_TRUE(cache.store({1, 0, 0}, hills.generate(1, 0, 0), hillsFingerprint));
+    EXPECT_EQ(cache.getStats().resets, 1);
+    EXPECT_FALSE(cache.load({0, 0, 0}, flatFingerprint).has_value());
+    EXPECT_FALSE(cache.load({0, 0, 0}, hillsFingerprint).has_value());
+    EXPECT_TRUE(cache.load({1, 0, 0}, hillsFingerprint).has_value());
+
+    // Sky above the terrain is empty, so isn't worth writing
+    EXPECT_FALSE(cache.store({0, TerrainChunkRows, 0}, hills.generate(0, TerrainChunkRows, 0), hillsFingerprint));
+}
+
+TEST(RegionCacheTest, RegionsAreReopenedAfterClosing) {
+    const std::filesystem::path directory = regionDirectory("Reopened");
+    const GeneratorPipeline generator = GeneratorPipeline::fromType(GenerationType::Flat);
+    const uint64_t fingerprint = RegionCache::fingerprint(generator);
+
+    // More regions than stay open at once, so the first ones are closed before they're read again
+    RegionCache cache(directory);
+    constexpr int Regions = 40;
+    for (int i = 0; i < Regions; ++i) {
+        ASSERT_TRUE(cache.store({i * RegionCache::RegionSize, 0, 0}, generator.generate(0, 0, 0), fingerprint));
+    }
+    for (int i = 0; i < Regions; ++i) {
+        const std::optional<Chunk::GenerationResult> cached = cache.load({i * RegionCache::RegionSize, 0, 0},
+                                                                         fingerprint);
+        ASSERT_TRUE(cached.has_value()) << i;
+        expectSameChunk(*cached, generator.generate(0, 0, 0));
+    }
+}
+
+TEST(RegionCacheTest, ChunksThatDontDecodeAreMisses) {
+    const std::filesystem::path directory = regionDirectory("Corrupt");
+    const GeneratorPipeline generator = GeneratorPipeline::fromType(GenerationType::Perlin2D);
+    const uint64_t fingerprint = RegionCache::fingerprint(generator);
+    {
+        RegionCache cache(directory);
+        ASSERT_TRUE(cache.store({0, 0, 0}, generator.generate(0, 0, 0), fingerprint));
+    }
+
+    // The chunk is last in its region, so this overwrites its end
+    for (const auto& file : std::filesystem::directory_iterator(directory)) {
+        std::fstream stream(file.path(), std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(-4, std::ios::end);
+        stream.write("\xff\xff\xff\xff", 4);
+    }
+
+    RegionCache cache(directory);
+    EXPECT_FALSE(cache.load({0, 0, 0}, fingerprint).has_value());
+    EXPECT_EQ(cache.getStats().misses, 1);
+    EXPECT_EQ(cache.getStats().hits, 0);
+}
+
+TEST(RegionCacheTest, ChunksWithHeightsOutsideTheChunkAreMisses) {
+    const std::filesystem::path directory = regionDirectory("Heights");
+    const GeneratorPipeline generator = GeneratorPipeline::fromType(GenerationType::Perlin2D);
+    const uint64_t fingerprint = RegionCache::fingerprint(generator);
+    {
+        RegionCache cache(directory);
+        ASSERT_TRUE(cache.store({0, 0, 0}, generator.generate(0, 0, 0), fingerprint));
+    }
+
+    // The chunk is first in the table, after the 16 byte header, with minY 12 bytes into its entry
+    for (const auto& file : std::filesystem::directory_iterator(directory)) {
+        std::fstream stream(file.path(), std::ios::in | std::ios::out | std::ios::binary);
+        const auto minY = static_cast<int16_t>(ChunkHeight + 1);
+        stream.seekp(16 + 12);
+        stream.write(reinterpret_cast<const char*>(&minY), sizeof(minY));
+    }
+
+    RegionCache cache(directory);
+    EXPECT_FALSE(cache.load({0, 0, 0}, fingerprint).has_value());
+    EXPECT_EQ(cache.getStats().misses, 1);
+}
+
+// Chunks written again leave their old encodings behind, which are compacted away rather than growing the file forever
+TEST(RegionCacheTest, RewrittenChunksDontGrowTheFile) {
+    const std::filesystem::path directory = regionDirectory("Rewritten");
+    const GeneratorPipeline generator = GeneratorPipeline::fromType(GenerationType::Perlin2D);
+    const uint64_t fingerprint = RegionCache::fingerprint(generator);
+    const Chunk::GenerationResult kept = generator.generate(0, 0, 0);
+    const Chunk::GenerationResult rewritten = generator.generate(1, 0, 0);
+
+    constexpr int Writes = 4000;
+    size_t encoded = 0;
+    {
+        RegionCache cache(directory);
+        ASSERT_TRUE(cache.store({0, 0, 0}, kept, fingerprint));
+        for (int i = 0; i < Writes; ++i) {
+            ASSERT_TRUE(cache.store({1, 0, 0}, rewritten, fingerprint));
+        }
+        encoded = cache.getStats().bytes / cache.getStats().stores;
+    }
+
+    size_t fileSize = 0;
+    for (const auto& file : std::filesystem::directory_iterator(directory)) {
+        fileSize += std::filesystem::file_size(file.path());
+    }
+    EXPECT_LT(fileSize, encoded * Writes / 2);
+
+    RegionCache cache(directory);
+    const std::optional<Chunk::GenerationResult> first = cache.load({0, 0, 0}, fingerprint);
+    ASSERT_TRUE(first.has_value());
+    expectSameChunk(*first, kept);
+    const std::optional<Chunk::GenerationResult> second = cache.load({1, 0, 0}, fingerprint);
+    ASSERT_TRUE(second.has_value());
+    expectSameChunk(*second, rewritten);
+}
@@ -0,0 +1,47 @@
+#include "gtest/gtest.h"
+
+#include "Voxels/world/SharedVoxels.hpp"
+
+TEST(SharedVoxelsTest, WritesWithoutSnapshotsDoNotCopy) {
+    SharedVoxels voxels;
+    const VoxelStorage* storage = &*voxels;
+    const uint64_t copies = SharedVoxels::copyCount();
+
+    voxels.write().store(1, 2, 3, 4);
+    voxels.write().store(2, 2, 3, 4);
+
+    EXPECT_EQ(&*voxels, storage);
+    EXPECT_EQ(SharedVoxels::copyCount(), copies);
+}
+
+TEST(SharedVoxelsTest, SnapshotsAreUnaffectedByLaterWrites) {
+    SharedVoxels voxels;
+    voxels.write().store(1, 2, 3, 4);
+    const SharedVoxels::Snapshot snapshot = voxels.snapshot();
+    const uint64_t copies = SharedVoxels::copyCount();
+
+    // Only the first write after the snapshot copies
+    voxels.write().store(1, 2, 3, 5);
+    voxels.write().store(2, 2, 3, 5);
+
+    EXPECT_EQ(SharedVoxels::copyCount(), copies + 1);
+    EXPECT_EQ(snapshot->load(1, 2, 3), 4);
+    EXPECT_EQ(snapshot->load(2, 2, 3), EmptyVoxel);
+    EXPECT_EQ(voxels->load(1, 2, 3), 5);
+    EXPECT_NE(voxels.snapshot(), snapshot);
+}
+
+TEST(SharedVoxelsTest, FilledChunksShareVoxelsUntilWritten) {
+    SharedVoxels rock;
+    SharedVoxels otherRock;
+    rock.fill(2);
+    otherRock.fill(2);
+
+    EXPECT_EQ(&*rock, &*otherRock);
+    EXPECT_EQ(rock->uniformValue(), 2);
+
+    rock.write().store(1, 2, 3, EmptyVoxel);
+    EXPECT_NE(&*rock, &*otherRock);
+    EXPECT_EQ(rock->load(1, 2, 3), EmptyVoxel);
+    EXPECT_EQ(otherRock->load(1, 2, 3), 2);
+}
@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "Voxels/world/VoxelLayout.hpp"
+#include "Voxels/world/VoxelStorage.hpp"
+
+namespace {
+
+// Every voxel maps to a distinct index, and forEach visits them in index order
+template<typename Layout>
+void expectLayoutIsBijective() {
+    std::vector<bool> seen(Layout::Volume);
+    size_t next = 0;
+    Layout::forEach([&](const size_t x, const size_t y, const size_t z) {
+        const size_t index = Layout::index(x, y, z);
+        ASSERT_EQ(index, next++);
+        ASSERT_FALSE(seen[index]);
+        seen[index] = true;
+    });
+    EXPECT_EQ(next, Layout::Volume);
+}
+
+}
+
+TEST(VoxelLayoutTest, LayoutsAreBijective) {
+    expectLayoutIsBijective<LinearLayout<16, 16>>();
+    expectLayoutIsBijective<ColumnLayout<16, 16>>();
+    expectLayoutIsBijective<MortonLayout<16, 16>>();
+    expectLayoutIsBijective<MortonLayout<32, 8>>();
+}
+
+TEST(VoxelLayoutTest, MortonBricksAreContiguous) {
+    using Layout = MortonLayout<16, 16>;
+
+    EXPECT_EQ(Layout::index(0, 0, 0), 0);
+    EXPECT_EQ(Layout::index(3, 3, 3), 63);
+    EXPECT_EQ(Layout::index(4, 0, 0), 64);
+    EXPECT_EQ(Layout::index(0, 0, 4), 4 * 64);
+    EXPECT_EQ(Layout::index(0, 4, 0), 16 * 64);
+}
+
+TEST(VoxelLayoutTest, StorageRoundTripsThroughSectionLayout) {
+    VoxelStorage voxels;
+    SectionLayout::forEach([&](const size_t x, const size_t y, const size_t z) {
+        voxels.store(x, y, z, static_cast<Voxel>((x + y * 3 + z * 7) % 4));
+    });
+
+    SectionLayout::forEach([&](const size_t x, const size_t y, const size_t z) {
+        ASSERT_EQ(voxels.load(x, y, z), (x + y * 3 + z * 7) % 4);
+    });
+}
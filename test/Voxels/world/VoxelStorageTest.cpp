@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+
+#include <tuple>
+
+#include "Voxels/world/VoxelStorage.hpp"
+
+TEST(VoxelStorageTest, SectionsStartEmpty) {
+    const VoxelStorage storage;
+
+    for (int s = 0; s < SectionCount; ++s) {
+        EXPECT_EQ(storage.sectionState(s), VoxelStorage::SectionState::Empty);
+    }
+    EXPECT_EQ(storage.load(5, ChunkHeight - 1, 7), EmptyVoxel);
+}
+
+TEST(VoxelStorageTest, StoreOnlyDensifiesTouchedSection) {
+    if (SectionCount < 3) {
+        GTEST_SKIP() << "Needs chunks at least three sections tall";
+    }
+    VoxelStorage storage;
+    storage.store(1, SectionHeight + 3, 2, 4);
+
+    EXPECT_EQ(storage.sectionState(0), VoxelStorage::SectionState::Empty);
+    EXPECT_EQ(storage.sectionState(1), VoxelStorage::SectionState::Dense);
+    EXPECT_EQ(storage.sectionState(2), VoxelStorage::SectionState::Empty);
+    EXPECT_EQ(storage.load(1, SectionHeight + 3, 2), 4);
+    EXPECT_EQ(storage.load(2, SectionHeight + 3, 2), EmptyVoxel);
+}
+
+TEST(VoxelStorageTest, CompactCollapsesUniformSections) {
+    VoxelStorage storage;
+    for (int y = 0; y < SectionHeight; ++y) {
+        for (int z = 0; z < ChunkSize; ++z) {
+            for (int x = 0; x < ChunkSize; ++x) {
+                storage.store(x, y, z, 2);
+            }
+        }
+    }
+    EXPECT_EQ(storage.sectionState(0), VoxelStorage::SectionState::Dense);
+
+    storage.compact();
+    EXPECT_EQ(storage.sectionState(0), VoxelStorage::SectionState::Uniform);
+    EXPECT_EQ(storage.load(3, 4, 5), 2);
+}
+
+TEST(VoxelStorageTest, LayerSolidOnlyInUniformSections) {
+    if (SectionCount < 3) {
+        GTEST_SKIP() << "Needs chunks at least three sections tall";
+    }
+    VoxelStorage storage;
+    storage.fillSection(0, 2);
+    storage.store(0, SectionHeight, 0, 2);
+
+    EXPECT_TRUE(storage.isLayerSolid(0));
+    EXPECT_TRUE(storage.isLayerSolid(SectionHeight - 1));
+    EXPECT_FALSE(storage.isLayerSolid(SectionHeight));
+    EXPECT_FALSE(storage.isLayerSolid(2 * SectionHeight));
+}
+
+TEST(VoxelStorageTest, OccupancyFollowsEveryWrite) {
+    if (SectionCount < 3) {
+        GTEST_SKIP() << "Needs chunks at least three sections tall";
+    }
+    VoxelStorage storage(VoxelStorage::Representation::Columns);
+    const std::array<ColumnStorage::Span, 3> spans{{
+        {.type = 2, .length = 3},
+        {.type = EmptyVoxel, .length = 2},
+        {.type = 1, .length = 1},
+    }};
+    storage.setColumn(4, 6, spans);
+    EXPECT_EQ(storage.occupancy().column(4, 6), OccupancyMask::Column(0b100111));
+
+    storage.store(4, 3, 6, 1);
+    storage.store(4, 0, 6, EmptyVoxel);
+    EXPECT_EQ(storage.occupancy().column(4, 6), OccupancyMask::Column(0b101110));
+
+    // Converting to sections keeps the mask, and filling a section sets all of its layers
+    storage.fillSection(1, 2);
+    EXPECT_EQ(storage.getRepresentation(), VoxelStorage::Representation::Sections);
+    EXPECT_TRUE(storage.isSolid(4, 5, 6));
+    EXPECT_FALSE(storage.isSolid(4, 4, 6));
+    EXPECT_TRUE(storage.isSolid(0, SectionHeight, 0));
+    EXPECT_FALSE(storage.isSolid(0, 2 * SectionHeight, 0));
+}
+
+TEST(VoxelStorageTest, HeightmapFollowsEveryWrite) {
+    VoxelStorage storage(VoxelStorage::Representation::Columns);
+    const std::array<ColumnStorage::Span, 3> spans{{
+        {.type = 2, .length = 3},
+        {.type = EmptyVoxel, .length = 2},
+        {.type = 1, .length = 1},
+    }};
+    storage.setColumn(4, 6, spans);
+    EXPECT_EQ(storage.height(4, 6), 6);
+    EXPECT_EQ(storage.height(5, 6), 0);
+
+    // Clearing the top voxel drops the height to the next solid voxel down
+    storage.store(4, 5, 6, EmptyVoxel);
+    EXPECT_EQ(storage.height(4, 6), 3);
+    storage.store(4, 9, 6, 1);
+    EXPECT_EQ(storage.height(4, 6), 10);
+    storage.store(4, 1, 6, EmptyVoxel);
+    EXPECT_EQ(storage.height(4, 6), 10);
+
+    storage.fillSection(0, 2);
+    EXPECT_EQ(storage.height(0, 0), SectionHeight);
+    EXPECT_EQ(storage.height(4, 6), SectionHeight);
+    storage.fillSection(0, EmptyVoxel);
+    EXPECT_EQ(storage.height(0, 0), 0);
+    EXPECT_EQ(storage.height(4, 6), 0);
+}
+
+TEST(VoxelStorageTest, FillColumnMatchesStores) {
+    for (const auto representation : {VoxelStorage::Representation::Sections, VoxelStorage::Representation::Columns}) {
+        VoxelStorage filled(representation);
+        VoxelStorage stored(representation);
+
+        // Spans within a section, across section boundaries and clearing part of an earlier span
+        for (const auto [yBegin, yEnd, v] : {std::tuple{0, ChunkHeight / 2, 2}, std::tuple{3, 4, 1},
+                                             std::tuple{SectionHeight - 2, ChunkHeight, 3},
+                                             std::tuple{ChunkHeight - 5, ChunkHeight - 1, 0}}) {
+            filled.fillColumn(3, 5, yBegin, yEnd, static_cast<Voxel>(v));
+            for (int y = yBegin; y < yEnd; ++y) {
+                stored.store(3, y, 5, static_cast<Voxel>(v));
+            }
+
+            for (int y = 0; y < ChunkHeight; ++y) {
+                ASSERT_EQ(filled.load(3, y, 5), stored.load(3, y, 5)) << y;
+                ASSERT_EQ(filled.isSolid(3, y, 5), stored.isSolid(3, y, 5)) << y;
+                ASSERT_EQ(filled.load(4, y, 5), EmptyVoxel);
+            }
+            ASSERT_EQ(filled.height(3, 5), stored.height(3, 5));
+        }
+    }
+}